@@ -0,0 +1,125 @@
+/* Rocket League Batching Classifier
+by Ridas Jagelavicius
+*/
+
+#include <algorithm>
+#include <exception>
+#include <opencv2/imgcodecs.hpp>
+
+#include "BatchingClassifier.h"
+#include "LatencyProfiler.h"
+
+// Custom constructor - starts the thread that classifies requests in batches
+BatchingClassifier::BatchingClassifier(ItemClassifier& classifier,
+                                       size_t max_batch_size,
+                                       std::chrono::milliseconds max_delay)
+    : classifier_(classifier),
+      max_batch_size_(std::max<size_t>(max_batch_size, 1)),
+      max_delay_(max_delay),
+      stopping_(false) {
+    thread_ = std::thread(&BatchingClassifier::Run, this);
+}
+
+// Classifies every pending request, then stops the batching thread
+BatchingClassifier::~BatchingClassifier() {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        stopping_ = true;
+    }
+    changed_.notify_all();
+    thread_.join();
+}
+
+// Classifies an encoded image, blocking until its batch is done
+bool BatchingClassifier::Classify(const unsigned char* encoded_image, size_t size,
+                                  ClassificationResult& result, bool* decoded) {
+    Request request;
+    request.encoded_image = encoded_image;
+    request.size = size;
+    request.arrival = std::chrono::steady_clock::now();
+
+    std::unique_lock<std::mutex> lock(mutex_);
+    pending_.push_back(&request);
+    changed_.notify_all();
+    changed_.wait(lock, [&request] { return request.done; });
+
+    result = request.result;
+    if (decoded != nullptr) *decoded = request.decoded;
+    return request.succeeded;
+}
+
+// Returns what the batching thread has done so far
+BatchingStatistics BatchingClassifier::GetStatistics() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return statistics_;
+}
+
+// The loop run by the batching thread
+void BatchingClassifier::Run() {
+    std::unique_lock<std::mutex> lock(mutex_);
+    while (true) {
+        changed_.wait(lock, [this] { return stopping_ || !pending_.empty(); });
+        if (pending_.empty()) break;  // Only stop once every request has been classified
+
+        // The oldest request decides how long the batch may wait to fill up
+        std::chrono::steady_clock::time_point deadline = pending_.front()->arrival + max_delay_;
+        changed_.wait_until(lock, deadline, [this] {
+            return stopping_ || pending_.size() >= max_batch_size_;
+        });
+
+        size_t count = std::min(pending_.size(), max_batch_size_);
+        std::vector<Request*> batch(pending_.begin(), pending_.begin() + count);
+        pending_.erase(pending_.begin(), pending_.begin() + count);
+
+        // Classification happens without holding the lock, so more requests can queue up
+        lock.unlock();
+        ClassifyRequests(batch);
+        lock.lock();
+
+        statistics_.batches++;
+        statistics_.largest_batch = std::max(statistics_.largest_batch, count);
+        for (Request* request : batch) {
+            statistics_.requests++;
+            if (!request->succeeded) statistics_.failed_requests++;
+            request->done = true;
+        }
+        changed_.notify_all();  // Wake the callers of the finished requests
+    }
+}
+
+// Decodes and classifies a batch without holding the lock
+void BatchingClassifier::ClassifyRequests(std::vector<Request*>& batch) {
+    std::vector<cv::Mat> images;
+    std::vector<Request*> decoded;
+    for (Request* request : batch) {
+        cv::Mat image;
+        if (request->encoded_image != nullptr && request->size != 0) {
+            ScopedStageTimer timer(PipelineStage::ReadImage);
+            image = cv::imdecode(cv::Mat(1, static_cast<int>(request->size), CV_8UC1,
+                                         const_cast<unsigned char*>(request->encoded_image)),
+                                 cv::IMREAD_COLOR);
+        }
+        if (image.empty()) continue;
+        request->decoded = true;
+        images.push_back(image);
+        decoded.push_back(request);
+    }
+    if (images.empty()) return;
+
+    try {
+        std::vector<ClassificationResult> results = classifier_.ClassifyBatch(images);
+        for (size_t i = 0; i < decoded.size(); ++i) {
+            decoded[i]->result = results[i];
+            decoded[i]->succeeded = true;
+        }
+    } catch (const std::exception&) {
+        // ex. the model could not be loaded; every request of the batch fails but the thread keeps running
+        for (Request* request : decoded) {
+            request->result = ClassificationResult();
+            request->succeeded = false;
+        }
+    }
+
+    // The requests' images are not kept once their results are handed over
+    classifier_.ReleaseLastImage();
+}
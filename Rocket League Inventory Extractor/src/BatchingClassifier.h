@@ -0,0 +1,86 @@
+#pragma once
+
+/* Rocket League Batching Classifier
+by Ridas Jagelavicius
+*/
+
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "ItemClassifier.h"
+
+// What a BatchingClassifier has done so far
+struct BatchingStatistics {
+    uint64_t requests = 0; // Images classified, whether or not an item was matched
+    uint64_t failed_requests = 0; // Images that could not be decoded or classified
+    uint64_t batches = 0; // Calls made to ItemClassifier::ClassifyBatch()
+    size_t largest_batch = 0; // The most images classified together
+};
+
+class BatchingClassifier {
+   public:
+    /** Custom constructor - starts the thread that classifies requests in batches
+        Requests made at about the same time (ex. by several connections to a server) are
+        classified together with ItemClassifier::ClassifyBatch(), so their text is detected in one
+        pass through the network. A request never waits longer than max_delay for others to join it
+        @param classifier - The classifier to run batches on, which must outlive this and not be used by anything else
+        @param max_batch_size - The most images classified together; a full batch starts at once
+        @param max_delay - How long the first request of a batch waits for more requests before the batch starts
+    */
+    BatchingClassifier(ItemClassifier& classifier, size_t max_batch_size,
+                       std::chrono::milliseconds max_delay);
+
+    // Classifies every pending request, then stops the batching thread
+    ~BatchingClassifier();
+
+    BatchingClassifier(const BatchingClassifier&) = delete;
+    BatchingClassifier& operator=(const BatchingClassifier&) = delete;
+
+    /** Classifies an encoded image (ex. the bytes of a .png), blocking until its batch is done
+        Safe to call from any number of threads at once. The bytes are read in place, not copied
+        @param encoded_image - The bytes of an encoded image of a single rocket league item
+        @param size - The number of bytes in encoded_image
+        @param result - Set to the extracted traits of the item
+        @param decoded - If not nullptr, set to whether the image could be decoded, so a caller
+                         can tell an invalid image from a classifier failure
+        @return Whether the image could be decoded and classified
+    */
+    bool Classify(const unsigned char* encoded_image, size_t size,
+                  ClassificationResult& result, bool* decoded = nullptr);
+
+    /** Returns what the batching thread has done so far
+        @return The request and batch counts
+    */
+    BatchingStatistics GetStatistics() const;
+
+   private:
+    // An image waiting in pending_, owned by the thread that called Classify()
+    struct Request {
+        const unsigned char* encoded_image; // The caller's encoded bytes
+        size_t size; // The number of bytes in encoded_image
+        std::chrono::steady_clock::time_point arrival; // When Classify() was called
+        ClassificationResult result; // The result, once done is set
+        bool decoded = false; // Whether the image could be decoded
+        bool succeeded = false; // Whether the image could be decoded and classified
+        bool done = false; // Set by the batching thread once result is ready
+    };
+
+    ItemClassifier& classifier_; // Classifies each batch
+    size_t max_batch_size_; // The most images classified together
+    std::chrono::milliseconds max_delay_; // How long the first request of a batch waits for more
+    std::deque<Request*> pending_; // Requests waiting to be batched
+    BatchingStatistics statistics_; // What the batching thread has done so far
+    bool stopping_; // Set when the BatchingClassifier is destroyed
+    mutable std::mutex mutex_; // Guards pending_ through stopping_ and each request's result
+    std::condition_variable changed_; // Signalled whenever a request is added or finished
+    std::thread thread_; // Classifies the requests in pending_
+
+    void Run(); // The loop run by the batching thread
+    void ClassifyRequests(std::vector<Request*>& batch); // Decodes and classifies a batch without holding the lock
+};
@@ -0,0 +1,136 @@
+/* Rocket League Classification Checkpoint Log
+by Ridas Jagelavicius
+*/
+
+#include <filesystem>
+#include <iostream>
+#include <iterator>
+#include <sstream>
+#include <vector>
+
+#include "CheckpointLog.h"
+
+constexpr int LOG_FIELDS = 11;  // path, size, modified time, name, paint, certification, price and 3 confidences, then an empty end field
+
+// Custom constructor - reads every result already in the log, then opens it for appending
+CheckpointLog::CheckpointLog(const std::string& path_to_log)
+    : path_to_log_(path_to_log) {
+    LoadLog();
+    log_.open(path_to_log_, std::ios::app | std::ios::binary);
+    if (!log_)
+        std::cout << "Could not open checkpoint log at " << path_to_log_ << std::endl;
+}
+
+// Returns whether the log could be opened for appending
+bool CheckpointLog::IsOpen() const {
+    return log_.is_open();
+}
+
+// Looks up the logged result of an image
+bool CheckpointLog::Lookup(const std::string& path_to_image, ClassifiedImage& image) const {
+    uintmax_t file_size;
+    long long modified;
+    if (!ReadFileStamp(path_to_image, file_size, modified)) return false;
+
+    std::lock_guard<std::mutex> lock(mutex_);
+    std::unordered_map<std::string, Entry>::const_iterator found = entries_.find(path_to_image);
+    if (found == entries_.end() || found->second.file_size != file_size ||
+        found->second.modified != modified)
+        return false;
+
+    image = found->second.image;
+    return true;
+}
+
+// Appends the result of a classified image and flushes it to disk
+bool CheckpointLog::Append(const ClassifiedImage& image) {
+    if (!image.succeeded || image.path.find_first_of("\t\r\n") != std::string::npos)
+        return false;
+
+    Entry entry;
+    if (!ReadFileStamp(image.path, entry.file_size, entry.modified)) return false;
+    entry.image = image;
+
+    // One tab separated line per image; the trailing tab marks a line that was written whole
+    const ClassificationResult& result = image.result;
+    std::ostringstream line;
+    line << image.path << '\t' << entry.file_size << '\t' << entry.modified << '\t'
+         << result.name << '\t' << result.paint << '\t' << result.certification << '\t'
+         << image.price << '\t' << result.name_confidence << '\t' << result.paint_confidence
+         << '\t' << result.certification_confidence << "\t\n";
+
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (!log_.is_open()) return false;
+    log_ << line.str();
+    log_.flush();
+    entries_[image.path] = entry;
+    return static_cast<bool>(log_);
+}
+
+// Returns the number of images with a result in the log
+size_t CheckpointLog::GetSize() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return entries_.size();
+}
+
+// Reads every complete line of the log and cuts off a line left incomplete by a crash
+void CheckpointLog::LoadLog() {
+    std::string contents;
+    {
+        std::ifstream input(path_to_log_, std::ios::binary);
+        if (!input) return;
+        contents.assign(std::istreambuf_iterator<char>(input), std::istreambuf_iterator<char>());
+    }
+
+    // Anything after the last line break was being written when the job stopped
+    size_t complete = contents.rfind('\n');
+    complete = complete == std::string::npos ? 0 : complete + 1;
+    if (complete != contents.size()) {
+        std::error_code error;
+        std::filesystem::resize_file(path_to_log_, complete, error);
+        contents.resize(complete);
+    }
+
+    std::istringstream lines(contents);
+    std::string line;
+    while (std::getline(lines, line)) {
+        if (!line.empty() && line.back() == '\r') line.pop_back();
+
+        std::vector<std::string> fields;
+        std::stringstream split(line);
+        std::string field;
+        while (std::getline(split, field, '\t')) fields.push_back(field);
+        if (!line.empty() && line.back() == '\t') fields.push_back("");
+        if (fields.size() != LOG_FIELDS) continue;
+
+        Entry entry;
+        ClassificationResult& result = entry.image.result;
+        entry.image.path = fields[0];
+        entry.image.succeeded = true;
+        result.name = fields[3];
+        result.paint = fields[4];
+        result.certification = fields[5];
+        entry.image.price = fields[6];
+        try {
+            entry.file_size = std::stoull(fields[1]);
+            entry.modified = std::stoll(fields[2]);
+            result.name_confidence = std::stof(fields[7]);
+            result.paint_confidence = std::stof(fields[8]);
+            result.certification_confidence = std::stof(fields[9]);
+        } catch (const std::exception&) {
+            continue;  // Skip a line that was edited by hand
+        }
+        entries_[entry.image.path] = entry;
+    }
+}
+
+// Reads the size and last write time of a file
+bool CheckpointLog::ReadFileStamp(const std::string& path_to_file, uintmax_t& file_size,
+                                  long long& modified) {
+    std::error_code error;
+    file_size = std::filesystem::file_size(path_to_file, error);
+    if (error) return false;
+    modified = static_cast<long long>(
+        std::filesystem::last_write_time(path_to_file, error).time_since_epoch().count());
+    return !error;
+}
@@ -0,0 +1,70 @@
+#pragma once
+
+/* Rocket League Classification Checkpoint Log
+by Ridas Jagelavicius
+*/
+
+#include <cstdint>
+#include <fstream>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+
+#include "ResultFormat.h"
+
+class CheckpointLog {
+   public:
+    /** Custom constructor - reads every result already in the log, then opens it for appending
+        A job that is killed part way leaves its finished images in the log, so running it again
+        with the same log only classifies the rest. A line cut short by the crash is discarded
+        @param path_to_log - The full file path to the log; it is created if it does not exist
+    */
+    explicit CheckpointLog(const std::string& path_to_log);
+
+    CheckpointLog(const CheckpointLog&) = delete;
+    CheckpointLog& operator=(const CheckpointLog&) = delete;
+
+    /** Returns whether the log could be opened for appending
+        @return Whether Append() can save results
+    */
+    bool IsOpen() const;
+
+    /** Looks up the logged result of an image
+        An image whose size or modification time changed since it was logged is not found,
+        so a replaced screenshot is classified again
+        @param path_to_image - The path of the image, exactly as it was logged
+        @param image - Set to the logged result if one is found
+        @return Whether the image has a result that is still valid
+    */
+    bool Lookup(const std::string& path_to_image, ClassifiedImage& image) const;
+
+    /** Appends the result of a classified image and flushes it to disk
+        Safe to call from several threads at once. Only images that succeeded are logged, so
+        images that could not be read are tried again on the next run
+        @param image - The classified image
+        @return Whether the result was written; false if the image failed, its path holds a tab or line break, or the log is not open
+    */
+    bool Append(const ClassifiedImage& image);
+
+    /** Returns the number of images with a result in the log
+        @return The number of distinct images logged, including ones that have since changed
+    */
+    size_t GetSize() const;
+
+   private:
+    // A logged result and the state of its file when it was classified
+    struct Entry {
+        uintmax_t file_size; // The size of the image file in bytes
+        long long modified; // The last write time of the image file, in the file clock's ticks
+        ClassifiedImage image; // The logged result
+    };
+
+    std::string path_to_log_; // The full file path to the log
+    std::unordered_map<std::string, Entry> entries_; // Every logged result by image path; later lines replace earlier ones
+    std::ofstream log_; // The log, open for appending
+    mutable std::mutex mutex_; // Guards entries_ and log_
+
+    void LoadLog(); // Reads every complete line of the log and cuts off a line left incomplete by a crash
+    static bool ReadFileStamp(const std::string& path_to_file, uintmax_t& file_size,
+                              long long& modified); // Reads the size and last write time of a file
+};
@@ -0,0 +1,139 @@
+/* Rocket League Classification Result Cache
+by Ridas Jagelavicius
+*/
+
+#include <iostream>
+#include <sstream>
+
+#include "ClassificationCache.h"
+
+// Custom constructor
+ClassificationCache::ClassificationCache(size_t capacity,
+                                         const std::string& path_to_store)
+    : capacity_(capacity > 0 ? capacity : 1),
+      path_to_store_(path_to_store),
+      hits_(0),
+      misses_(0) {
+    if (path_to_store_.empty()) return;
+
+    LoadStore();
+    store_.open(path_to_store_, std::ios::app);
+    if (!store_)
+        std::cout << "Could not open cache store at " << path_to_store_ << std::endl;
+}
+
+// Looks up the result cached for an image and marks it as recently used
+bool ClassificationCache::Lookup(uint64_t key, ClassificationResult& result) {
+    std::lock_guard<std::mutex> lock(mutex_);
+
+    std::unordered_map<uint64_t, std::list<Entry>::iterator>::iterator found =
+        index_.find(key);
+    if (found == index_.end()) {
+        misses_++;
+        return false;
+    }
+
+    // Move the entry to the front without copying it
+    entries_.splice(entries_.begin(), entries_, found->second);
+    result = found->second->second;
+    hits_++;
+    return true;
+}
+
+// Caches the result of classifying an image, and saves it to the store if there is one
+void ClassificationCache::Insert(uint64_t key, const ClassificationResult& result) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    Remember(key, result);
+
+    // One tab separated line per result; item names never contain tabs
+    if (store_.is_open()) {
+        store_ << std::hex << key << std::dec << '\t' << result.name << '\t'
+               << result.paint << '\t' << result.certification << '\t'
+               << result.name_confidence << '\t' << result.paint_confidence
+               << '\t' << result.certification_confidence << '\n';
+        store_.flush();
+    }
+}
+
+// Returns the number of results held in memory
+size_t ClassificationCache::GetSize() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return entries_.size();
+}
+
+// Returns how many lookups found a cached result
+uint64_t ClassificationCache::GetHitCount() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return hits_;
+}
+
+// Returns how many lookups found nothing
+uint64_t ClassificationCache::GetMissCount() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return misses_;
+}
+
+// Removes every result from memory and empties the store
+void ClassificationCache::Clear() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    entries_.clear();
+    index_.clear();
+
+    if (store_.is_open()) {
+        store_.close();
+        store_.open(path_to_store_, std::ios::trunc);
+    }
+}
+
+// Reads every result saved in the store
+void ClassificationCache::LoadStore() {
+    std::ifstream input(path_to_store_);
+    if (!input) return;
+
+    // Later lines are newer, so they end up as the most recently used
+    std::string line;
+    while (std::getline(input, line)) {
+        if (!line.empty() && line.back() == '\r') line.pop_back();
+
+        std::stringstream fields(line);
+        std::string key;
+        std::string confidences[3];
+        ClassificationResult result;
+        std::getline(fields, key, '\t');
+        std::getline(fields, result.name, '\t');
+        std::getline(fields, result.paint, '\t');
+        std::getline(fields, result.certification, '\t');
+        for (std::string& confidence : confidences)
+            std::getline(fields, confidence, '\t');
+
+        try {
+            // Stores written before results had confidences leave them at 0
+            if (!confidences[2].empty()) {
+                result.name_confidence = std::stof(confidences[0]);
+                result.paint_confidence = std::stof(confidences[1]);
+                result.certification_confidence = std::stof(confidences[2]);
+            }
+            Remember(std::stoull(key, nullptr, 16), result);
+        } catch (const std::exception&) {
+            continue;  // Skip a line cut short by a crash
+        }
+    }
+}
+
+// Adds or refreshes a result in memory, evicting the least recently used if full
+void ClassificationCache::Remember(uint64_t key, const ClassificationResult& result) {
+    std::unordered_map<uint64_t, std::list<Entry>::iterator>::iterator found =
+        index_.find(key);
+    if (found != index_.end()) {
+        found->second->second = result;
+        entries_.splice(entries_.begin(), entries_, found->second);
+        return;
+    }
+
+    if (entries_.size() >= capacity_) {
+        index_.erase(entries_.back().first);
+        entries_.pop_back();
+    }
+    entries_.emplace_front(key, result);
+    index_[key] = entries_.begin();
+}
@@ -0,0 +1,72 @@
+#pragma once
+
+/* Rocket League Classification Result Cache
+by Ridas Jagelavicius
+*/
+
+#include <cstddef>
+#include <cstdint>
+#include <fstream>
+#include <list>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <utility>
+
+#include "ItemClassifier.h"
+
+class ClassificationCache {
+   public:
+    /** Custom constructor
+        @param capacity - The most results kept in memory. The least recently used result is dropped first
+        @param path_to_store - A file that results are saved to and loaded from on the next run,
+                               or an empty string to keep results in memory only
+    */
+    ClassificationCache(size_t capacity, const std::string& path_to_store = "");
+
+    /** Looks up the result cached for an image and marks it as recently used
+        @param key - The ContentHash() of the image's pixels or encoded bytes
+        @param result - Set to the cached result if one was found
+        @return Whether a result was cached for the key
+    */
+    bool Lookup(uint64_t key, ClassificationResult& result);
+
+    /** Caches the result of classifying an image, and saves it to the store if there is one
+        @param key - The ContentHash() of the image's pixels or encoded bytes
+        @param result - The result of classifying the image
+    */
+    void Insert(uint64_t key, const ClassificationResult& result);
+
+    /** Returns the number of results held in memory
+        @return The number of cached results
+    */
+    size_t GetSize() const;
+
+    /** Returns how many lookups found a cached result
+        @return The number of cache hits
+    */
+    uint64_t GetHitCount() const;
+
+    /** Returns how many lookups found nothing
+        @return The number of cache misses
+    */
+    uint64_t GetMissCount() const;
+
+    // Removes every result from memory and empties the store
+    void Clear();
+
+   private:
+    typedef std::pair<uint64_t, ClassificationResult> Entry;
+
+    size_t capacity_; // The most results kept in memory
+    std::string path_to_store_; // The file results are saved to, or an empty string
+    std::ofstream store_; // Appends newly inserted results to the store
+    std::list<Entry> entries_; // Cached results, most recently used first
+    std::unordered_map<uint64_t, std::list<Entry>::iterator> index_; // Finds each key's entry in entries_
+    uint64_t hits_; // The number of lookups that found a result
+    uint64_t misses_; // The number of lookups that found nothing
+    mutable std::mutex mutex_; // Guards every member above, so one cache can be shared between classifiers
+
+    void LoadStore(); // Reads every result saved in the store
+    void Remember(uint64_t key, const ClassificationResult& result); // Adds or refreshes a result in memory, evicting if full
+};
@@ -0,0 +1,455 @@
+/* Rocket League Local Classification Server
+by Ridas Jagelavicius
+*/
+
+#include <algorithm>
+#include <cctype>
+#include <iostream>
+#include <json\json.h>
+#include <sstream>
+
+#ifdef _WIN32
+#define NOMINMAX  // Keeps windows.h from replacing std::min and std::max
+#include <winsock2.h>
+#include <ws2tcpip.h>
+#pragma comment(lib, "Ws2_32.lib")
+typedef SOCKET SocketHandle;
+typedef int SocketLength;
+#else
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <sys/select.h>
+#include <sys/socket.h>
+#include <sys/time.h>
+#include <unistd.h>
+typedef int SocketHandle;
+typedef socklen_t SocketLength;
+constexpr SocketHandle INVALID_SOCKET = -1;
+#define closesocket close
+#endif
+
+// A client that hangs up mid-response makes send() fail rather than raise SIGPIPE, which would kill the server
+#ifdef MSG_NOSIGNAL
+constexpr int SEND_FLAGS = MSG_NOSIGNAL;
+#else
+constexpr int SEND_FLAGS = 0;  // Windows has no SIGPIPE; macOS sets SO_NOSIGPIPE on each connection instead
+#endif
+
+#include "ClassificationServer.h"
+
+constexpr size_t MAX_HEAD_BYTES = 16 * 1024;  // Requests with longer headers are refused
+constexpr size_t MAX_BODY_BYTES = 32 * 1024 * 1024;  // Uploads larger than this are refused
+constexpr int RECEIVE_TIMEOUT_SECONDS = 10;  // A connection that sends nothing for this long is closed
+constexpr int ACCEPT_POLL_MILLISECONDS = 100;  // How often the accept loop checks whether the server stopped
+constexpr int LISTEN_BACKLOG = 64;  // Connections the system queues before the server accepts them
+
+// Returns the reason phrase of the status codes the server sends
+static const char* GetReasonPhrase(int status) {
+    switch (status) {
+        case 200: return "OK";
+        case 400: return "Bad Request";
+        case 404: return "Not Found";
+        case 405: return "Method Not Allowed";
+        case 413: return "Payload Too Large";
+        case 431: return "Request Header Fields Too Large";
+        case 500: return "Internal Server Error";
+        default: return "Unknown";
+    }
+}
+
+// Builds a JSON error response
+static HttpResponse MakeError(int status, const std::string& message) {
+    Json::Value error;
+    error["error"] = message;
+    Json::FastWriter writer;
+
+    HttpResponse response;
+    response.status = status;
+    response.body = writer.write(error);
+    return response;
+}
+
+// Sends every byte of a buffer, returning false if the connection was lost
+static bool SendAll(SocketHandle connection, const std::string& data) {
+    size_t sent = 0;
+    while (sent < data.size()) {
+        int count = send(connection, data.data() + sent,
+                         static_cast<int>(std::min<size_t>(data.size() - sent, 1 << 20)), SEND_FLAGS);
+        if (count <= 0) return false;
+        sent += static_cast<size_t>(count);
+    }
+    return true;
+}
+
+// Parses the request line and headers of an HTTP/1.1 request
+bool ParseHttpRequestHead(const std::string& head, HttpRequest& request) {
+    std::istringstream lines(head);
+    std::string line;
+    if (!std::getline(lines, line)) return false;
+    if (!line.empty() && line.back() == '\r') line.pop_back();
+
+    // ex. POST /classify?debug=1 HTTP/1.1
+    std::istringstream request_line(line);
+    std::string target, version;
+    if (!(request_line >> request.method >> target >> version)) return false;
+    if (version.compare(0, 5, "HTTP/") != 0 || target.empty() || target[0] != '/')
+        return false;
+    request.path = target.substr(0, target.find('?'));
+
+    request.headers.clear();
+    while (std::getline(lines, line)) {
+        if (!line.empty() && line.back() == '\r') line.pop_back();
+        if (line.empty()) break;
+
+        size_t colon = line.find(':');
+        if (colon == std::string::npos || colon == 0) return false;
+        std::string name = line.substr(0, colon);
+        std::transform(name.begin(), name.end(), name.begin(), [](char letter) {
+            return static_cast<char>(std::tolower(static_cast<unsigned char>(letter)));
+        });
+
+        size_t first = line.find_first_not_of(" \t", colon + 1);
+        size_t last = line.find_last_not_of(" \t");
+        request.headers[name] =
+            first == std::string::npos ? "" : line.substr(first, last - first + 1);
+    }
+    return true;
+}
+
+// Converts a classification to the JSON a ClassificationServer responds with
+std::string ClassificationToJson(const ClassificationResult& result,
+                                 const std::string& price) {
+    Json::Value item;
+    item["name"] = result.name;
+    item["paint"] = result.paint;
+    item["certification"] = result.certification;
+    item["price"] = price;
+    item["confidence"]["name"] = result.name_confidence;
+    item["confidence"]["paint"] = result.paint_confidence;
+    item["confidence"]["certification"] = result.certification_confidence;
+
+    Json::FastWriter writer;
+    return writer.write(item);
+}
+
+// Custom constructor
+ClassificationServer::ClassificationServer(BatchingClassifier& classifier,
+                                           const std::string& path_to_database_json,
+                                           size_t connection_threads)
+    : classifier_(classifier),
+      database_(path_to_database_json),
+      inventory_(path_to_database_json),
+      connection_threads_(std::max<size_t>(connection_threads, 1)),
+      listen_socket_(static_cast<std::uintptr_t>(INVALID_SOCKET)),
+      port_(0),
+      running_(false) {}
+
+// Stops the server if it is running
+ClassificationServer::~ClassificationServer() {
+    Stop();
+}
+
+// Starts listening for connections on the loopback interface
+bool ClassificationServer::Start(int port) {
+    if (running_) return false;
+
+#ifdef _WIN32
+    WSADATA wsa_data;
+    if (WSAStartup(MAKEWORD(2, 2), &wsa_data) != 0) {
+        std::cout << "Could not start Winsock" << std::endl;
+        return false;
+    }
+#endif
+
+    SocketHandle listener = socket(AF_INET, SOCK_STREAM, IPPROTO_TCP);
+    if (listener == INVALID_SOCKET) {
+        std::cout << "Could not create a socket" << std::endl;
+#ifdef _WIN32
+        WSACleanup();
+#endif
+        return false;
+    }
+
+    int reuse = 1;
+    setsockopt(listener, SOL_SOCKET, SO_REUSEADDR, reinterpret_cast<const char*>(&reuse),
+               sizeof(reuse));
+
+    sockaddr_in address = {};
+    address.sin_family = AF_INET;
+    address.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+    address.sin_port = htons(static_cast<unsigned short>(port));
+    SocketLength length = sizeof(address);
+    if (bind(listener, reinterpret_cast<sockaddr*>(&address), sizeof(address)) != 0 ||
+        listen(listener, LISTEN_BACKLOG) != 0 ||
+        getsockname(listener, reinterpret_cast<sockaddr*>(&address), &length) != 0) {
+        std::cout << "Could not listen on port " << port << std::endl;
+        closesocket(listener);
+#ifdef _WIN32
+        WSACleanup();
+#endif
+        return false;
+    }
+
+    listen_socket_ = static_cast<std::uintptr_t>(listener);
+    port_ = ntohs(address.sin_port);
+    running_ = true;
+    accept_thread_ = std::thread(&ClassificationServer::AcceptConnections, this);
+    for (size_t i = 0; i < connection_threads_; ++i)
+        connection_pool_.emplace_back(&ClassificationServer::HandleConnections, this);
+    return true;
+}
+
+// Stops accepting connections and waits for the ones being handled to finish
+void ClassificationServer::Stop() {
+    if (!running_) return;
+
+    {
+        std::lock_guard<std::mutex> lock(accepted_mutex_);
+        running_ = false;
+    }
+    accepted_changed_.notify_all();
+    accept_thread_.join();
+    for (std::thread& thread : connection_pool_) thread.join();
+    connection_pool_.clear();
+
+    // No thread is left to answer connections that are still queued
+    for (std::uintptr_t connection : accepted_) closesocket(static_cast<SocketHandle>(connection));
+    accepted_.clear();
+
+    closesocket(static_cast<SocketHandle>(listen_socket_));
+    listen_socket_ = static_cast<std::uintptr_t>(INVALID_SOCKET);
+    port_ = 0;
+
+#ifdef _WIN32
+    WSACleanup();
+#endif
+}
+
+// Returns the port the server is listening on
+int ClassificationServer::GetPort() const {
+    return port_;
+}
+
+// Answers a single request, as the server does for each connection
+HttpResponse ClassificationServer::Handle(const HttpRequest& request) {
+    if (request.path == "/classify") {
+        if (request.method != "POST") return MakeError(405, "Use POST with an image body");
+        return ClassifyUpload(request, false);
+    }
+
+    if (request.path == "/inventory") {
+        if (request.method == "POST") return ClassifyUpload(request, true);
+        if (request.method == "GET") return DescribeInventory();
+        return MakeError(405, "Use GET, or POST with an image body");
+    }
+
+    if (request.path == "/statistics") {
+        if (request.method != "GET") return MakeError(405, "Use GET");
+        BatchingStatistics statistics = classifier_.GetStatistics();
+
+        Json::Value body;
+        body["requests"] = static_cast<unsigned long long>(statistics.requests);
+        body["failed_requests"] = static_cast<unsigned long long>(statistics.failed_requests);
+        body["batches"] = static_cast<unsigned long long>(statistics.batches);
+        body["largest_batch"] = static_cast<unsigned long long>(statistics.largest_batch);
+        Json::FastWriter writer;
+
+        HttpResponse response;
+        response.body = writer.write(body);
+        return response;
+    }
+
+    return MakeError(404, "Unknown path " + request.path);
+}
+
+// Answers POST /classify and POST /inventory
+HttpResponse ClassificationServer::ClassifyUpload(const HttpRequest& request,
+                                                  bool add_to_inventory) {
+    if (request.body.empty()) return MakeError(400, "The body must be an encoded image");
+
+    ClassificationResult result;
+    bool decoded;
+    if (!classifier_.Classify(reinterpret_cast<const unsigned char*>(request.body.data()),
+                              request.body.size(), result, &decoded)) {
+        if (!decoded) return MakeError(400, "The body could not be decoded as an image");
+        return MakeError(500, "The image could not be classified");
+    }
+
+    // The database answers -1 or -2 when it has no price
+    std::string price;
+    if (!result.name.empty()) {
+        price = database_.GetPriceOf(result.name, result.paint);
+        if (price == "-1" || price == "-2") price.clear();
+    }
+
+    if (add_to_inventory && !result.name.empty()) {
+        std::lock_guard<std::mutex> lock(inventory_mutex_);
+        inventory_.AddItem(InventoryItem(result.name, result.certification, result.paint, price));
+    }
+
+    HttpResponse response;
+    response.body = ClassificationToJson(result, price);
+    return response;
+}
+
+// Answers GET /inventory
+HttpResponse ClassificationServer::DescribeInventory() {
+    Json::Value body;
+    body["items"] = Json::Value(Json::arrayValue);
+    {
+        std::lock_guard<std::mutex> lock(inventory_mutex_);
+        for (const InventoryItem& item : inventory_.GetItems()) {
+            Json::Value entry;
+            entry["name"] = item.GetName();
+            entry["paint"] = item.GetColor();
+            entry["certification"] = item.GetCertification();
+            entry["quantity"] = item.GetQuantity();
+            entry["price"] = item.GetPriceRange();
+            body["items"].append(entry);
+        }
+        body["worth"] = inventory_.GetInventoryWorth();
+    }
+    Json::FastWriter writer;
+
+    HttpResponse response;
+    response.body = writer.write(body);
+    return response;
+}
+
+// The loop run by accept_thread_
+void ClassificationServer::AcceptConnections() {
+    SocketHandle listener = static_cast<SocketHandle>(listen_socket_);
+    while (running_) {
+        // Waiting with a timeout lets the loop notice Stop() without closing the socket under it
+        fd_set readable;
+        FD_ZERO(&readable);
+        FD_SET(listener, &readable);
+        timeval timeout = {0, ACCEPT_POLL_MILLISECONDS * 1000};
+        if (select(static_cast<int>(listener) + 1, &readable, NULL, NULL, &timeout) <= 0)
+            continue;
+
+        SocketHandle connection = accept(listener, NULL, NULL);
+        if (connection == INVALID_SOCKET) continue;
+
+        // A client that stops sending must not hold a thread forever
+#ifdef _WIN32
+        DWORD receive_timeout = RECEIVE_TIMEOUT_SECONDS * 1000;
+#else
+        timeval receive_timeout = {RECEIVE_TIMEOUT_SECONDS, 0};
+#endif
+        setsockopt(connection, SOL_SOCKET, SO_RCVTIMEO,
+                   reinterpret_cast<const char*>(&receive_timeout), sizeof(receive_timeout));
+#ifdef SO_NOSIGPIPE
+        int no_signal = 1;
+        setsockopt(connection, SOL_SOCKET, SO_NOSIGPIPE, &no_signal, sizeof(no_signal));
+#endif
+
+        // Once the server is stopping, the connection threads may already have finished
+        {
+            std::lock_guard<std::mutex> lock(accepted_mutex_);
+            if (!running_) {
+                closesocket(connection);
+                break;
+            }
+            accepted_.push_back(static_cast<std::uintptr_t>(connection));
+        }
+        accepted_changed_.notify_one();
+    }
+}
+
+// The loop run by each thread of connection_pool_
+void ClassificationServer::HandleConnections() {
+    std::unique_lock<std::mutex> lock(accepted_mutex_);
+    while (true) {
+        accepted_changed_.wait(lock, [this] { return !running_ || !accepted_.empty(); });
+        if (accepted_.empty()) break;  // Connections already accepted are still answered
+
+        std::uintptr_t connection = accepted_.front();
+        accepted_.pop_front();
+        lock.unlock();
+        HandleConnection(connection);
+        lock.lock();
+    }
+}
+
+// Reads one request from a connection, answers it and closes the connection
+void ClassificationServer::HandleConnection(std::uintptr_t handle) {
+    SocketHandle connection = static_cast<SocketHandle>(handle);
+    std::string received;
+    char buffer[64 * 1024];
+    HttpRequest request;
+    HttpResponse response;
+    bool answered = false;
+
+    // Read until the blank line that ends the headers
+    size_t head_end;
+    while ((head_end = received.find("\r\n\r\n")) == std::string::npos) {
+        if (received.size() > MAX_HEAD_BYTES) {
+            response = MakeError(431, "The headers are too long");
+            answered = true;
+            break;
+        }
+        int count = recv(connection, buffer, sizeof(buffer), 0);
+        if (count <= 0) {
+            closesocket(connection);
+            return;
+        }
+        received.append(buffer, count);
+    }
+
+    if (!answered && !ParseHttpRequestHead(received.substr(0, head_end), request)) {
+        response = MakeError(400, "The request could not be parsed");
+        answered = true;
+    }
+
+    // Read the body, which may have started arriving with the headers
+    if (!answered) {
+        size_t body_size = 0;
+        std::map<std::string, std::string>::const_iterator length =
+            request.headers.find("content-length");
+        if (length != request.headers.end()) {
+            try {
+                body_size = static_cast<size_t>(std::stoull(length->second));
+            } catch (const std::exception&) {
+                response = MakeError(400, "The Content-Length is not a number");
+                answered = true;
+            }
+        }
+
+        if (!answered && body_size > MAX_BODY_BYTES) {
+            response = MakeError(413, "The image is too large");
+            answered = true;
+        } else if (!answered) {
+            request.body = received.substr(head_end + 4);
+            request.body.reserve(body_size);
+            while (request.body.size() < body_size) {
+                int count = recv(connection, buffer,
+                                 static_cast<int>(std::min(sizeof(buffer),
+                                                           body_size - request.body.size())),
+                                 0);
+                if (count <= 0) {
+                    closesocket(connection);
+                    return;
+                }
+                request.body.append(buffer, count);
+            }
+            request.body.resize(body_size);
+        }
+    }
+
+    if (!answered) {
+        try {
+            response = Handle(request);
+        } catch (const std::exception& exception) {
+            response = MakeError(500, exception.what());
+        }
+    }
+
+    std::ostringstream head;
+    head << "HTTP/1.1 " << response.status << ' ' << GetReasonPhrase(response.status) << "\r\n"
+         << "Content-Type: " << response.content_type << "\r\n"
+         << "Content-Length: " << response.body.size() << "\r\n"
+         << "Connection: close\r\n\r\n";
+    if (SendAll(connection, head.str())) SendAll(connection, response.body);
+    closesocket(connection);
+}
@@ -0,0 +1,113 @@
+#pragma once
+
+/* Rocket League Local Classification Server
+by Ridas Jagelavicius
+*/
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <map>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "BatchingClassifier.h"
+#include "Inventory.h"
+#include "ItemDatabase.h"
+
+// An HTTP request received by a ClassificationServer
+struct HttpRequest {
+    std::string method; // ex. GET or POST
+    std::string path; // The target without its query string ex. /classify
+    std::map<std::string, std::string> headers; // Header values by lowercase name ex. content-length
+    std::string body; // The bytes sent after the headers
+};
+
+// An HTTP response sent by a ClassificationServer
+struct HttpResponse {
+    int status = 200; // ex. 200 or 404
+    std::string content_type = "application/json"; // The type of body
+    std::string body; // The bytes to send after the headers
+};
+
+/** Parses the request line and headers of an HTTP/1.1 request
+    @param head - Everything received before the blank line that ends the headers
+    @param request - Set to the method, path and headers of the request; the body is left alone
+    @return Whether the request line and every header were well formed
+*/
+bool ParseHttpRequestHead(const std::string& head, HttpRequest& request);
+
+/** Converts a classification to the JSON a ClassificationServer responds with
+    @param result - The result of a classification
+    @param price - The price range of the item ex. 40-50, or an empty string if it is unknown
+    @return An object with the name, paint, certification, price and confidences of the item
+*/
+std::string ClassificationToJson(const ClassificationResult& result, const std::string& price);
+
+class ClassificationServer {
+   public:
+    /** Custom constructor
+        The server answers these requests, each with a JSON body:
+        POST /classify - The body is an encoded image (ex. a .png) of one item tile; responds with its traits and price
+        POST /inventory - Classifies the image like /classify, then adds the item to the server's inventory if it was matched
+        GET /inventory - Responds with every item in the server's inventory and its worth
+        GET /statistics - Responds with how many requests and batches the classifier has run
+        @param classifier - Classifies the uploaded images, batching concurrent requests; must outlive the server
+        @param path_to_database_json - The full file path to the JSON used to price items and build the inventory
+        @param connection_threads - How many connections are handled at once; more wait to be accepted
+    */
+    ClassificationServer(BatchingClassifier& classifier,
+                         const std::string& path_to_database_json,
+                         size_t connection_threads = 8);
+
+    // Stops the server if it is running
+    ~ClassificationServer();
+
+    ClassificationServer(const ClassificationServer&) = delete;
+    ClassificationServer& operator=(const ClassificationServer&) = delete;
+
+    /** Starts listening for connections on the loopback interface
+        Only programs on the same machine can connect; the server is not meant to be exposed
+        @param port - The TCP port to listen on, or 0 to pick any free port (see GetPort())
+        @return Whether the port could be opened
+    */
+    bool Start(int port);
+
+    // Stops accepting connections and waits for the ones being handled to finish
+    void Stop();
+
+    /** Returns the port the server is listening on
+        @return The port passed to Start(), or the one picked if it was 0; 0 if the server is not running
+    */
+    int GetPort() const;
+
+    /** Answers a single request, as the server does for each connection
+        @param request - A parsed request with its body
+        @return The response to send back
+    */
+    HttpResponse Handle(const HttpRequest& request);
+
+   private:
+    BatchingClassifier& classifier_; // Classifies the uploaded images
+    ItemDatabase database_; // Prices classified items
+    Inventory inventory_; // The items added by POST /inventory
+    std::mutex inventory_mutex_; // Guards inventory_, since connections are handled on several threads
+    size_t connection_threads_; // How many connections are handled at once
+    std::uintptr_t listen_socket_; // The socket accepting connections, valid while running_ is set
+    int port_; // The port listen_socket_ is bound to
+    std::atomic<bool> running_; // Whether the server is accepting connections
+    std::deque<std::uintptr_t> accepted_; // Connections waiting for a thread to handle them
+    std::mutex accepted_mutex_; // Guards accepted_
+    std::condition_variable accepted_changed_; // Signalled when a connection is accepted or the server stops
+    std::thread accept_thread_; // Accepts connections into accepted_
+    std::vector<std::thread> connection_pool_; // Handle the connections in accepted_
+
+    void AcceptConnections(); // The loop run by accept_thread_
+    void HandleConnections(); // The loop run by each thread of connection_pool_
+    void HandleConnection(std::uintptr_t connection); // Reads one request from a connection, answers it and closes the connection
+    HttpResponse ClassifyUpload(const HttpRequest& request, bool add_to_inventory); // Answers POST /classify and POST /inventory
+    HttpResponse DescribeInventory(); // Answers GET /inventory
+};
@@ -0,0 +1,142 @@
+/* Rocket League Long-Running Classifier Daemon
+by Ridas Jagelavicius
+*/
+
+#include <algorithm>
+#include <opencv2/imgcodecs.hpp>
+
+#include "ClassifierDaemon.h"
+#include "LatencyProfiler.h"
+#include "MemoryUsage.h"
+
+// Custom constructor - starts the thread that classifies submitted jobs
+ClassifierDaemon::ClassifierDaemon(ItemClassifier& classifier,
+                                   const DaemonLimits& limits,
+                                   ResultHandler handler)
+    : classifier_(classifier),
+      limits_(limits),
+      handler_(handler),
+      jobs_since_recycle_(0),
+      pending_bytes_(0),
+      working_(false),
+      stopping_(false) {
+    limits_.max_pending_jobs = std::max<size_t>(limits_.max_pending_jobs, 1);
+    thread_ = std::thread(&ClassifierDaemon::Run, this);
+}
+
+// Classifies every pending job, then stops the daemon's thread
+ClassifierDaemon::~ClassifierDaemon() {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        stopping_ = true;
+    }
+    changed_.notify_all();
+    thread_.join();
+}
+
+// Queues a job to be classified on the daemon's thread
+void ClassifierDaemon::Submit(DaemonJob job) {
+    std::unique_lock<std::mutex> lock(mutex_);
+    changed_.wait(lock, [this, &job] { return HasRoomFor(job); });
+    pending_bytes_ += job.encoded_image.size();
+    pending_.push_back(std::move(job));
+    lock.unlock();
+    changed_.notify_all();
+}
+
+// Blocks until every submitted job has been classified
+void ClassifierDaemon::Flush() {
+    std::unique_lock<std::mutex> lock(mutex_);
+    changed_.wait(lock, [this] { return pending_.empty() && !working_; });
+}
+
+// Returns what the daemon has done so far
+DaemonStatistics ClassifierDaemon::GetStatistics() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    DaemonStatistics statistics = statistics_;
+    statistics.pending_jobs = pending_.size();
+    return statistics;
+}
+
+// Returns whether a job fits in the queue without crossing a limit
+bool ClassifierDaemon::HasRoomFor(const DaemonJob& job) const {
+    // A job larger than the byte limit is still accepted once the queue is empty
+    if (pending_.empty()) return true;
+    return pending_.size() < limits_.max_pending_jobs &&
+           pending_bytes_ + job.encoded_image.size() <= limits_.max_pending_bytes;
+}
+
+// The loop run by the daemon's thread
+void ClassifierDaemon::Run() {
+    std::unique_lock<std::mutex> lock(mutex_);
+    while (true) {
+        changed_.wait(lock, [this] { return stopping_ || !pending_.empty(); });
+        if (pending_.empty()) break;  // Only stop once every job has been classified
+
+        DaemonJob job = std::move(pending_.front());
+        pending_.pop_front();
+        pending_bytes_ -= job.encoded_image.size();
+        working_ = true;
+        lock.unlock();
+        changed_.notify_all();  // Wake a Submit() waiting for room
+
+        // Classification happens without holding the lock
+        ClassificationResult result;
+        cv::Mat image;
+        bool succeeded = false;
+        try {
+            {
+                ScopedStageTimer timer(PipelineStage::ReadImage);
+                if (!job.encoded_image.empty())
+                    image = cv::imdecode(cv::Mat(1, static_cast<int>(job.encoded_image.size()),
+                                                 CV_8UC1, job.encoded_image.data()),
+                                         cv::IMREAD_COLOR);
+                else
+                    image = cv::imread(job.path_to_image);
+            }
+            succeeded = !image.empty();
+            if (succeeded) result = classifier_.Classify(image);
+        } catch (const std::exception&) {
+            // ex. the model could not be loaded, or memory ran out; the daemon keeps running
+            succeeded = false;
+            result = ClassificationResult();
+        }
+        image.release();
+
+        // Nothing of the job is kept once its result is handed over
+        classifier_.ReleaseLastImage();
+
+        // A handler that throws fails its own job, not the daemon's thread
+        try {
+            handler_(job, result, succeeded);
+        } catch (const std::exception&) {
+            succeeded = false;
+        }
+        job = DaemonJob();
+
+        // Recycle the engines when they have run too long or the process has grown too large
+        size_t resident_bytes = GetResidentBytes();
+        jobs_since_recycle_++;
+        bool recycle =
+            (limits_.max_jobs_per_engine != 0 &&
+             jobs_since_recycle_ >= limits_.max_jobs_per_engine) ||
+            (limits_.max_resident_bytes != 0 && resident_bytes > limits_.max_resident_bytes);
+        if (recycle) {
+            classifier_.ReleaseEngines();
+            jobs_since_recycle_ = 0;
+            resident_bytes = GetResidentBytes();
+        }
+
+        lock.lock();
+        if (recycle) statistics_.engine_recycles++;
+        if (succeeded)
+            statistics_.completed_jobs++;
+        else
+            statistics_.failed_jobs++;
+        statistics_.resident_bytes = resident_bytes;
+        statistics_.peak_resident_bytes =
+            std::max(statistics_.peak_resident_bytes, resident_bytes);
+        working_ = false;
+        changed_.notify_all();  // Wake Flush()
+    }
+}
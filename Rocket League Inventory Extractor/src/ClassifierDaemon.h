@@ -0,0 +1,97 @@
+#pragma once
+
+/* Rocket League Long-Running Classifier Daemon
+by Ridas Jagelavicius
+*/
+
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "ItemClassifier.h"
+
+// An image waiting to be classified by a ClassifierDaemon
+struct DaemonJob {
+    std::string id; // Identifies the job to the result handler ex. the path to the image
+    std::string path_to_image; // The image file to classify, used when encoded_image is empty
+    std::vector<unsigned char> encoded_image; // The bytes of an encoded image (ex. a .png) to classify instead of a file
+};
+
+// The memory bounds a ClassifierDaemon keeps to
+struct DaemonLimits {
+    size_t max_resident_bytes = 0; // The engines are recycled once the process uses more memory than this; 0 for no limit
+    uint64_t max_jobs_per_engine = 0; // The engines are recycled after this many jobs; 0 for no limit
+    size_t max_pending_jobs = 64; // Submit() blocks once this many jobs are waiting
+    size_t max_pending_bytes = 64 * 1024 * 1024; // Submit() blocks once the waiting encoded images hold this many bytes
+};
+
+// What a ClassifierDaemon has done so far
+struct DaemonStatistics {
+    uint64_t completed_jobs = 0; // Jobs that were classified, whether or not an item was matched
+    uint64_t failed_jobs = 0; // Jobs that failed: their image could not be read, classifying it threw or the result handler threw
+    uint64_t engine_recycles = 0; // How many times the engines were shut down to return memory
+    size_t pending_jobs = 0; // Jobs waiting to be classified
+    size_t resident_bytes = 0; // The process's resident memory after the last job
+    size_t peak_resident_bytes = 0; // The most resident memory seen after any job
+};
+
+class ClassifierDaemon {
+   public:
+    // Called on the daemon's thread with each job and its result
+    typedef std::function<void(const DaemonJob& job, const ClassificationResult& result,
+                               bool succeeded)> ResultHandler;
+
+    /** Custom constructor - starts the thread that classifies submitted jobs
+        The classifier keeps no image between jobs, and its engines are shut down and loaded
+        again whenever a limit is crossed, so memory stays bounded however long the daemon runs
+        @param classifier - The classifier to run jobs on, which must outlive the daemon and not be used by anything else
+        @param limits - When to recycle the engines and how much may wait in the queue
+        @param handler - Receives every result; succeeded is false if the image could not be read or classifying it threw.
+                         An exception thrown by the handler counts the job as failed and is not rethrown
+    */
+    ClassifierDaemon(ItemClassifier& classifier, const DaemonLimits& limits,
+                     ResultHandler handler);
+
+    // Classifies every pending job, then stops the daemon's thread
+    ~ClassifierDaemon();
+
+    ClassifierDaemon(const ClassifierDaemon&) = delete;
+    ClassifierDaemon& operator=(const ClassifierDaemon&) = delete;
+
+    /** Queues a job to be classified on the daemon's thread
+        Returns immediately unless the queue is full
+        @param job - The job to classify
+    */
+    void Submit(DaemonJob job);
+
+    // Blocks until every submitted job has been classified
+    void Flush();
+
+    /** Returns what the daemon has done so far
+        @return The job counts, recycles and memory use of the daemon
+    */
+    DaemonStatistics GetStatistics() const;
+
+   private:
+    ItemClassifier& classifier_; // Classifies each job
+    DaemonLimits limits_; // When to recycle the engines and how much may wait in the queue
+    ResultHandler handler_; // Receives every result
+    uint64_t jobs_since_recycle_; // Jobs classified since the engines were last loaded, only used by the daemon's thread
+    std::deque<DaemonJob> pending_; // Jobs waiting to be classified
+    size_t pending_bytes_; // The encoded bytes held by pending_
+    DaemonStatistics statistics_; // What the daemon has done so far
+    bool working_; // Whether the daemon's thread is classifying a job it has taken from pending_
+    bool stopping_; // Set when the daemon is destroyed
+    mutable std::mutex mutex_; // Guards pending_ through stopping_
+    std::condition_variable changed_; // Signalled whenever pending_ or working_ changes
+    std::thread thread_; // Classifies the jobs in pending_
+
+    void Run(); // The loop run by the daemon's thread
+    bool HasRoomFor(const DaemonJob& job) const; // Returns whether a job fits in the queue without crossing a limit
+};
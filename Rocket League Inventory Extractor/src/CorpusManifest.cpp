@@ -0,0 +1,82 @@
+/* Rocket League Labeled Image Corpus Manifest
+by Ridas Jagelavicius
+*/
+
+#include <algorithm>
+#include <fstream>
+
+#include "CorpusManifest.h"
+#include "ResultFormat.h"
+
+constexpr char MANIFEST_HEADER[] = "image,name,paint,certification";
+
+// Splits a CSV row into its fields, undoing the quoting of QuoteCsvField()
+static std::vector<std::string> SplitCsvRow(const std::string& row) {
+    std::vector<std::string> fields(1);
+    bool quoted = false;
+    for (size_t i = 0; i < row.size(); ++i) {
+        char letter = row[i];
+        if (quoted) {
+            if (letter != '"')
+                fields.back() += letter;
+            else if (i + 1 < row.size() && row[i + 1] == '"')
+                fields.back() += row[++i];  // A doubled quote is a quote
+            else
+                quoted = false;
+        } else if (letter == '"') {
+            quoted = true;
+        } else if (letter == ',') {
+            fields.emplace_back();
+        } else {
+            fields.back() += letter;
+        }
+    }
+    return fields;
+}
+
+// Reads a manifest of labeled images
+std::vector<LabeledImage> ReadManifest(const std::string& path_to_manifest) {
+    std::vector<LabeledImage> labeled_images;
+    std::ifstream input(path_to_manifest);
+    if (!input) return labeled_images;
+
+    std::string line;
+    while (std::getline(input, line)) {
+        // Tolerate manifests saved with Windows line endings
+        if (!line.empty() && line.back() == '\r') line.pop_back();
+        if (line.empty() || line == MANIFEST_HEADER) continue;
+
+        // A quoted field with a line break continues on the next line
+        std::string next;
+        while (std::count(line.begin(), line.end(), '"') % 2 == 1 && std::getline(input, next)) {
+            if (!next.empty() && next.back() == '\r') next.pop_back();
+            line += "\n" + next;
+        }
+
+        std::vector<std::string> fields = SplitCsvRow(line);
+        fields.resize(4);
+        LabeledImage labeled;
+        labeled.image = fields[0];
+        labeled.name = fields[1];
+        labeled.paint = fields[2];
+        labeled.certification = fields[3];
+
+        if (!labeled.image.empty()) labeled_images.push_back(labeled);
+    }
+    return labeled_images;
+}
+
+// Writes a manifest of labeled images that can be read by ReadManifest()
+bool WriteManifest(const std::string& path_to_manifest,
+                   const std::vector<LabeledImage>& labeled_images) {
+    std::ofstream output(path_to_manifest);
+    if (!output) return false;
+
+    output << MANIFEST_HEADER << std::endl;
+    for (const LabeledImage& labeled : labeled_images) {
+        output << QuoteCsvField(labeled.image) << "," << QuoteCsvField(labeled.name) << ","
+               << QuoteCsvField(labeled.paint) << "," << QuoteCsvField(labeled.certification)
+               << std::endl;
+    }
+    return static_cast<bool>(output);
+}
@@ -0,0 +1,33 @@
+#pragma once
+
+/* Rocket League Labeled Image Corpus Manifest
+by Ridas Jagelavicius
+*/
+
+#include <string>
+#include <vector>
+
+// An image of a single item and the traits it is known to have
+struct LabeledImage {
+    std::string image; // The file name of the image, relative to the manifest's folder
+    std::string name; // The full name of the item ex. Octane - MG-88
+    std::string paint; // The paint color of the item ex. Cobalt or Default
+    std::string certification; // The base certification of the item or an empty string
+};
+
+/** Reads a manifest of labeled images
+    A manifest is a CSV file with the header "image,name,paint,certification"
+    and one labeled image per line. Fields holding a comma, quote or line break are quoted
+    @param path_to_manifest - The full file path to the manifest
+    @return Every labeled image in the manifest, or an empty vector if the manifest could not be read
+*/
+std::vector<LabeledImage> ReadManifest(const std::string& path_to_manifest);
+
+/** Writes a manifest of labeled images that can be read by ReadManifest()
+    Fields are quoted the way ResultFormat's CSV rows are, so names with commas survive
+    @param path_to_manifest - The full file path to write the manifest to
+    @param labeled_images - The labeled images to write
+    @return Whether the manifest could be written
+*/
+bool WriteManifest(const std::string& path_to_manifest,
+                   const std::vector<LabeledImage>& labeled_images);
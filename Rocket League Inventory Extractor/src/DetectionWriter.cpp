@@ -0,0 +1,130 @@
+/* Rocket League Background Detection Image Writer
+by Ridas Jagelavicius
+*/
+
+#include <algorithm>
+#include <filesystem>
+#include <iostream>
+#include <opencv2/imgcodecs.hpp>
+#include <opencv2/imgproc.hpp>
+
+#include "DetectionWriter.h"
+
+// Draws boxes and their labels onto an image
+void DrawAnnotations(cv::Mat& image, const std::vector<DetectionAnnotation>& annotations) {
+    for (const DetectionAnnotation& annotation : annotations) {
+        const std::vector<cv::Point2f>& corners = annotation.corners;
+        if (corners.empty()) continue;
+        for (size_t j = 0; j < corners.size(); ++j)
+            cv::line(image, corners[j], corners[(j + 1) % corners.size()],
+                     cv::Scalar(0, 255, 0), 1);
+
+        // The label sits just above the box's top left corner
+        cv::Point2f top_left = corners[0];
+        for (const cv::Point2f& corner : corners) {
+            top_left.x = std::min(top_left.x, corner.x);
+            top_left.y = std::min(top_left.y, corner.y);
+        }
+        cv::putText(image, annotation.label,
+                    cv::Point(static_cast<int>(top_left.x),
+                              std::max(8, static_cast<int>(top_left.y) - 2)),
+                    cv::FONT_HERSHEY_SIMPLEX, 0.3, cv::Scalar(0, 255, 255), 1, cv::LINE_AA);
+    }
+}
+
+// Custom constructor - creates the output folder and starts the writer thread
+DetectionWriter::DetectionWriter(const std::string& output_directory,
+                                 size_t max_pending)
+    : output_directory_(output_directory),
+      max_pending_(max_pending > 0 ? max_pending : 1),
+      written_(0),
+      failed_(0),
+      writing_(false),
+      stopping_(false) {
+    std::error_code error;
+    std::filesystem::create_directories(output_directory_, error);
+    if (error)
+        std::cout << "Could not create " << output_directory_ << std::endl;
+
+    thread_ = std::thread(&DetectionWriter::Run, this);
+}
+
+// Writes every pending image, then stops the writer thread
+DetectionWriter::~DetectionWriter() {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        stopping_ = true;
+    }
+    changed_.notify_all();
+    thread_.join();
+}
+
+// Queues an image to be written on the writer thread
+void DetectionWriter::Write(const std::string& file_name, const cv::Mat& image) {
+    Write(file_name, image, std::vector<DetectionAnnotation>());
+}
+
+// Queues an image to be annotated and written on the writer thread
+void DetectionWriter::Write(const std::string& file_name, const cv::Mat& image,
+                            std::vector<DetectionAnnotation> annotations) {
+    if (image.empty()) return;
+
+    std::unique_lock<std::mutex> lock(mutex_);
+    changed_.wait(lock, [this] { return pending_.size() < max_pending_; });
+    pending_.push_back({file_name, image, std::move(annotations)});
+    lock.unlock();
+    changed_.notify_all();
+}
+
+// Blocks until every queued image has been written
+void DetectionWriter::Flush() {
+    std::unique_lock<std::mutex> lock(mutex_);
+    changed_.wait(lock, [this] { return pending_.empty() && !writing_; });
+}
+
+// Returns how many images were written successfully
+size_t DetectionWriter::GetWrittenCount() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return written_;
+}
+
+// Returns how many images could not be written
+size_t DetectionWriter::GetFailedCount() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return failed_;
+}
+
+// The loop run by the writer thread
+void DetectionWriter::Run() {
+    std::unique_lock<std::mutex> lock(mutex_);
+    while (true) {
+        changed_.wait(lock, [this] { return stopping_ || !pending_.empty(); });
+        if (pending_.empty()) break;  // Only stop once everything has been written
+
+        PendingImage job = std::move(pending_.front());
+        pending_.pop_front();
+        writing_ = true;
+        lock.unlock();
+        changed_.notify_all();  // Wake a Write() waiting for room
+
+        // Drawing, encoding and disk access happen without holding the lock
+        std::filesystem::path path = std::filesystem::path(output_directory_) / job.file_name;
+        bool success = false;
+        try {
+            DrawAnnotations(job.image, job.annotations);
+            success = cv::imwrite(path.string(), job.image);
+        } catch (const cv::Exception&) {
+            success = false;
+        }
+        if (!success)
+            std::cout << "Could not write " << path.string() << std::endl;
+
+        lock.lock();
+        writing_ = false;
+        if (success)
+            written_++;
+        else
+            failed_++;
+        changed_.notify_all();  // Wake Flush()
+    }
+}
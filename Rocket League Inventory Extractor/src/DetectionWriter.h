@@ -0,0 +1,93 @@
+#pragma once
+
+/* Rocket League Background Detection Image Writer
+by Ridas Jagelavicius
+*/
+
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+#include <opencv2/opencv.hpp>
+
+// A detected box to draw onto an image before it is written
+struct DetectionAnnotation {
+    std::vector<cv::Point2f> corners; // The corners of the box in order, in the image's pixels
+    std::string label; // The text written above the box ex. its recognized text and confidence
+};
+
+/** Draws boxes and their labels onto an image
+    @param image - The image to draw on
+    @param annotations - The boxes to draw
+*/
+void DrawAnnotations(cv::Mat& image, const std::vector<DetectionAnnotation>& annotations);
+
+class DetectionWriter {
+   public:
+    /** Custom constructor - creates the output folder and starts the writer thread
+        @param output_directory - The folder annotated images are written to
+        @param max_pending - How many images may wait to be written before Write() blocks,
+                             which bounds the memory held by a slow disk
+    */
+    DetectionWriter(const std::string& output_directory, size_t max_pending = 64);
+
+    // Writes every pending image, then stops the writer thread
+    ~DetectionWriter();
+
+    DetectionWriter(const DetectionWriter&) = delete;
+    DetectionWriter& operator=(const DetectionWriter&) = delete;
+
+    /** Queues an image to be written on the writer thread
+        Returns immediately unless max_pending images are already waiting
+        @param file_name - The name of the file within the output folder ex. item1.png
+        @param image - The image to write. It must not be modified after it is queued
+    */
+    void Write(const std::string& file_name, const cv::Mat& image);
+
+    /** Queues an image to be annotated and written on the writer thread
+        The boxes are drawn by the writer thread too, so the caller only pays for the queue
+        @param file_name - The name of the file within the output folder ex. item1.png
+        @param image - The image to draw on and write. It is drawn on in place, so pass a copy
+                       if anything else uses its pixels
+        @param annotations - The boxes to draw onto the image
+    */
+    void Write(const std::string& file_name, const cv::Mat& image,
+               std::vector<DetectionAnnotation> annotations);
+
+    // Blocks until every queued image has been written
+    void Flush();
+
+    /** Returns how many images were written successfully
+        @return The number of images written so far
+    */
+    size_t GetWrittenCount() const;
+
+    /** Returns how many images could not be written
+        @return The number of failed writes so far
+    */
+    size_t GetFailedCount() const;
+
+   private:
+    // An image waiting to be written
+    struct PendingImage {
+        std::string file_name; // The name of the file within the output folder
+        cv::Mat image; // The image to write
+        std::vector<DetectionAnnotation> annotations; // The boxes drawn onto image before it is written
+    };
+
+    std::string output_directory_; // The folder annotated images are written to
+    size_t max_pending_; // The most images that may wait to be written
+    std::deque<PendingImage> pending_; // Images waiting to be written
+    size_t written_; // The number of images written successfully
+    size_t failed_; // The number of images that could not be written
+    bool writing_; // Whether the writer thread is writing an image it has taken from pending_
+    bool stopping_; // Set when the writer is destroyed
+    mutable std::mutex mutex_; // Guards every member above
+    std::condition_variable changed_; // Signalled whenever pending_ or writing_ changes
+    std::thread thread_; // Writes the images in pending_
+
+    void Run(); // The loop run by the writer thread
+};
@@ -0,0 +1,146 @@
+/* Rocket League Image Hashing Utilities
+by Ridas Jagelavicius
+*/
+
+#include <algorithm>
+#include <bitset>
+#include <cstring>
+#include <opencv2/imgproc.hpp>
+
+#include "ImageHash.h"
+
+constexpr int HASH_SIZE = 8;  // The hash is computed from a HASH_SIZE x HASH_SIZE grid of comparisons
+constexpr int DCT_SIZE = 32;  // PerceptualHash() transforms a DCT_SIZE x DCT_SIZE thumbnail
+constexpr uint64_t MIX_1 = 0x87c37b91114253d5ULL;  // Multipliers from MurmurHash3, used by ContentHash()
+constexpr uint64_t MIX_2 = 0x4cf5ad432745937fULL;
+
+// Rotates the bits of a 64-bit value left
+inline uint64_t RotateLeft(uint64_t value, int bits) {
+    return (value << bits) | (value >> (64 - bits));
+}
+
+// Scrambles a 64-bit block before it is folded into a hash
+inline uint64_t MixBlock(uint64_t block) {
+    block *= MIX_1;
+    block = RotateLeft(block, 31);
+    return block * MIX_2;
+}
+
+// Spreads every bit of a hash across the whole value (MurmurHash3 finalizer)
+inline uint64_t Finalize(uint64_t hash) {
+    hash ^= hash >> 33;
+    hash *= 0xff51afd7ed558ccdULL;
+    hash ^= hash >> 33;
+    hash *= 0xc4ceb9fe1a85ec53ULL;
+    return hash ^ (hash >> 33);
+}
+
+// Computes a 64-bit difference hash (dHash) of an image
+uint64_t DifferenceHash(const cv::Mat& image) {
+    if (image.empty()) return 0;
+
+    // Reduce the image to a tiny grayscale thumbnail so only its structure remains
+    cv::Mat gray;
+    if (image.channels() == 1)
+        gray = image;
+    else
+        cv::cvtColor(image, gray, cv::COLOR_BGR2GRAY);
+
+    cv::Mat thumbnail;
+    cv::resize(gray, thumbnail, cv::Size(HASH_SIZE + 1, HASH_SIZE), 0, 0,
+               cv::INTER_AREA);
+
+    // Each bit records whether a pixel is brighter than its right neighbour
+    uint64_t hash = 0;
+    for (int y = 0; y < HASH_SIZE; ++y) {
+        const unsigned char* row = thumbnail.ptr<unsigned char>(y);
+        for (int x = 0; x < HASH_SIZE; ++x) {
+            hash <<= 1;
+            if (row[x] > row[x + 1]) hash |= 1;
+        }
+    }
+    return hash;
+}
+
+// Computes a 64-bit perceptual hash (pHash) of an image
+uint64_t PerceptualHash(const cv::Mat& image) {
+    if (image.empty()) return 0;
+
+    cv::Mat gray;
+    if (image.channels() == 1)
+        gray = image;
+    else
+        cv::cvtColor(image, gray, cv::COLOR_BGR2GRAY);
+
+    cv::Mat thumbnail;
+    cv::resize(gray, thumbnail, cv::Size(DCT_SIZE, DCT_SIZE), 0, 0, cv::INTER_AREA);
+    thumbnail.convertTo(thumbnail, CV_32F);
+
+    cv::Mat frequencies;
+    cv::dct(thumbnail, frequencies);
+
+    // Keep the lowest HASH_SIZE x HASH_SIZE frequencies, where the structure of the image is
+    float coefficients[HASH_SIZE * HASH_SIZE];
+    for (int y = 0; y < HASH_SIZE; ++y) {
+        const float* row = frequencies.ptr<float>(y);
+        for (int x = 0; x < HASH_SIZE; ++x) coefficients[y * HASH_SIZE + x] = row[x];
+    }
+
+    // The median leaves out the first coefficient, which is only the average brightness
+    float sorted[HASH_SIZE * HASH_SIZE - 1];
+    std::copy(coefficients + 1, coefficients + HASH_SIZE * HASH_SIZE, sorted);
+    const int middle = (HASH_SIZE * HASH_SIZE - 1) / 2;
+    std::nth_element(sorted, sorted + middle, sorted + HASH_SIZE * HASH_SIZE - 1);
+    float median = sorted[middle];
+
+    uint64_t hash = 0;
+    for (int i = 0; i < HASH_SIZE * HASH_SIZE; ++i) {
+        hash <<= 1;
+        if (coefficients[i] > median) hash |= 1;
+    }
+    return hash;
+}
+
+// Counts the number of differing bits between two hashes
+int HammingDistance(uint64_t lhs, uint64_t rhs) {
+    return static_cast<int>(std::bitset<64>(lhs ^ rhs).count());
+}
+
+// Computes a fast 64-bit hash of a block of bytes
+uint64_t ContentHash(const void* data, size_t size, uint64_t seed) {
+    const unsigned char* bytes = static_cast<const unsigned char*>(data);
+    uint64_t hash = seed ^ (size * MIX_2);
+
+    // Consume 8 bytes at a time
+    size_t blocks = size / 8;
+    for (size_t i = 0; i < blocks; ++i) {
+        uint64_t block;
+        std::memcpy(&block, bytes + i * 8, 8);
+        hash ^= MixBlock(block);
+        hash = RotateLeft(hash, 27) * 5 + 0x52dce729;
+    }
+
+    // Then the last few bytes
+    uint64_t tail = 0;
+    for (size_t i = blocks * 8; i < size; ++i)
+        tail = (tail << 8) | bytes[i];
+    hash ^= MixBlock(tail);
+
+    return Finalize(hash);
+}
+
+// Computes a fast 64-bit hash of an image's pixels, size and type
+uint64_t ContentHash(const cv::Mat& image) {
+    if (image.empty()) return 0;
+
+    uint64_t hash = (static_cast<uint64_t>(image.rows) << 32) ^
+                    (static_cast<uint64_t>(image.cols) << 8) ^
+                    static_cast<uint64_t>(image.type());
+
+    // A region of a larger image has gaps between its rows, so each row is hashed on its own;
+    // continuous images are hashed the same way, so a region and a copy of it share a key
+    size_t row_bytes = image.cols * image.elemSize();
+    for (int y = 0; y < image.rows; ++y)
+        hash = ContentHash(image.ptr(y), row_bytes, hash);
+    return hash;
+}
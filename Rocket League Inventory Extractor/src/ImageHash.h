@@ -0,0 +1,50 @@
+#pragma once
+
+/* Rocket League Image Hashing Utilities
+by Ridas Jagelavicius
+*/
+
+#include <cstddef>
+#include <cstdint>
+#include <opencv2/opencv.hpp>
+
+/** Computes a 64-bit difference hash (dHash) of an image
+    Visually similar images (ex. the same item tile in two frames of a compressed recording)
+    produce hashes that differ in only a few bits
+    @param image - A BGR or grayscale image, or a region of one
+    @return The 64-bit perceptual hash of the image, or 0 if the image is empty
+*/
+uint64_t DifferenceHash(const cv::Mat& image);
+
+/** Computes a 64-bit perceptual hash (pHash) of an image
+    The hash records which of the lowest 64 frequencies of the image's discrete cosine
+    transform are above their median, so it ignores compression noise and small shifts
+    better than DifferenceHash()
+    @param image - A BGR or grayscale image, or a region of one
+    @return The 64-bit perceptual hash of the image, or 0 if the image is empty
+*/
+uint64_t PerceptualHash(const cv::Mat& image);
+
+/** Counts the number of differing bits between two hashes
+    @param lhs - The first hash
+    @param rhs - The second hash
+    @return The Hamming distance between the two hashes (0-64)
+*/
+int HammingDistance(uint64_t lhs, uint64_t rhs);
+
+/** Computes a fast 64-bit hash of a block of bytes (ex. an encoded .png)
+    Unlike DifferenceHash(), any change to the bytes changes the hash, so equal hashes mean equal content
+    @param data - The bytes to hash
+    @param size - The number of bytes in data
+    @param seed - Mixed into the hash, so the same bytes can be hashed into separate key spaces
+    @return The 64-bit hash of the bytes
+*/
+uint64_t ContentHash(const void* data, size_t size, uint64_t seed = 0);
+
+/** Computes a fast 64-bit hash of an image's pixels, size and type
+    Only the pixels inside the image are hashed, so a region of a larger image hashes the
+    same as a copy of that region
+    @param image - The image to hash, or a region of one
+    @return The 64-bit hash of the image, or 0 if the image is empty
+*/
+uint64_t ContentHash(const cv::Mat& image);
@@ -0,0 +1,102 @@
+/* Rocket League Image Listing
+by Ridas Jagelavicius
+*/
+
+#include <algorithm>
+#include <cctype>
+#include <filesystem>
+#include <stdexcept>
+
+#include "ImageListing.h"
+
+// The extensions cv::imread() is always built with, in lowercase
+constexpr const char* IMAGE_EXTENSIONS[] = {".png", ".jpg",  ".jpeg", ".bmp",
+                                            ".tif", ".tiff", ".webp"};
+
+// Returns whether a file name matches a wildcard pattern
+bool MatchesWildcard(const std::string& name, const std::string& pattern) {
+    // Greedy matching that backtracks only to the last *, which is linear for file names
+    size_t n = 0, p = 0;
+    size_t star = std::string::npos, resume = 0;
+    while (n < name.size()) {
+        if (p < pattern.size() && (pattern[p] == '?' || pattern[p] == name[n])) {
+            n++;
+            p++;
+        } else if (p < pattern.size() && pattern[p] == '*') {
+            star = p++;
+            resume = n;
+        } else if (star != std::string::npos) {
+            p = star + 1;
+            n = ++resume;
+        } else {
+            return false;
+        }
+    }
+    while (p < pattern.size() && pattern[p] == '*') p++;
+    return p == pattern.size();
+}
+
+// Returns whether a file has the extension of an image the classifier can read
+bool HasImageExtension(const std::string& path_to_file) {
+    std::string extension = std::filesystem::path(path_to_file).extension().string();
+    std::transform(extension.begin(), extension.end(), extension.begin(), [](char letter) {
+        return static_cast<char>(std::tolower(static_cast<unsigned char>(letter)));
+    });
+    return std::find(std::begin(IMAGE_EXTENSIONS), std::end(IMAGE_EXTENSIONS), extension) !=
+           std::end(IMAGE_EXTENSIONS);
+}
+
+// Lists the images named by a folder, a wildcard pattern or a single file
+std::vector<std::string> ListImages(const std::string& path_or_pattern) {
+    std::vector<std::string> images;
+    std::filesystem::path path(path_or_pattern);
+    std::error_code error;
+
+    if (std::filesystem::is_directory(path, error)) {
+        for (const std::filesystem::directory_entry& entry :
+             std::filesystem::directory_iterator(path, error))
+            if (entry.is_regular_file(error) && HasImageExtension(entry.path().string()))
+                images.push_back(entry.path().string());
+    } else if (path.filename().string().find_first_of("*?") != std::string::npos) {
+        // Only the file name may hold wildcards; an empty folder means the working directory
+        std::string pattern = path.filename().string();
+        std::filesystem::path folder = path.has_parent_path() ? path.parent_path() : ".";
+        for (const std::filesystem::directory_entry& entry :
+             std::filesystem::directory_iterator(folder, error))
+            if (entry.is_regular_file(error) &&
+                MatchesWildcard(entry.path().filename().string(), pattern))
+                images.push_back(path.has_parent_path() ? entry.path().string()
+                                                        : entry.path().filename().string());
+    } else {
+        images.push_back(path_or_pattern);
+    }
+
+    std::sort(images.begin(), images.end());
+    return images;
+}
+
+// Reads a shard written as <index>/<count>
+bool ParseShard(const std::string& text, size_t& index, size_t& count) {
+    size_t slash = text.find('/');
+    if (slash == std::string::npos || slash == 0 || slash + 1 == text.size()) return false;
+    for (size_t i = 0; i < text.size(); i++)
+        if (i != slash && !std::isdigit(static_cast<unsigned char>(text[i]))) return false;
+
+    try {
+        index = std::stoul(text.substr(0, slash));
+        count = std::stoul(text.substr(slash + 1));
+    } catch (const std::exception&) {
+        return false;  // Too large to be a shard
+    }
+    return count > 0 && index < count;
+}
+
+// Returns the paths that belong to one shard of a job
+std::vector<std::string> SelectShard(const std::vector<std::string>& paths, size_t index,
+                                     size_t count) {
+    std::vector<std::string> shard;
+    if (count == 0) return shard;
+    shard.reserve(paths.size() / count + 1);
+    for (size_t i = index; i < paths.size(); i += count) shard.push_back(paths[i]);
+    return shard;
+}
@@ -0,0 +1,50 @@
+#pragma once
+
+/* Rocket League Image Listing
+by Ridas Jagelavicius
+*/
+
+#include <string>
+#include <vector>
+
+/** Returns whether a file name matches a wildcard pattern
+    * matches any run of characters (including none) and ? matches exactly one; case matters
+    @param name - A file name without its folder ex. OctaneMG88.png
+    @param pattern - The pattern to match ex. *.png or Octane??88.*
+    @return Whether the whole name matches the pattern
+*/
+bool MatchesWildcard(const std::string& name, const std::string& pattern);
+
+/** Returns whether a file has the extension of an image the classifier can read
+    @param path_to_file - The path or name of the file
+    @return Whether the extension is .png, .jpg, .jpeg, .bmp, .tif, .tiff or .webp, in any case
+*/
+bool HasImageExtension(const std::string& path_to_file);
+
+/** Lists the images named by a folder, a wildcard pattern or a single file
+    A folder lists every image directly inside it. A pattern such as shots/Octane*.png may only use
+    wildcards in its last part, and lists every file in that folder that matches. Anything else
+    is returned as it is, whether or not it exists, so a missing file is reported by the caller
+    @param path_or_pattern - A folder, a pattern or the path to a single image
+    @return The paths found, sorted so every run lists them in the same order
+*/
+std::vector<std::string> ListImages(const std::string& path_or_pattern);
+
+/** Reads a shard written as <index>/<count> ex. 0/8 for the first of 8 shards
+    @param text - The shard to read
+    @param index - Set to the index of the shard, from 0 to count - 1
+    @param count - Set to the number of shards
+    @return Whether text is a valid shard
+*/
+bool ParseShard(const std::string& text, size_t& index, size_t& count);
+
+/** Returns the paths that belong to one shard of a job split across several processes or machines
+    Every count-th path is taken starting at index, so the shards are the same size to within one
+    image and together hold every path exactly once. Each process must list the same paths
+    @param paths - Every path in the job, in the order ListImages() returned them
+    @param index - The shard to return, from 0 to count - 1
+    @param count - The number of shards the job is split into
+    @return The paths of the shard, in their original order
+*/
+std::vector<std::string> SelectShard(const std::vector<std::string>& paths, size_t index,
+                                     size_t count);
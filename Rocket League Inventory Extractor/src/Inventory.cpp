@@ -90,6 +90,18 @@ void Inventory::AddItem(const InventoryItem& item) {
     }
 }
 
+// Adds every item of another inventory to this one
+void Inventory::Merge(const Inventory& other) {
+  MergeItems(items_, other.items_);
+
+  // Types were already looked up when other's items were added, so the database is not needed
+  for (std::unordered_map<std::string, std::vector<InventoryItem>>::const_iterator it =
+           other.typeMap_.begin();
+       it != other.typeMap_.end(); ++it) {
+    MergeItems(typeMap_[it->first], it->second);
+  }
+}
+
 // Removes an item from the inventory if it exists
 void Inventory::RemoveItem(const InventoryItem& itemToRemove) {
   
@@ -328,8 +340,14 @@ bool Inventory::WriteInvToFile() {
   // Creates the "saved" folder
   std::filesystem::create_directory("..//saved//");
 
+  return WriteInvToFile("..//saved//inventory.txt");
+}
+
+// Stores an inventory in a particular file for faster retrieval
+bool Inventory::WriteInvToFile(const std::string& path_to_file) {
+
   // Creates a text file containing each inventory item
-  std::ofstream output("..//saved//inventory.txt");
+  std::ofstream output(path_to_file);
 
   // Write each inventory item to file to prevent reclassification
   for(const InventoryItem & item : items_) {
@@ -340,9 +358,10 @@ bool Inventory::WriteInvToFile() {
           << item.GetQuantity() << std::endl
           << item.IsTradable() << std::endl;
   }
+  output.close();
 
   // Check that the file was created
-  std::ifstream check("..//saved//inventory.txt");
+  std::ifstream check(path_to_file);
   if (check)
     return true;
   return false;
@@ -351,9 +370,14 @@ bool Inventory::WriteInvToFile() {
 // Reads in and populates an inventory from saved/inventory.txt
 // Returns whether or not the process could be completed successfully
 bool Inventory::ReadInvFromFile() {
+  return ReadInvFromFile("..//saved//inventory.txt");
+}
+
+// Reads in and populates an inventory from a file written by WriteInvToFile()
+bool Inventory::ReadInvFromFile(const std::string& path_to_file) {
 
   // Check for an existing saved inventory
-  std::ifstream input("..//saved//inventory.txt");
+  std::ifstream input(path_to_file);
 
   if (input) {
 
@@ -385,4 +409,45 @@ bool Inventory::ReadInvFromFile() {
     return true;
   }
   return false;
-}
\ No newline at end of file
+}
+
+// Sums the quantities of matching items and appends the rest
+void Inventory::MergeItems(std::vector<InventoryItem>& items,
+                           const std::vector<InventoryItem>& itemsToAdd) {
+  // Index the items once so each item to add is found in constant time
+  std::unordered_map<std::string, size_t> positions;
+  positions.reserve(items.size() + itemsToAdd.size());
+  for (size_t i = 0; i < items.size(); i++)
+    positions.emplace(ItemKey(items[i]), i);
+
+  // Merging an inventory into itself only doubles quantities, so no item is appended mid-loop
+  size_t count = itemsToAdd.size();
+  for (size_t i = 0; i < count; i++) {
+    const InventoryItem& item = itemsToAdd[i];
+    std::pair<std::unordered_map<std::string, size_t>::iterator, bool> added =
+        positions.emplace(ItemKey(item), items.size());
+
+    if (added.second) {
+      items.push_back(item);
+    } else {
+      InventoryItem& held = items[added.first->second];
+      held.UpdateQuantity(held.GetQuantity() + item.GetQuantity());
+    }
+  }
+}
+
+// Returns a key identifying an item by every property operator== compares
+std::string Inventory::ItemKey(const InventoryItem& item) {
+  // Saved inventories are one property per line, so no property holds a line break
+  std::string key = item.GetName();
+  key += '\n';
+  key += item.GetCertification();
+  key += '\n';
+  key += item.GetColor();
+  key += '\n';
+  key += item.GetRarity();
+  key += '\n';
+  key += item.GetType();
+  key += item.IsTradable() ? "\n1" : "\n0";
+  return key;
+}
@@ -38,6 +38,15 @@ class Inventory{
     */ 
     void AddItem(const InventoryItem & item);
 
+    /** Adds every item of another inventory to this one
+        Quantities of the same item (same name, certification, paint, rarity, tradability and type)
+        are summed and new items are appended in the other inventory's order. Runs in time linear
+        in the size of both inventories, so the partial inventories of a job split into shards
+        (ex. by classify-images --shard) can be combined however large they are
+        @param other - The inventory to add; it is left unchanged
+    */
+    void Merge(const Inventory& other);
+
     /** Removes an item from the inventory if it exists
         Decreases quantity by 1 if item exists
         @param itemToRemove - The InventoryItem to remove from the Inventory
@@ -88,9 +97,23 @@ class Inventory{
     */
     bool ReadInvFromFile();
 
+    /** Stores an inventory in a particular file for faster retrieval
+        @param path_to_file - The full file path to write the inventory to
+        @return whether or not the process was successful
+    */
+    bool WriteInvToFile(const std::string& path_to_file);
+
+    /** Reads in and populates an inventory from a file written by WriteInvToFile()
+        @param path_to_file - The full file path to read the inventory from
+        @return whether or not the process could be completed successfully (file exists and is valid)
+    */
+    bool ReadInvFromFile(const std::string& path_to_file);
+
   private:
     ItemDatabase database_;
     std::vector<InventoryItem> items_; // List of current inventory items
     std::unordered_map<std::string,std::vector<InventoryItem>> typeMap_; // Maps a type (Topper, Antenna) to a vector of items that are that type
     std::vector<InventoryItem>::iterator FindItem(const InventoryItem& item); // Returns an iterator to the passed item or the end if not found
+    static void MergeItems(std::vector<InventoryItem>& items, const std::vector<InventoryItem>& itemsToAdd); // Sums the quantities of matching items and appends the rest
+    static std::string ItemKey(const InventoryItem& item); // Returns a key identifying an item by every property operator== compares
 };
\ No newline at end of file
@@ -0,0 +1,96 @@
+/* Rocket League Synthetic Inventory Generator
+by Ridas Jagelavicius
+*/
+
+#include "InventoryGenerator.h"
+
+constexpr double PAINTED_CHANCE = 0.25;  // The chance a generated item is painted
+constexpr double CERTIFIED_CHANCE = 0.3;  // The chance a generated item is certified
+constexpr double UNTRADABLE_CHANCE = 0.05;  // The chance a generated item cannot be traded
+constexpr double EXTRA_QUANTITY_CHANCE = 0.3;  // The chance each extra copy of an item is owned
+
+// Every paint besides Default
+const std::vector<std::string> PAINTS = {
+    "Black", "White", "Grey", "Crimson", "Pink", "Cobalt", "Sky Blue",
+    "Burnt Sienna", "Saffron", "Lime", "Forest Green", "Orange", "Purple"};
+
+// Every base certification
+const std::vector<std::string> CERTIFICATIONS = {
+    "Striker", "Scorer", "Tactician", "Sweeper", "Victor", "Aviator",
+    "Playmaker", "Goalkeeper", "Sniper", "Paragon", "Guardian", "Acrobat",
+    "Juggler", "Show-Off", "Turtle"};
+
+// Custom constructor - builds a catalog of every priced item and paint variant in a database
+InventoryGenerator::InventoryGenerator(const ItemDatabase& database,
+                                       unsigned seed)
+    : random_(seed) {
+    for (const std::string& name : database.GetAllNames()) {
+        std::string rarity = database.GetRarityOf(name);
+        std::string type = database.GetTypeOf(name);
+
+        std::string price = database.GetPriceOf(name);
+        if (IsPriceRange(price))
+            unpainted_.push_back({name, "Default", rarity, type, price});
+
+        for (const std::string& paint : PAINTS) {
+            price = database.GetPriceOf(name, paint);
+            if (IsPriceRange(price))
+                painted_.push_back({name, paint, rarity, type, price});
+        }
+    }
+}
+
+// Samples a single realistic item
+InventoryItem InventoryGenerator::GenerateItem() {
+    std::bernoulli_distribution painted(PAINTED_CHANCE);
+    std::bernoulli_distribution certified(CERTIFIED_CHANCE);
+    std::bernoulli_distribution untradable(UNTRADABLE_CHANCE);
+    std::geometric_distribution<int> extra_quantity(1 - EXTRA_QUANTITY_CHANCE);
+
+    // Fall back to whichever variants exist if the database has only one kind
+    bool use_painted = painted_.size() > 0 && (unpainted_.empty() || painted(random_));
+    const std::vector<CatalogEntry>& variants = use_painted ? painted_ : unpainted_;
+    if (variants.empty()) return InventoryItem("");
+
+    std::uniform_int_distribution<size_t> pick_variant(0, variants.size() - 1);
+    const CatalogEntry& entry = variants[pick_variant(random_)];
+
+    std::string certification;
+    if (certified(random_)) {
+        std::uniform_int_distribution<size_t> pick_cert(0, CERTIFICATIONS.size() - 1);
+        certification = CERTIFICATIONS[pick_cert(random_)];
+    }
+
+    return InventoryItem(entry.name, certification, entry.paint, entry.rarity,
+                         !untradable(random_), entry.type,
+                         1 + extra_quantity(random_), entry.price);
+}
+
+// Samples many realistic items
+std::vector<InventoryItem> InventoryGenerator::GenerateItems(size_t count) {
+    std::vector<InventoryItem> items;
+    items.reserve(count);
+    for (size_t i = 0; i < count; i++) {
+        items.push_back(GenerateItem());
+    }
+    return items;
+}
+
+// Returns the number of item and paint combinations that can be generated
+size_t InventoryGenerator::GetCatalogSize() const {
+    return unpainted_.size() + painted_.size();
+}
+
+// Returns whether a price looks like "0.5-1"
+bool InventoryGenerator::IsPriceRange(const std::string& price) const {
+    size_t hyphen = price.find('-');
+    if (hyphen == std::string::npos || hyphen == 0 || hyphen == price.size() - 1)
+        return false;
+
+    for (size_t i = 0; i < price.size(); i++) {
+        if (i != hyphen && !isdigit(static_cast<unsigned char>(price[i])) &&
+            price[i] != '.')
+            return false;
+    }
+    return true;
+}
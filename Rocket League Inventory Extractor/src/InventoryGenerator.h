@@ -0,0 +1,55 @@
+#pragma once
+
+/* Rocket League Synthetic Inventory Generator
+by Ridas Jagelavicius
+*/
+
+#include <random>
+#include <string>
+#include <vector>
+
+#include "InventoryItem.h"
+#include "ItemDatabase.h"
+
+class InventoryGenerator {
+   public:
+    /** Custom constructor - builds a catalog of every priced item and paint variant in a database
+        @param database - The ItemDatabase to sample items from
+        @param seed - The seed of the random number generator, so runs can be reproduced
+    */
+    InventoryGenerator(const ItemDatabase& database, unsigned seed);
+
+    /** Samples a single realistic item
+        Most items are unpainted and uncertified, as in a real inventory, and only
+        paint variants that have a price in the database are generated
+        @return An InventoryItem with a name, certification, paint, rarity, type, quantity and price
+    */
+    InventoryItem GenerateItem();
+
+    /** Samples many realistic items
+        @param count - The number of items to generate
+        @return A vector of count generated items, which may contain duplicates
+    */
+    std::vector<InventoryItem> GenerateItems(size_t count);
+
+    /** Returns the number of item and paint combinations that can be generated
+        @return The size of the catalog, or 0 if the database was invalid
+    */
+    size_t GetCatalogSize() const;
+
+   private:
+    // A priced variant of an item
+    struct CatalogEntry {
+        std::string name; // The full name of the item
+        std::string paint; // The paint of the variant ex. Default or Cobalt
+        std::string rarity; // The rarity of the item
+        std::string type; // The type of the item ex. Topper
+        std::string price; // The price range of the variant ex. 2-3
+    };
+
+    std::vector<CatalogEntry> unpainted_; // Every priced Default variant
+    std::vector<CatalogEntry> painted_; // Every priced painted variant
+    std::mt19937 random_; // Drives every sample
+
+    bool IsPriceRange(const std::string& price) const; // Returns whether a price looks like "0.5-1"
+};
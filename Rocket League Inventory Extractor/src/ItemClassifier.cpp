@@ -12,20 +12,40 @@ by Ridas Jagelavicius
 #include <leptonica/allheaders.h>
 #include <string>
 #include <fstream>
-
+#include <cmath>
+#include <algorithm>
+#include <cstdio>
+#include <filesystem>
+#include <cstring>
+#include <map>
+
+#include "ClassificationCache.h"
+#include "ImageHash.h"
 #include "ItemClassifier.h"
 #include "ItemDatabase.h"
-
-constexpr int HEIGHT = 320;         // Resizes preprocessed image to this height
-constexpr int WIDTH = 320;          // Resizes preprocessed image to this width
-constexpr float IMAGE_SCALE = 1.0;  // Preprocessing image scale factor
-constexpr float CONFIDENCE_THRESHOLD = .50;  // How confident we want to be that our text box properly encloses the text
-constexpr float NON_MAX_SUPPRESSION_THRESHOLD = .4;  // This will change detection accuracy and the number of text boxes made
+#include "LatencyProfiler.h"
+#include "OcrVocabulary.h"
+#include "TextNormalizer.h"
+#include "TokenClassifier.h"
+#include "VisualIndex.h"
+
+constexpr int INPUT_ALIGNMENT = 32;  // The network input width and height must be multiples of this
+constexpr int MAX_INPUT_SIDE = 1280;  // Larger images are scaled down so their longest side fits this
+constexpr uint64_t ENCODED_IMAGE_SEED = 0x656e636f646564;  // Keeps cache keys of encoded bytes apart from keys of pixels
+constexpr float MIN_NAME_CONFIDENCE = .70;  // Classify() escalates names less confident than this to the next, slower step
+constexpr float TEXT_BAND_TOP = .50;  // A tile's certification, paint label and name all lie below this fraction of its height
+constexpr float MIN_TILE_ASPECT = 1.0;  // Only images with a height to width ratio in this range are read as a single tile
+constexpr float MAX_TILE_ASPECT = 1.4;
+constexpr int ENHANCE_SCALE = 2;  // How much text boxes are enlarged before being binarized and read again
+constexpr float MIN_NAME_SIMILARITY = .75;  // How alike extracted words and an item name must be for MatchClosestItemName()
+constexpr size_t MAX_DETECTION_BATCH = 16;  // The most images passed through the network at once by ClassifyBatch()
 
 // Custom constructor
 ItemClassifier::ItemClassifier(std::string full_path_to_model,
-                               std::string path_to_database_json) {
+                               std::string path_to_database_json)
+    : minimum_confidence_(MIN_NAME_CONFIDENCE) {
     std::ifstream model(full_path_to_model);
+    detector_options_.model = GuessDetectorModel(full_path_to_model);
 
 	// Load the model 
     if (model.good()) {
@@ -35,60 +55,74 @@ ItemClassifier::ItemClassifier(std::string full_path_to_model,
         std::cout << "Model not found at provided path" << std::endl;
 	}
     database_ = ItemDatabase::ItemDatabase(path_to_database_json);
+
+    // Sanitize and split every item name once rather than on every match
+    for (const std::string& name : database_.GetAllNames()) {
+        std::string sanitized = name;
+        Sanitize(sanitized);
+        std::vector<std::string> words = SplitStringOnSpace(sanitized);
+        std::vector<std::string> sorted = words;
+        std::sort(sorted.begin(), sorted.end());
+
+        std::string sorted_words;
+        for (const std::string& word : sorted)
+            sorted_words += sorted_words.empty() ? word : " " + word;
+        catalog_names_.push_back({name, words, CountNumberOfWords(sanitized),
+                                  sorted_words});
+    }
+
+    // Restrict Tesseract to the words and characters that can appear on a tile
+    std::error_code error;
+    std::filesystem::path temporary = std::filesystem::temp_directory_path(error);
+    if (database_.IsValidDatabase() && !error) {
+        OcrVocabulary vocabulary(database_.GetAllNames());
+        path_to_ocr_config_ = vocabulary.WriteTesseractConfig(temporary.string());
+    }
 }
 
+// Destructor - shuts down the text recognition engine
+ItemClassifier::~ItemClassifier() {
+    if (ocr_)
+        ocr_->End();
+}
 
 
 
-// Decodes positions of text boxes
-void ItemClassifier::Decode(const cv::Mat& scores, const cv::Mat& geometry,
-                float scoreThresh, std::vector<cv::RotatedRect>& detections,
-                std::vector<float>& confidences) {
-    detections.clear();
-    CV_Assert(scores.dims == 4);
-    CV_Assert(geometry.dims == 4);
-    CV_Assert(scores.size[0] == 1);
-    CV_Assert(geometry.size[0] == 1);
-    CV_Assert(scores.size[1] == 1);
-    CV_Assert(geometry.size[1] == 5);
-    CV_Assert(scores.size[2] == geometry.size[2]);
-    CV_Assert(scores.size[3] == geometry.size[3]);
-
-    const int height = scores.size[2];
-    const int width = scores.size[3];
-    for (int y = 0; y < height; ++y) {
-        const float* scoresData = scores.ptr<float>(0, 0, y);
-        const float* x0_data = geometry.ptr<float>(0, 0, y);
-        const float* x1_data = geometry.ptr<float>(0, 1, y);
-        const float* x2_data = geometry.ptr<float>(0, 2, y);
-        const float* x3_data = geometry.ptr<float>(0, 3, y);
-        const float* anglesData = geometry.ptr<float>(0, 4, y);
-        for (int x = 0; x < width; ++x) {
-            float score = scoresData[x];
-            if (score < scoreThresh) continue;
-
-            // Decode a prediction.
-            // Multiple by 4 because feature maps are 4 time less than input
-            // image.
-            float offsetX = x * 4.0f, offsetY = y * 4.0f;
-            float angle = anglesData[x];
-            float cosA = std::cos(angle);
-            float sinA = std::sin(angle);
-            float h = x0_data[x] + x2_data[x];
-            float w = x1_data[x] + x3_data[x];
-
-            cv::Point2f offset(
-                offsetX + cosA * x1_data[x] + sinA * x2_data[x],
-                offsetY - sinA * x1_data[x] + cosA * x2_data[x]);
-            cv::Point2f p1 = cv::Point2f(-sinA * h, -cosA * h) + offset;
-            cv::Point2f p3 = cv::Point2f(-cosA * w, sinA * w) + offset;
-            cv::RotatedRect r(0.5f * (p1 + p3), cv::Size2f(w, h),
-                                -angle * 180.0f / (float)CV_PI);
-            detections.push_back(r);
-            confidences.push_back(score);
-        }
-    }
-}
+
+ // Computes the network input size for an image
+ cv::Size ItemClassifier::ComputeInputSize(const cv::Size& image_size) const {
+     double width = image_size.width;
+     double height = image_size.height;
+
+     // Scale large screenshots down, keeping their aspect ratio
+     double longest = std::max(width, height);
+     if (longest > MAX_INPUT_SIDE) {
+         width *= MAX_INPUT_SIDE / longest;
+         height *= MAX_INPUT_SIDE / longest;
+     }
+
+     // Round each side to the nearest multiple of INPUT_ALIGNMENT
+     int aligned_width = static_cast<int>(std::lround(width / INPUT_ALIGNMENT)) * INPUT_ALIGNMENT;
+     int aligned_height = static_cast<int>(std::lround(height / INPUT_ALIGNMENT)) * INPUT_ALIGNMENT;
+     return cv::Size(std::max(aligned_width, INPUT_ALIGNMENT),
+                     std::max(aligned_height, INPUT_ALIGNMENT));
+ }
+
+
+
+
+ // Decodes an encoded image held in memory
+ cv::Mat ItemClassifier::DecodeImage(const unsigned char* encoded_image,
+                                     size_t size) const {
+     if (encoded_image == nullptr || size == 0)
+         return cv::Mat();
+
+     // Wrap the caller's buffer instead of copying it; imdecode only reads from it
+     cv::Mat buffer(1, static_cast<int>(size), CV_8UC1,
+                    const_cast<unsigned char*>(encoded_image));
+     ScopedStageTimer timer(PipelineStage::ReadImage);
+     return cv::imdecode(buffer, cv::IMREAD_COLOR);
+ }
 
 
 
@@ -115,6 +149,136 @@ cv::Rect ItemClassifier::AddPadding(cv::Mat input_image, cv::Rect cropped_box,
 
 // Detects all the boxes of text in an image
  void ItemClassifier::DetectText(std::string full_path_to_image) {
+     // Load in a test image
+     cv::Mat image;
+     {
+         ScopedStageTimer timer(PipelineStage::ReadImage);
+         image = cv::imread(full_path_to_image);
+     }
+
+	 // Test that image was properly loaded
+     if (image.empty()) {
+         image_.release();
+         gray_.release();
+         std::cout << "Image not found at provided path" << std::endl;
+         return;
+	 }
+
+     DetectText(image);
+ }
+
+
+
+
+// Detects all the boxes of text in an encoded image held in memory
+ void ItemClassifier::DetectText(const unsigned char* encoded_image,
+                                 size_t size) {
+     DetectText(DecodeImage(encoded_image, size));
+ }
+
+
+
+
+// Detects all the boxes of text in an image that is already in memory
+ void ItemClassifier::DetectText(const cv::Mat& image) {
+     if (LoadImage(image))
+         DetectTextInImage();
+ }
+
+
+
+
+// Keeps a 3 channel version of an image as image_ and clears the last detections
+ bool ItemClassifier::LoadImage(const cv::Mat& image) {
+     boxes_.clear();
+     indices_.clear();
+     confidences_.clear();
+     recognized_.clear();
+
+     if (image.empty()) {
+         image_.release();
+         gray_.release();
+         std::cout << "Image must not be empty" << std::endl;
+         return false;
+	 }
+
+     // The network and paint detection expect 3 channels; BGR images are shared, not copied
+     // Tesseract reads 1, so a grayscale image is shared as is rather than converted there and back
+     gray_.release();
+     if (image.channels() == 4)
+         cv::cvtColor(image, image_, cv::COLOR_BGRA2BGR);
+     else if (image.channels() == 1) {
+         cv::cvtColor(image, image_, cv::COLOR_GRAY2BGR);
+         gray_ = image;
+     } else
+         image_ = image;
+     return true;
+ }
+
+
+
+
+// Returns the single channel version of image_, converting it on first use
+ const cv::Mat& ItemClassifier::GetGrayImage() {
+     // Converted once per image, so the text band and every box are cropped from the same pixels
+     // and Tesseract is given a third of the bytes it would copy from a color crop
+     if (gray_.empty() && !image_.empty())
+         cv::cvtColor(image_, gray_, cv::COLOR_BGR2GRAY);
+     return gray_;
+ }
+
+
+
+
+// Returns the image Tesseract's regions are cropped from
+ const cv::Mat& ItemClassifier::GetOcrImage() {
+     return grayscale_ocr_ ? GetGrayImage() : image_;
+ }
+
+
+
+
+// An image part way through ClassifyBatch()
+struct ItemClassifier::PendingTile {
+    size_t index = 0; // The position of the image in the batch
+    cv::Mat image; // The image as converted to 3 channels by LoadImage()
+    cv::Mat gray; // The single channel version of image, if it was made before the text was detected
+    uint64_t key = 0; // The image's ClassificationCache key
+    bool use_cache = true; // Whether the image is looked up in and added to the cache by key
+    TileSignature signature; // The image's VisualIndex signature
+    std::string label_paint; // The paint read from the tile's paint label
+    float label_confidence = 0; // How much of the paint label the paint filled
+    ClassifiedTokens closest; // The most confident name words read so far
+    ClassificationResult result; // The most confident result so far
+    int steps = 0; // How many steps have read words so far
+    TokenRecord* record = nullptr; // Receives the words read by every step, or nullptr if not recording
+    cv::Size input_size; // The size image was resized to for the network
+    std::vector<cv::RotatedRect> boxes; // The text boxes detected in image
+    std::vector<float> confidences; // The confidence of each box in boxes
+    std::vector<int> indices; // The indices of the boxes kept by non-maximum suppression
+};
+
+
+
+
+// Runs the network on image_ to detect its text boxes
+ void ItemClassifier::DetectTextInImage() {
+     std::vector<PendingTile> tiles(1);
+     tiles[0].image = image_;
+     DetectTextInTiles(tiles);
+
+     input_size_ = tiles[0].input_size;
+     boxes_.swap(tiles[0].boxes);
+     confidences_.swap(tiles[0].confidences);
+     indices_.swap(tiles[0].indices);
+     recognized_.clear();
+ }
+
+
+
+
+// Detects the text boxes of every tile, passing tiles of the same input size through the network together
+ void ItemClassifier::DetectTextInTiles(std::vector<PendingTile>& tiles) {
      /* Note:
          Tesseract is a popular text recognition model that maps an image of
     text to the actual content text. tesseract requires a bounded region
@@ -130,78 +294,142 @@ cv::Rect ItemClassifier::AddPadding(cv::Mat input_image, cv::Rect cropped_box,
      /* ======================================= text-detection
       * =======================================*/
 
-     cv::String model = path_to_model_;
-     CV_Assert(!model.empty());
+     // Load the detector once and keep it for every following image
+     if (!detector_)
+         detector_ = CreateTextDetector(path_to_model_, detector_options_);
 
-     // Load network.
-     cv::dnn::Net net = cv::dnn::readNet(model);
+     // Only images resized to the same input size can share a blob; tiles cut from one
+     // screenshot all have the same size, so they usually form a single group
+     std::map<std::pair<int, int>, std::vector<PendingTile*>> groups;
+     for (PendingTile& tile : tiles) {
+         tile.input_size = ComputeInputSize(tile.image.size());
+         groups[{tile.input_size.width, tile.input_size.height}].push_back(&tile);
+     }
 
-     // Specify the output layers for the network
-     std::vector<cv::Mat> outs;
-     std::vector<cv::String> outNames(2);
-     outNames[0] = "feature_fusion/Conv_7/Sigmoid";  // Geometry
-     outNames[1] = "feature_fusion/concat_3";        // Confidence
+     for (const auto& group : groups) {
+         const std::vector<PendingTile*>& members = group.second;
+         for (size_t first = 0; first < members.size(); first += MAX_DETECTION_BATCH) {
+             size_t count = std::min(MAX_DETECTION_BATCH, members.size() - first);
+
+             std::vector<cv::Mat> images;
+             for (size_t n = 0; n < count; ++n) images.push_back(members[first + n]->image);
+             std::vector<TextDetections> detections =
+                 detector_->Detect(images, members[first]->input_size);
+
+             for (size_t n = 0; n < count; ++n) {
+                 PendingTile& tile = *members[first + n];
+                 tile.boxes.swap(detections[n].boxes);
+                 tile.confidences.swap(detections[n].confidences);
+                 tile.indices.swap(detections[n].indices);
+             }
+         }
+     }
+ }
 
-     cv::Mat blob; // Initialize input image and processing image
 
-     // Load in a test image
-     image_ = cv::imread(full_path_to_image);
 
-	 // Test that image was properly loaded
-     if (image_.empty()) {
-         std::cout << "Image not found at provided path" << std::endl;
-         return;
-	 }
 
-     /* Preprocesses an image.
-           The link below explains exactly how this works, but essentially,
-           preprocessing is a multi-step process that "helps combat illumination
-       changes"
-       https://www.pyimagesearch.com/2017/11/06/deep-learning-opencvs-blobfromimage-works/
-       */
-         cv::dnn::blobFromImage(image_, blob, 1.0, cv::Size(WIDTH, HEIGHT),
-                                cv::mean(image_),
-                   true, false);
-
-     // Pass the input image through the network and obtain geometry and
-     // confidence scores
-     net.setInput(blob);
-     net.forward(outs, outNames);
-     cv::Mat scores = outs[0];
-     cv::Mat geometry = outs[1];
-
-     // Decode predicted bounding boxes.
+// Extracts text from boxes detected by DetectText()
+ std::vector<std::string> ItemClassifier::ExtractText() {
      std::vector<float> confidences;
-     Decode(scores, geometry, CONFIDENCE_THRESHOLD, boxes_, confidences);
-
-     // Filter out the best candidates for the correct text box using
-     // non-maximum suppression
-     cv::dnn::NMSBoxes(boxes_, confidences, CONFIDENCE_THRESHOLD,
-                       NON_MAX_SUPPRESSION_THRESHOLD, indices_);
+     std::vector<cv::Rect> regions;
+     return ReadTextBoxes(false, confidences, regions);
  }
 
 
 
 
-// Extracts text from boxes detected by DetectText()
- std::vector<std::string> ItemClassifier::ExtractText() {
-     std::vector<std::string> extracted;
-
+// Returns the text recognition engine, initializing it on first use
+ tesseract::TessBaseAPI& ItemClassifier::GetOcr() {
      /* Reference for setup and implementation:
     https://stackoverflow.com/questions/18180824/how-to-implement-tesseract-to-run-with-project-in-visual-studio-2010
     */
 
-     if (!image_.empty()) {
+     // Initializing loads the language model, so it is done once and kept for every following image
+     if (!ocr_) {
+         ScopedStageTimer timer(PipelineStage::InitOcr);
+         ocr_.reset(new tesseract::TessBaseAPI());
+
+         // User words and patterns can only be loaded along with the language model
+         if (constrain_ocr_ && !path_to_ocr_config_.empty()) {
+             char* configs[] = {const_cast<char*>(path_to_ocr_config_.c_str())};
+             ocr_->Init(NULL, "eng", tesseract::OEM_DEFAULT, configs, 1, NULL,
+                        NULL, false);
+         } else {
+             ocr_->Init(NULL, "eng",
+                        tesseract::OEM_DEFAULT);  // Set OCR to use English
+         }
+     }
+     return *ocr_;
+ }
+
+
+
+
+// Reads every word in a region with its confidence
+ void ItemClassifier::RecognizeWords(const cv::Mat& region,
+                                     int page_segmentation_mode,
+                                     std::vector<std::string>& words,
+                                     std::vector<float>& confidences) {
+     tesseract::TessBaseAPI& ocr = GetOcr();
+     ocr.SetPageSegMode(
+         static_cast<tesseract::PageSegMode>(page_segmentation_mode));
+     ocr.SetImage(region.data, region.cols, region.rows, region.channels(),
+                  static_cast<int>(region.step));
+     if (ocr.Recognize(NULL) != 0)
+         return;
+
+     // Tesseract reports confidences from 0 to 100 and owns none of the text it returns
+     std::unique_ptr<tesseract::ResultIterator> iterator(ocr.GetIterator());
+     if (!iterator)
+         return;
+     do {
+         char* text = iterator->GetUTF8Text(tesseract::RIL_WORD);
+         if (text == NULL)
+             continue;
+         words.push_back(text);
+         confidences.push_back(iterator->Confidence(tesseract::RIL_WORD) / 100.0f);
+         delete[] text;
+     } while (iterator->Next(tesseract::RIL_WORD));
+
+     // Free Tesseract's copy of the region and its results rather than keeping them until the next one
+     iterator.reset();
+     ocr.Clear();
+ }
+
 
-		 // Initialize OCR
-         tesseract::TessBaseAPI* ocr = new tesseract::TessBaseAPI();
-         ocr->Init(NULL, "eng",
-                   tesseract::OEM_DEFAULT);  // Set OCR to use English
-         ocr->SetPageSegMode(static_cast<tesseract::PageSegMode>(
-             8));  // Set OCR to read a single word
 
-         cv::Point2f ratio((float)image_.cols / WIDTH,
-                           (float)image_.rows / HEIGHT);
+
+// Reads the fixed text band of a tile without text boxes
+ void ItemClassifier::ReadTextBand(std::vector<std::string>& words,
+                                   std::vector<float>& confidences,
+                                   std::vector<cv::Rect>& regions) {
+     // Screenshots of several items have no fixed layout to rely on
+     float aspect = static_cast<float>(image_.rows) / image_.cols;
+     if (aspect < MIN_TILE_ASPECT || aspect > MAX_TILE_ASPECT)
+         return;
+
+     // The certification, paint label and name are stacked lines below the item art
+     int top = static_cast<int>(TEXT_BAND_TOP * image_.rows);
+     cv::Mat band = GetOcrImage().rowRange(top, image_.rows);
+     ScopedStageTimer timer(PipelineStage::RecognizeLayout);
+     RecognizeWords(band, tesseract::PSM_SINGLE_BLOCK, words, confidences);
+     regions.resize(words.size(), cv::Rect(0, top, image_.cols, image_.rows - top));
+ }
+
+
+
+
+// Reads each detected box, optionally enlarged and binarized first
+ std::vector<std::string> ItemClassifier::ReadTextBoxes(
+     bool enhance, std::vector<float>& confidences, std::vector<cv::Rect>& regions) {
+     std::vector<std::string> extracted;
+
+     if (!image_.empty()) {
+         cv::Point2f ratio((float)image_.cols / input_size_.width,
+                           (float)image_.rows / input_size_.height);
+         const cv::Mat& ocr_image = GetOcrImage();
+         recognized_.assign(indices_.size(), "");
 
 		 // Read the text of each detected box
          for (size_t i = 0; i < indices_.size(); ++i) {
@@ -226,17 +454,30 @@ cv::Rect ItemClassifier::AddPadding(cv::Mat input_image, cv::Rect cropped_box,
              rectangle = ItemClassifier::AddPadding(
                  image_, rectangle, 2);  // Adds padding to the rectangle for better accuracy
 
-             // Crop original image
-             cv::Rect bounds(0, 0, WIDTH, HEIGHT);
-             cv::Mat cropped = image_(rectangle & bounds);
+             // Crop the grayscale (or, if SetGrayscaleOcr(false), color) version of the original image
+             cv::Rect bounds(0, 0, image_.cols, image_.rows);
+             rectangle &= bounds;
+             if (rectangle.empty())
+                 continue;
+             cv::Mat cropped = ocr_image(rectangle);
 
 			 // Extract text from crop
-             ocr->SetImage(cropped.data, cropped.cols, cropped.rows, 3,
-                           cropped.step);
-             std::string text = std::string(ocr->GetUTF8Text());
-             extracted.push_back(text);
+             ScopedStageTimer timer(PipelineStage::RecognizeBox);
+             if (enhance)
+                 cropped = EnhanceForOcr(cropped);
+             size_t first_word = extracted.size();
+             RecognizeWords(cropped, tesseract::PSM_SINGLE_WORD, extracted,
+                            confidences);  // Set OCR to read a single word
+             regions.resize(extracted.size(), rectangle);
+
+             // A word is only as trustworthy as the box it was read from, so a confidently read
+             // word in a doubtful box still escalates
+             for (size_t w = first_word; w < confidences.size(); ++w)
+                 confidences[w] *= confidences_[indices_[i]];
+
+             for (size_t w = first_word; w < extracted.size(); ++w)
+                 recognized_[i] += w == first_word ? extracted[w] : " " + extracted[w];
          }
-         delete ocr;
      } else {
          std::cout << "Image must be initialized before text can be extracted"
                    << std::endl;
@@ -247,50 +488,489 @@ cv::Rect ItemClassifier::AddPadding(cv::Mat input_image, cv::Rect cropped_box,
 
 
 
+// Enlarges and binarizes a region into dark text on a light background
+ cv::Mat ItemClassifier::EnhanceForOcr(const cv::Mat& region) const {
+     cv::Mat gray = region, enlarged, binary;
+     if (region.channels() != 1)
+         cv::cvtColor(region, gray, cv::COLOR_BGR2GRAY);
+     cv::resize(gray, enlarged, cv::Size(), ENHANCE_SCALE, ENHANCE_SCALE,
+                cv::INTER_CUBIC);
+     cv::threshold(enlarged, binary, 0, 255, cv::THRESH_BINARY | cv::THRESH_OTSU);
+
+     // Item text is lighter than its background, so the background is mostly black
+     if (cv::countNonZero(binary) < static_cast<int>(binary.total()) / 2)
+         cv::bitwise_not(binary, binary);
+     return binary;
+ }
+
+
+
+
+// Runs the full pipeline on an image
+ ClassificationResult ItemClassifier::Classify(const cv::Mat& image) {
+     return ClassifyImages(std::vector<cv::Mat>(1, image), nullptr, true)[0];
+ }
+
+
+
+
+// Runs the full pipeline on an image and records the words every step read
+ ClassificationResult ItemClassifier::Classify(const cv::Mat& image,
+                                               TokenRecord& record) {
+     std::vector<TokenRecord> records;
+     ClassificationResult result = ClassifyBatch(std::vector<cv::Mat>(1, image), &records)[0];
+     record = std::move(records[0]);
+     return result;
+ }
+
+
+
+
+// Runs the full pipeline on several images, detecting their text in as few network passes as possible
+ std::vector<ClassificationResult> ItemClassifier::ClassifyBatch(
+     const std::vector<cv::Mat>& images, std::vector<TokenRecord>* records) {
+     return ClassifyImages(images, records, true);
+ }
+
+
+
+
+// Runs the full pipeline on several images, looking each up in the cache by its pixels only if asked
+ std::vector<ClassificationResult> ItemClassifier::ClassifyImages(
+     const std::vector<cv::Mat>& images, std::vector<TokenRecord>* records, bool use_cache) {
+     std::vector<ClassificationResult> results(images.size());
+     if (records != nullptr)
+         records->assign(images.size(), TokenRecord());
+
+     // Images the cache, the visual index or the text band resolve never reach the network
+     std::vector<PendingTile> pending;
+     for (size_t i = 0; i < images.size(); ++i) {
+         PendingTile tile;
+         tile.index = i;
+         tile.use_cache = use_cache;
+         if (records != nullptr)
+             tile.record = &(*records)[i];
+         if (!StartClassification(images[i], tile, results[i]))
+             pending.push_back(std::move(tile));
+     }
+     if (pending.empty())
+         return results;
+
+     // 2. Detect the text boxes of every remaining image together
+     DetectTextInTiles(pending);
+
+     for (PendingTile& tile : pending)
+         results[tile.index] = FinishClassification(tile);
+     return results;
+ }
+
+
+
+
+// Runs the steps that need no network; returns false if the tile still needs its text detected
+ bool ItemClassifier::StartClassification(const cv::Mat& image, PendingTile& tile,
+                                          ClassificationResult& result) {
+     // A cached result skips detection and recognition entirely
+     if (tile.use_cache && cache_ != nullptr && !image.empty()) {
+         bool cached;
+         {
+             ScopedStageTimer timer(PipelineStage::CacheLookup);
+             tile.key = ContentHash(image);
+             cached = cache_->Lookup(tile.key, result);
+         }
+         if (cached) {
+             ForgetDetections();
+             image_ = image;
+             return true;
+         }
+     }
+
+     if (!LoadImage(image))
+         return true;
+
+     // A tile that looks like one classified before skips detection and recognition too
+     // Its signature is computed on image_, so grayscale and BGRA tiles are indexed as well
+     if (visual_index_ != nullptr) {
+         bool matched;
+         {
+             ScopedStageTimer timer(PipelineStage::VisualLookup);
+             tile.signature = VisualIndex::ComputeSignature(image_);
+             matched = visual_index_->Lookup(tile.signature, result);
+         }
+         if (matched) {
+             if (tile.use_cache && cache_ != nullptr)
+                 cache_->Insert(tile.key, result);
+             return true;
+         }
+     }
+
+     // The paint label is read from the pixels once and shared by every step
+     {
+         ScopedStageTimer timer(PipelineStage::DetectPaint);
+         tile.label_paint = paint_detector_.DetectPaint(image_, tile.label_confidence);
+     }
+
+     if (tile.record != nullptr) {
+         tile.record->image_width = image_.cols;
+         tile.record->image_height = image_.rows;
+         tile.record->label_paint = tile.label_paint;
+         tile.record->label_confidence = tile.label_confidence;
+     }
+
+     // 1. Read the text band of a tile where it always is, without the network
+     std::vector<std::string> words;
+     std::vector<float> word_confidences;
+     std::vector<cv::Rect> regions;
+     ReadTextBand(words, word_confidences, regions);
+     ConsiderWords(RecordedStep::TextBand, words, word_confidences, regions, tile);
+
+     result = tile.result;
+     if (result.name_confidence >= minimum_confidence_) {
+         RememberResult(tile, result);
+         return true;
+     }
+
+     tile.image = image_;
+     tile.gray = gray_;
+     return false;
+ }
+
+
+
+
+// Classifies the words one step read and keeps them if they beat the steps before
+ void ItemClassifier::ConsiderWords(RecordedStep step,
+                                    const std::vector<std::string>& words,
+                                    const std::vector<float>& confidences,
+                                    const std::vector<cv::Rect>& regions,
+                                    PendingTile& tile) {
+     if (tile.record != nullptr) {
+         RecordedPass pass;
+         pass.step = step;
+         for (size_t i = 0; i < words.size(); ++i) {
+             RecordedWord word;
+             word.text = words[i];
+             word.confidence = i < confidences.size() ? confidences[i] : 0;
+             if (i < regions.size()) {
+                 word.x = regions[i].x;
+                 word.y = regions[i].y;
+                 word.width = regions[i].width;
+                 word.height = regions[i].height;
+             }
+             pass.words.push_back(word);
+         }
+         tile.record->passes.push_back(std::move(pass));
+     }
+
+     // Every word is normalized and sorted into paint, certification or name once; the most
+     // confident name words are kept for MatchClosestItemName()
+     ClassifiedTokens tokens = ClassifyTokens(words, confidences);
+     ClassificationResult resolved = ResolveTokens(tokens, tile.label_paint, tile.label_confidence);
+     if (tile.steps == 0 || tokens.name_confidence > tile.closest.name_confidence)
+         tile.closest = tokens;
+     if (tile.steps == 0 || resolved.name_confidence > tile.result.name_confidence ||
+         (tile.result.name.empty() && !resolved.name.empty()))
+         tile.result = resolved;
+     tile.steps++;
+ }
+
+
+
+
+// 4. Tolerates misread characters in the most confident words if no step was confident enough
+ void ItemClassifier::MatchClosestWords(PendingTile& tile) {
+     ClassifiedTokens& closest = tile.closest;
+     if (tile.result.name_confidence >= minimum_confidence_ ||
+         closest.normalized_name_words.empty())
+         return;
+
+     float similarity;
+     std::string name = MatchClosestNormalizedWords(closest.normalized_name_words,
+                                                    similarity);
+     float name_confidence = closest.name_confidence * similarity;
+     if (!name.empty() && (tile.result.name.empty() || name_confidence > tile.result.name_confidence)) {
+         tile.result = ResolveTokens(closest, tile.label_paint, tile.label_confidence);
+         tile.result.name = name;
+         tile.result.name_confidence = name_confidence;
+     }
+ }
+
+
+
+
+// Runs matching on the words recorded from an image, without the image
+ ClassificationResult ItemClassifier::ClassifyRecording(const TokenRecord& record) {
+     PendingTile tile;
+     tile.label_paint = record.label_paint;
+     tile.label_confidence = record.label_confidence;
+
+     // Later steps only ran while the steps before them were not confident enough
+     for (const RecordedPass& pass : record.passes) {
+         if (tile.steps > 0 && tile.result.name_confidence >= minimum_confidence_)
+             break;
+
+         std::vector<std::string> words;
+         std::vector<float> confidences;
+         std::vector<cv::Rect> regions;
+         for (const RecordedWord& word : pass.words) {
+             words.push_back(word.text);
+             confidences.push_back(word.confidence);
+             regions.push_back(cv::Rect(word.x, word.y, word.width, word.height));
+         }
+         ConsiderWords(pass.step, words, confidences, regions, tile);
+     }
+
+     MatchClosestWords(tile);
+     return tile.result;
+ }
+
+
+
+
+// Reads a tile's detected boxes and matches its words to the closest item name
+ ClassificationResult ItemClassifier::FinishClassification(PendingTile& tile) {
+     // The tile's detections become the last image's, so ExtractText() and RenderTextDetections() see them
+     image_ = tile.image;
+     gray_ = tile.gray;
+     input_size_ = tile.input_size;
+     boxes_.swap(tile.boxes);
+     confidences_.swap(tile.confidences);
+     indices_.swap(tile.indices);
+     recognized_.clear();
+
+     // 2. Read each detected box, then 3. read them again enlarged and binarized
+     for (int enhance = 0; enhance < 2 && !indices_.empty() &&
+                           tile.result.name_confidence < minimum_confidence_; ++enhance) {
+         std::vector<float> word_confidences;
+         std::vector<cv::Rect> regions;
+         std::vector<std::string> words =
+             ReadTextBoxes(enhance == 1, word_confidences, regions);
+         ConsiderWords(enhance == 1 ? RecordedStep::EnhancedTextBoxes : RecordedStep::TextBoxes,
+                       words, word_confidences, regions, tile);
+     }
+
+     MatchClosestWords(tile);
+     RememberResult(tile, tile.result);
+     return tile.result;
+ }
+
+
+
+
+// Adds a result to the cache and, if it is confident, to the visual index
+ void ItemClassifier::RememberResult(const PendingTile& tile,
+                                     const ClassificationResult& result) {
+     // An unmatched tile is not cached either, so it is classified again rather than served as unmatched
+     if (tile.use_cache && cache_ != nullptr && !result.name.empty())
+         cache_->Insert(tile.key, result);
+
+     // Only confident tiles are indexed, so an unreadable tile is retried next time
+     if (visual_index_ != nullptr && !result.name.empty() &&
+         result.name_confidence >= minimum_confidence_)
+         visual_index_->Add(tile.signature, result);
+ }
+
+
+
+
+// Runs the full pipeline on an encoded image held in memory
+ ClassificationResult ItemClassifier::Classify(const unsigned char* encoded_image,
+                                               size_t size) {
+     if (cache_ == nullptr || encoded_image == nullptr || size == 0)
+         return Classify(DecodeImage(encoded_image, size));
+
+     // Hashing the encoded bytes lets a repeated upload skip decoding too
+     ClassificationResult result;
+     uint64_t key;
+     bool cached;
+     {
+         ScopedStageTimer timer(PipelineStage::CacheLookup);
+         key = ContentHash(encoded_image, size, ENCODED_IMAGE_SEED);
+         cached = cache_->Lookup(key, result);
+     }
+     if (cached) {
+         ForgetDetections();
+         return result;
+     }
+
+     // The encoded key is the only one cached, so the pixels are neither hashed nor looked up again
+     cv::Mat image = DecodeImage(encoded_image, size);
+     result = ClassifyImages(std::vector<cv::Mat>(1, image), nullptr, false)[0];
+     if (!image.empty() && !result.name.empty())
+         cache_->Insert(key, result);
+     return result;
+ }
+
+
+
+
+ // Answers Classify() from a cache of earlier results
+ void ItemClassifier::SetCache(ClassificationCache* cache) {
+     cache_ = cache;
+ }
+
+
+
+
+ // Answers Classify() from tiles that look like ones classified before
+ void ItemClassifier::SetVisualIndex(VisualIndex* visual_index) {
+     visual_index_ = visual_index;
+ }
+
+
+
+
+ // Clears the image and detections left by the last call to DetectText()
+ void ItemClassifier::ForgetDetections() {
+     image_.release();
+     gray_.release();
+     boxes_.clear();
+     indices_.clear();
+     confidences_.clear();
+     recognized_.clear();
+ }
+
+
+
+
+// Sets how confident Classify() must be of a name before it stops escalating
+ void ItemClassifier::SetMinimumConfidence(float minimum_confidence) {
+     minimum_confidence_ = minimum_confidence;
+ }
+
+
+
+
+// Releases the last image and its text-detections
+ void ItemClassifier::ReleaseLastImage() {
+     ForgetDetections();
+
+     // A dense screenshot leaves thousands of candidate boxes behind
+     std::vector<cv::RotatedRect>().swap(boxes_);
+     std::vector<float>().swap(confidences_);
+ }
+
+
+
+
+// Shuts down the text detection network and the text recognition engine
+ void ItemClassifier::ReleaseEngines() {
+     detector_.reset();
+     if (ocr_) {
+         ocr_->End();
+         ocr_.reset();
+     }
+ }
+
+
+
+
+// Sets how text boxes are detected
+ void ItemClassifier::SetDetectorOptions(const DetectorOptions& options) {
+     // The next detection loads the network again with the new options
+     detector_options_ = options;
+     detector_.reset();
+ }
+
+
+
+
+// Sets whether Tesseract reads the single channel version of the image or color crops of it
+ void ItemClassifier::SetGrayscaleOcr(bool grayscale) {
+     grayscale_ocr_ = grayscale;
+ }
+
+
+
+
+// Sets whether Tesseract is restricted to the words and characters of the database
+ void ItemClassifier::SetConstrainedOcr(bool constrained) {
+     if (constrained == constrain_ocr_)
+         return;
+
+     // The next recognition initializes the engine again with the new setting
+     constrain_ocr_ = constrained;
+     if (ocr_) {
+         ocr_->End();
+         ocr_.reset();
+     }
+ }
+
+
+
+
+// Matches classified words to an item, preferring the paint label read from pixels
+ ClassificationResult ItemClassifier::ResolveTokens(const ClassifiedTokens& tokens,
+                                                    const std::string& label_paint,
+                                                    float label_confidence) {
+     ClassificationResult result;
+     result.certification = tokens.certification;
+     result.certification_confidence = tokens.certification_confidence;
+
+     if (!label_paint.empty()) {
+         result.paint = label_paint;
+         result.paint_confidence = label_confidence;
+     } else {
+         result.paint = tokens.paint;
+         result.paint_confidence = tokens.paint_confidence;
+     }
+
+     // A name is only as certain as the words it was read from
+     result.name = MatchNormalizedWords(tokens.normalized_name_words);
+     if (!result.name.empty())
+         result.name_confidence = tokens.name_confidence;
+     return result;
+ }
+
+
+
+
 // Attempts to match extracted text to a real item
  std::string ItemClassifier::MatchTextToItemName(
-     const std::vector<std::string>& words) { 
+     const std::vector<std::string>& words) {
+     std::vector<std::string> normalized_words;
+     normalized_words.reserve(words.size());
+     for (const std::string& word : words)
+         normalized_words.push_back(NormalizeText(word, NormalizationMode::Word));
+
+     return MatchNormalizedWords(normalized_words);
+ }
+
+// Matches words that have already been normalized to a real item
+ std::string ItemClassifier::MatchNormalizedWords(
+     const std::vector<std::string>& normalized_words) {
+     ScopedStageTimer timer(PipelineStage::MatchName);
 
 	 if (database_.IsValidDatabase()) {
 
 		// Test if raw input matches with an item name
     std::stringstream ssWord;
-    std::vector<std::string> sanitized_words;
+    for (unsigned i = 0; i < normalized_words.size(); i++) {
+      ssWord << normalized_words[i];
 
-    for (unsigned i = 0; i < words.size(); i++) {
-      std::string w = words[i];
-      Sanitize(w);
-      ssWord << w;
-      sanitized_words.push_back(w);
-
-      if(i != words.size()-1) 
+      if(i != normalized_words.size()-1)
         ssWord << " ";
     }
 
     std::string dbName = database_.GetFullNameOf(ssWord.str());
     if (dbName != "-1" && dbName != "-2")
         return dbName;
-    else { 
+    else {
        // Attempt to match the extracted text to a real item
-       std::vector<std::string>& allNames = database_.GetAllNames();
-       int length = words.size();
+       int length = normalized_words.size();
 
        // Loop through all items and look for a good match
-       for (std::string& itemName : allNames) {
+       for (const CatalogName& catalog_name : catalog_names_) {
 
            // Check for matching name length
-           Sanitize(itemName);
-           int numberOfWords = CountNumberOfWords(itemName);
-
-           if (numberOfWords == length) {
+           if (catalog_name.word_count == length) {
 
             // Count the number of words in the possibleMatch that are in the passed item
-            std::vector<std::string> possibleMatch = SplitStringOnSpace(itemName);
             int wordsInCommon = 0;
 
-            for (const std::string& word : sanitized_words) {
-                
-                for (std::string& wordToMatch : possibleMatch) {
+            for (const std::string& word : normalized_words) {
+
+                for (const std::string& wordToMatch : catalog_name.words) {
                     if (word == wordToMatch) {
                         wordsInCommon++;
                     }
@@ -298,10 +978,8 @@ cv::Rect ItemClassifier::AddPadding(cv::Mat input_image, cv::Rect cropped_box,
 
                 // If each word matches, the word has been found
                 if (wordsInCommon == length)
-                  return database_.GetFullNameOf(itemName);
+                  return catalog_name.full_name;
             }
-           } else {
-             continue;
            }
        }
     }
@@ -309,221 +987,221 @@ cv::Rect ItemClassifier::AddPadding(cv::Mat input_image, cv::Rect cropped_box,
    return "";
  }
 
-// Extracts item paint color from extracted text
- std::string ItemClassifier::ExtractColor(std::vector<std::string>& extracted) {
-     std::string color;
-     bool wasErased; // Prevent skipping an element after erasing
-
-     // All available colors besides default
-     std::vector<std::string> colors = {
-         "black",  "white",   "grey", "crimson", "pink",   "cobalt", "blue",
-         "sienna", "saffron", "lime", "green",   "orange", "purple"};
-
-     // Some color modifiers
-     std::vector<std::string> mods = {"burnt", "forest", "sky"};
-
-     // Search extracted text for color
-     std::vector<std::string>::iterator it = extracted.begin();
-     while (it != extracted.end()) {
-         std::string proposed_color = *it;
-         wasErased = false;
-
-         Sanitize(proposed_color);
-
-         // Loop through available colors and search for match
-         for (std::vector<std::string>::iterator it2 = colors.begin();
-              it2 != colors.end(); ++it2) {
-             if (proposed_color == *it2) {
-                 // Remove color from extracted text and return it
-                 it = extracted.erase(it);
-                 wasErased = true;
-                 // Store color
-                 color = *it2;
-                 break;
-             }
+// Counts the edits (insertions, deletions or substitutions) that turn one string into another,
+// giving up and returning max_distance + 1 once that many are needed
+ static int CountEdits(const std::string& from, const std::string& to,
+                       int max_distance) {
+     if (std::abs(static_cast<int>(from.size()) - static_cast<int>(to.size())) > max_distance)
+         return max_distance + 1;
+
+     // Only the previous row of the edit table is kept
+     std::vector<int> previous(to.size() + 1), current(to.size() + 1);
+     for (size_t j = 0; j <= to.size(); ++j)
+         previous[j] = static_cast<int>(j);
+
+     for (size_t i = 1; i <= from.size(); ++i) {
+         current[0] = static_cast<int>(i);
+         int row_minimum = current[0];
+         for (size_t j = 1; j <= to.size(); ++j) {
+             int substitution = previous[j - 1] + (from[i - 1] != to[j - 1]);
+             current[j] = std::min({previous[j] + 1, current[j - 1] + 1, substitution});
+             row_minimum = std::min(row_minimum, current[j]);
          }
+         if (row_minimum > max_distance)
+             return max_distance + 1;
+         previous.swap(current);
+     }
+     return previous[to.size()];
+ }
 
-         // Check if reached end after erasing an element
-         if (it == extracted.end()) {
-             break;
+// Matches extracted text to the item name with the fewest differing characters
+ std::string ItemClassifier::MatchClosestItemName(
+     const std::vector<std::string>& words, float& similarity) {
+     std::vector<std::string> normalized_words;
+     normalized_words.reserve(words.size());
+     for (const std::string& word : words)
+         normalized_words.push_back(NormalizeText(word, NormalizationMode::Word));
+
+     return MatchClosestNormalizedWords(normalized_words, similarity);
+ }
+
+// Matches normalized words to the item name with the fewest differing characters
+ std::string ItemClassifier::MatchClosestNormalizedWords(
+     const std::vector<std::string>& normalized_words, float& similarity) {
+     ScopedStageTimer timer(PipelineStage::MatchClosestName);
+     similarity = 0;
+
+     // Sorting the words on both sides lets words be read in any order
+     std::vector<std::string> sorted = normalized_words;
+     std::sort(sorted.begin(), sorted.end());
+     std::string sorted_words;
+     for (const std::string& word : sorted)
+         if (!word.empty())
+             sorted_words += sorted_words.empty() ? word : " " + word;
+     if (sorted_words.empty())
+         return "";
+
+     std::string closest;
+     for (const CatalogName& catalog_name : catalog_names_) {
+         int longest = static_cast<int>(std::max(sorted_words.size(),
+                                                 catalog_name.sorted_words.size()));
+
+         // Names that cannot beat the best so far are abandoned early
+         float needed = std::max(similarity, MIN_NAME_SIMILARITY);
+         int max_distance = static_cast<int>((1 - needed) * longest);
+         int distance = CountEdits(sorted_words, catalog_name.sorted_words, max_distance);
+         if (distance > max_distance)
+             continue;
+
+         float candidate = 1 - static_cast<float>(distance) / longest;
+         if (candidate > similarity || closest.empty()) {
+             similarity = candidate;
+             closest = catalog_name.full_name;
          }
+     }
+     return closest;
+ }
 
-         // Loop through modifiers and remove the mod
-         for (std::vector<std::string>::iterator it2 = mods.begin();
-              it2 != mods.end(); ++it2) {
-             if (proposed_color == *it2) {
-                 // Remove mod from extracted text
-                 it = extracted.erase(it);
-                 wasErased = true;
+// Extracts item paint color from extracted text
+ std::string ItemClassifier::ExtractColor(std::vector<std::string>& extracted) {
+     std::string color = "Default";  // Unpainted
+
+     // Keep every word that is not part of a paint, shifting them down in one pass
+     size_t kept = 0;
+     std::string normalized;
+     for (size_t i = 0; i < extracted.size(); ++i) {
+         std::string canonical;
+         NormalizeText(extracted[i], NormalizationMode::Word, normalized);
+         switch (ClassifyToken(normalized, canonical)) {
+             case TokenKind::Paint:
+                 color = canonical;
                  break;
-             }
+             case TokenKind::PaintModifier:
+                 break;
+             default:
+                 if (kept != i) extracted[kept] = std::move(extracted[i]);
+                 kept++;
          }
-
-         if (it != extracted.end() && !wasErased)
-          ++it;
      }
+     extracted.resize(kept);
 
-     if (!color.empty() && it == extracted.end()) {
-         if (color == "sienna") return "Burnt Sienna";
-         if (color == "blue") return "Sky Blue";
-         if (color == "green") return "Forest Green";
-         color[0] = toupper(color[0]);
-         return color;
+     return color;
+ }
+
+
+// Detects item paint color from the paint label on the image
+ std::string ItemClassifier::DetectColor(std::vector<std::string>& extracted) {
+     // Paint words still have to be removed before matching the name
+     return PreferDetectedPaint(ExtractColor(extracted));
+ }
+
+
+// Returns the paint read from the image's paint label, or ocr_paint if there is no label
+ std::string ItemClassifier::PreferDetectedPaint(const std::string& ocr_paint) {
+     std::string pixel_color;
+     {
+         ScopedStageTimer timer(PipelineStage::DetectPaint);
+         pixel_color = paint_detector_.DetectPaint(image_);
      }
+     if (!pixel_color.empty())
+         return pixel_color;
 
-     return "Default";  // Unpainted
+     return ocr_paint;
  }
 
 
 // Extracts item certifications from extracted text
  std::string ItemClassifier::ExtractCertification(
      std::vector<std::string>& extracted) {
-
-	 std::string extractedCert;
-
-     // All available certifications
-     std::vector<std::string> certs = {
-         "striker",        "scorer",    "tactician",   "sweeper", "victor",
-         "aviator",       "playmaker", "goalkeeper", "sniper", "paragon",
-         "guardian", "acrobat",   "juggler", "show-off", "turtle"};
-
-	 // All certification modifiers
-     std::vector<std::string> mods = {
-		 "certified",  "capable",   "skillfull",
-         "veteran",    "fantastic", "incredible",
-         "ridiculous", "daring",    "determined"};
-
-     // Search extracted text for modifiers or certification
-     std::vector<std::string>::iterator it =
-         extracted.begin();
-     while(it != extracted.end()) {
-         std::string proposed_cert = *it;
-
-         Sanitize(proposed_cert);
-
-         // Loop through available certs and search for match
-         for (std::vector<std::string>::iterator it2 = certs.begin();
-              it2 != certs.end(); ++it2) {
-             if (proposed_cert == *it2) {
-                 // Remove cert from extracted text and store it
-                 it = extracted.erase(it);
-
-                 // Capitalize first letter and return result
-                 extractedCert = *it2;
-                 extractedCert[0] = toupper(extractedCert[0]);
+     std::string extractedCert;
+
+     // Keep every word that is not part of a certification, shifting them down in one pass
+     size_t kept = 0;
+     std::string normalized;
+     for (size_t i = 0; i < extracted.size(); ++i) {
+         std::string canonical;
+         NormalizeText(extracted[i], NormalizationMode::Word, normalized);
+         switch (ClassifyToken(normalized, canonical)) {
+             case TokenKind::Certification:
+                 extractedCert = canonical;
                  break;
-             }
-         }
-
-         // Check if reached end after erasing an element
-         if (it == extracted.end()) {
-            break;
-         }
-
-		     // Loop through modifiers and remove the mod
-         for (std::vector<std::string>::iterator it2 = mods.begin();
-              it2 != mods.end(); ++it2) {
-             if (proposed_cert == *it2) {
-                 // Remove cert from extracted text and store it
-                 it = extracted.erase(it);
+             case TokenKind::CertificationModifier:
                  break;
-             }
+             default:
+                 if (kept != i) extracted[kept] = std::move(extracted[i]);
+                 kept++;
          }
-
-         if (it != extracted.end()) 
-          ++it;
      }
+     extracted.resize(kept);
 
      return extractedCert;
  }
 
 
+ // Returns the size the last image was resized to before being passed through the network
+ cv::Size ItemClassifier::GetInputSize() const {
+     return input_size_;
+ }
+
  // Draws the base image with rendered text-detections
  void ItemClassifier::RenderTextDetections() const {
 	 if (!image_.empty()) {
-         // Render detections.
-             std::vector<cv::RotatedRect> boxes = boxes_;
-             cv::Point2f ratio((float)image_.cols / WIDTH,
-                           (float)image_.rows / HEIGHT);
-
-         for (size_t i = 0; i < indices_.size(); ++i) {
-             cv::RotatedRect& box = boxes[indices_[i]];
-             cv::Point2f vertices[4];
-             box.points(vertices);
-
-             for (int j = 0; j < 4; ++j) {
-                 vertices[j].x *= ratio.x;
-                 vertices[j].y *= ratio.y;
-             }
-
-             for (int j = 0; j < 4; ++j)
-                 line(image_, vertices[j], vertices[(j + 1) % 4],
-                      cv::Scalar(0, 255, 0), 1);
-         }
+         // Render detections on a copy, since image_ may share pixels with the caller
+         cv::Mat rendered = image_.clone();
+         DrawAnnotations(rendered, DescribeTextDetections());
 
 		 // Show image
-         cv::imshow("Image with Rendered Detections", image_);
+         cv::imshow("Image with Rendered Detections", rendered);
 
 		 // Wait for key press to close image
          cv::waitKey(0);
 	 }
  }
 
- // Sanitizes words for better matching
- void ItemClassifier::Sanitize(std::string& word_or_item) {
 
-	 // Define strange symbols to be removed
-     std::vector<char> toRemove = {'\n' ,'[', ']', '{', '}', '!', '/',
-                                   '\\',     '.', ':', ';', '_'};
-     
-	 // Sometimes item names look like this "Item - Characteristic"
-	 // In that case, be aware of the extra space after the hyphen
-	 // Because this is 2 words, not 3
-	 bool wasHyphen = false;
-
-   bool wasErased;
-	 // Loop through word or item
-     std::string::iterator it = word_or_item.begin();
-     while (it != word_or_item.end()) {
-         wasErased = false;
-
-		 // If the previous character was a hyphen, check for a space to remove
-         if (wasHyphen) {
-
-            if (*it == ' ') {
-			        it = word_or_item.erase(it);
-			      }
-
-         wasHyphen = false;
-         continue;
-		     }
-
-		 // Check if current char is a hyphen
-         if (*it == '-') {
-            wasHyphen = true;
-            it = word_or_item.erase(it);
-            wasErased = true;
-            continue;
-		     }
-
-		 // Remove any strange characters
-         for (std::vector<char>::iterator it2 = toRemove.begin();
-            it2 != toRemove.end(); ++it2) {
-
-			     if (*it == *it2) {
-              it = word_or_item.erase(it);
-              wasErased = true;
-              break;
-			     }
-		     }
-
-         if (it != word_or_item.end() && !wasErased)
-		       ++it;
-	   }
-
-	 // Convert word to lowercase
-     std::transform(word_or_item.begin(), word_or_item.end(),
-                word_or_item.begin(), ::tolower);
+
+
+// Queues a copy of the last image with its text-detections to be drawn and written
+ void ItemClassifier::RenderTextDetections(DetectionWriter& writer,
+                                           const std::string& file_name) const {
+     // The writer draws on the image it is given, and image_ may share pixels with the caller
+     if (!image_.empty())
+         writer.Write(file_name, image_.clone(), DescribeTextDetections());
+ }
+
+
+
+
+// Returns the detected boxes in image_'s pixels, labeled with their text and confidence
+ std::vector<DetectionAnnotation> ItemClassifier::DescribeTextDetections() const {
+     std::vector<DetectionAnnotation> annotations;
+     cv::Point2f ratio((float)image_.cols / input_size_.width,
+                       (float)image_.rows / input_size_.height);
+
+     for (size_t i = 0; i < indices_.size(); ++i) {
+         cv::Point2f vertices[4];
+         boxes_[indices_[i]].points(vertices);
+
+         DetectionAnnotation annotation;
+         for (int j = 0; j < 4; ++j)
+             annotation.corners.push_back(cv::Point2f(vertices[j].x * ratio.x,
+                                                      vertices[j].y * ratio.y));
+
+         // Label the box with its text (once ExtractText() has run) and confidence
+         std::string text = i < recognized_.size() ? recognized_[i] : "";
+         text.erase(std::remove(text.begin(), text.end(), '\n'), text.end());
+         char confidence[16];
+         std::snprintf(confidence, sizeof(confidence), "%.2f",
+                       confidences_[indices_[i]]);
+         annotation.label = text.empty() ? confidence : text + " " + confidence;
+         annotations.push_back(annotation);
+     }
+     return annotations;
+ }
+
+// Sanitizes words for better matching
+ void ItemClassifier::Sanitize(std::string& word_or_item) {
+     word_or_item = NormalizeText(word_or_item, NormalizationMode::Word);
  }
 
  // Counts the number of words in a sanitized string
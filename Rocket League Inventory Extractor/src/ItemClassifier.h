@@ -4,25 +4,176 @@
 by Ridas Jagelavicius
 */
 
+#include <memory>
 #include <string>
 #include <opencv2/opencv.hpp>
+#include <opencv2/dnn.hpp>
+#include "DetectionWriter.h"
 #include "ItemDatabase.h"
 #include "InventoryItem.h"
+#include "PaintDetector.h"
+#include "TextDetector.h"
+#include "TokenClassifier.h"
+#include "TokenRecording.h"
+
+class ClassificationCache;
+class VisualIndex;
+namespace tesseract {
+class TessBaseAPI;
+}
+
+// The traits of a single item extracted by ItemClassifier::Classify()
+struct ClassificationResult {
+    std::string name; // The matched item name or an empty string if no match was made
+    std::string paint; // The paint color of the item ex. Cobalt or Default
+    std::string certification; // The base certification of the item or an empty string
+    float name_confidence = 0; // How sure the classifier is of the name, from 0 to 1; 0 if no match was made
+    float paint_confidence = 0; // How sure the classifier is of the paint, from 0 to 1
+    float certification_confidence = 0; // How sure the classifier is of the certification (or of there being none), from 0 to 1
+};
 
 class ItemClassifier {
    public:
 	  /** Custom constructor
         @param full_path_to_model - The full file path to the Frozen EAST Text Detection (or equivalent) model
+                                    A .onnx model is taken to be DB unless its name contains east; see SetDetectorOptions()
         @param path_to_database_json - The full file path to the JSON that will be used to create a Database object
     */
     ItemClassifier(std::string full_path_to_model,
                    std::string path_to_database_json);
 
+    // Destructor - shuts down the text recognition engine
+    ~ItemClassifier();
+
     /** Detects all the boxes of text in an image
         @param full_path_to_image - The full file path to an image of a single rocket league item
     */
     void DetectText(std::string full_path_to_image);
 
+    /** Detects all the boxes of text in an image that is already in memory
+        The pixels are shared with the caller rather than copied, so the image must not be
+        modified until the classifier is done with it. BGRA and grayscale images are converted to BGR
+        @param image - A BGR image (or a region of one) of a single rocket league item
+    */
+    void DetectText(const cv::Mat& image);
+
+    /** Detects all the boxes of text in an encoded image (ex. the bytes of a .png) held in memory
+        The buffer is decoded in place without being copied first
+        @param encoded_image - The bytes of an encoded image
+        @param size - The number of bytes in encoded_image
+    */
+    void DetectText(const unsigned char* encoded_image, size_t size);
+
+    /** Runs the full pipeline (detection, extraction, certification, color and name matching) on an image
+        The pipeline is a cascade that stops as soon as the name is at least as confident as SetMinimumConfidence():
+        1. The text band of a tile is read in one pass at its fixed position, without the network
+        2. EAST detects text boxes and each box is read on its own
+        3. The same boxes are enlarged and binarized, then read again
+        4. The most confident words are matched to the closest item name with MatchClosestItemName()
+        Easy tiles only pay for the first step. The most confident result of the steps that ran is returned
+        @param image - A BGR image (or a region of one) of a single rocket league item
+        @return The extracted traits of the item and their confidences; the name is empty if no match was made
+    */
+    ClassificationResult Classify(const cv::Mat& image);
+
+    /** Runs the full pipeline on an image and records the words every step read
+        The record can be saved with a TokenRecordWriter and passed to ClassifyRecording() later,
+        so changes to matching can be tried without running EAST and Tesseract again.
+        Only the steps that ran are recorded; use SetMinimumConfidence(1) to record every step.
+        An image answered by the cache or visual index has no steps
+        @param image - A BGR image (or a region of one) of a single rocket league item
+        @param record - Set to the words read by each step; its image_id is left for the caller to set
+        @return The extracted traits of the item and their confidences; the name is empty if no match was made
+    */
+    ClassificationResult Classify(const cv::Mat& image, TokenRecord& record);
+
+    /** Runs the full pipeline on several images at once
+        Each image gets the same result Classify() would give it, but the images that reach the
+        second step have their text detected together: images of the same size share one pass
+        through the network, which costs far less than a pass per image.
+        Afterwards ExtractText() and RenderTextDetections() see the last image that needed text detection
+        @param images - BGR images (or regions of them), each of a single rocket league item
+        @param records - If not nullptr, set to the words read from each image as by Classify(image, record)
+        @return The result of each image, in the same order as images
+    */
+    std::vector<ClassificationResult> ClassifyBatch(const std::vector<cv::Mat>& images,
+                                                    std::vector<TokenRecord>* records = nullptr);
+
+    /** Runs matching on the words recorded from an image, without the image
+        The steps of the record are considered exactly as Classify() considered them, stopping
+        once a name is as confident as SetMinimumConfidence(), so the result is the same as the
+        recorded run unless the matching code, database or minimum confidence has changed
+        @param record - A record made by Classify() ex. read back by a TokenRecordReader
+        @return The traits matched from the recorded words
+    */
+    ClassificationResult ClassifyRecording(const TokenRecord& record);
+
+    /** Runs the full pipeline on an encoded image (ex. the bytes of a .png) held in memory
+        @param encoded_image - The bytes of an encoded image
+        @param size - The number of bytes in encoded_image
+        @return The extracted traits of the item; the name is empty if no match was made
+    */
+    ClassificationResult Classify(const unsigned char* encoded_image, size_t size);
+
+    /** Answers Classify() from a cache of earlier results
+        Images are looked up by a hash of their pixels (or encoded bytes), so an image that
+        was classified before returns its result without running detection or recognition.
+        Only results with a name are cached, so an image that matched no item is classified again.
+        RenderTextDetections() draws no boxes for a cached result
+        @param cache - The cache to use, which must outlive the classifier, or nullptr to stop caching
+    */
+    void SetCache(ClassificationCache* cache);
+
+    /** Answers Classify() from tiles that look like ones classified before
+        Unlike SetCache(), a tile does not have to be identical to match, so the same item
+        captured again (with different compression noise) skips detection and recognition.
+        Every tile resolved by the full pipeline is added to the index.
+        RenderTextDetections() draws no boxes for a matched tile
+        @param visual_index - The index to use, which must outlive the classifier, or nullptr to stop using one
+    */
+    void SetVisualIndex(VisualIndex* visual_index);
+
+    /** Sets how confident Classify() must be of a name before it stops escalating to slower steps
+        Only results at least this confident are added to the VisualIndex
+        @param minimum_confidence - A confidence from 0 to 1; 0 stops after the first step and 1 always runs every step
+    */
+    void SetMinimumConfidence(float minimum_confidence);
+
+    /** Sets how text boxes are detected
+        The model file passed to the constructor must have the architecture given here. A quantized
+        (INT8) model is used the same way as the full precision model it was made from.
+        Changing this loads the network again
+        @param options - The architecture of the model and the cv::dnn backend to run it on
+    */
+    void SetDetectorOptions(const DetectorOptions& options);
+
+    /** Sets whether Tesseract is restricted to the words and characters of the database
+        When constrained (the default), Tesseract prefers the words of item names, paints and
+        certifications and only considers characters that occur in them, which is faster and reads
+        more names correctly on the first try. Changing this restarts the text recognition engine
+        @param constrained - Whether to restrict recognition to the database's vocabulary
+    */
+    void SetConstrainedOcr(bool constrained);
+
+    /** Sets whether Tesseract reads the single channel version of the image or color crops of it
+        Gray (the default) converts the image once and gives Tesseract a third of the bytes; color
+        crops leave the conversion to Tesseract, as the classifier used to, so the two can be compared
+        @param grayscale - Whether to crop the text band and boxes from the gray image
+    */
+    void SetGrayscaleOcr(bool grayscale);
+
+    /** Releases the last image and its text-detections
+        The classifier otherwise keeps the last image (which may be a full screenshot) for
+        RenderTextDetections() until the next one replaces it
+    */
+    void ReleaseLastImage();
+
+    /** Shuts down the text detection network and the text recognition engine
+        Both are loaded again the next time they are needed. Long-running processes call this
+        to return memory the engines have accumulated
+    */
+    void ReleaseEngines();
+
     /** Extracts text from boxes detected by DetectText()
         @return A vector of each word extracted from the detected image
     */
@@ -37,35 +188,121 @@ class ItemClassifier {
     */
     std::string MatchTextToItemName(const std::vector<std::string>& words);
 
+    /** Matches extracted text to the item name with the fewest differing characters
+        Unlike MatchTextToItemName(), this tolerates misread characters (ex. Animus GR for Animus GP),
+        but it compares against every item so it is much slower
+        @param words - The words of the name AFTER color and certifications have been extracted, in any order
+        @param similarity - Set to how alike the words and the returned name are, from 0 to 1
+        @return The closest name if it is at least 75% similar, otherwise an empty string
+    */
+    std::string MatchClosestItemName(const std::vector<std::string>& words,
+                                     float& similarity);
+
 	  /** Extracts item paint color from extracted text
         @param extracted - The vector of words extracted by ExtractText()
         @return The color of the item if it is painted or Default if it isn't
     */
     std::string ExtractColor(std::vector<std::string>& extracted);
 
+	  /** Detects item paint color from the paint label on the image passed to DetectText()
+        Falls back to ExtractColor() when no paint label could be found in the image.
+        Paint words are always removed from extracted so that the name can be matched
+        @param extracted - The vector of words extracted by ExtractText()
+        @return The color of the item if it is painted or Default if it isn't
+    */
+    std::string DetectColor(std::vector<std::string>& extracted);
+
 	  /** Extracts item certifications from extracted text
         @param extracted - The vector of words extracted by ExtractText()
         @return The base certification of the item if it's certified or an empty string otherwise
     */
     std::string ExtractCertification(std::vector<std::string>& extracted);
 
+	  /** Returns the size the last image was resized to before being passed through the network
+        The size follows the image's own size, rounded to a multiple of 32 and capped for large screenshots
+        @return The network input size used by the last call to DetectText()
+    */
+    cv::Size GetInputSize() const;
+
 	  // Draws the base image with rendered text-detections
     void RenderTextDetections() const;
 
+	  /** Queues a copy of the last image with its text-detections to be drawn and written
+        Each box is labeled with the text ExtractText() read from it and the detection confidence.
+        The boxes are drawn and the image is written on the writer's background thread, so this
+        only copies the image and never blocks on drawing, the disk or a window
+        @param writer - The DetectionWriter that writes the annotated image
+        @param file_name - The name of the annotated image within the writer's folder ex. item1.png
+    */
+    void RenderTextDetections(DetectionWriter& writer,
+                              const std::string& file_name) const;
+
    private:
     std::string path_to_model_; // The path to the model used to detect text
+    DetectorOptions detector_options_; // The architecture of the model at path_to_model_ and where to run it
+    std::unique_ptr<TextDetector> detector_; // Detects text boxes with the model at path_to_model_, created on first use
     cv::Mat image_; // The raw image created in DetectText()
+    cv::Mat gray_; // The single channel version of image_ that Tesseract reads, made on first use
     ItemDatabase database_;  // The database used to match extracted text with an item
+    std::unique_ptr<tesseract::TessBaseAPI> ocr_; // The text recognition engine, initialized on first use
+    std::string path_to_ocr_config_; // The Tesseract config written by OcrVocabulary, or empty if it could not be written
+    bool constrain_ocr_ = true; // Whether ocr_ is initialized with path_to_ocr_config_
+    bool grayscale_ocr_ = true; // Whether Tesseract reads crops of gray_ rather than of image_
+    PaintDetector paint_detector_;  // Detects paint from the pixels of image_
+    cv::Size input_size_; // The size image_ was resized to for the network in DetectText()
     std::vector<cv::RotatedRect> boxes_;  // The text-boxes populated by DetectText()
     std::vector<int> indices_;  // The indices of bounding boxes populated by DetectText()
+    std::vector<float> confidences_;  // The confidence of each box in boxes_
+    std::vector<std::string> recognized_;  // The text ExtractText() read from each box in indices_
+    ClassificationCache* cache_ = nullptr;  // Answers Classify() for images seen before, or nullptr
+    VisualIndex* visual_index_ = nullptr;  // Answers Classify() for tiles that look like ones seen before, or nullptr
+    float minimum_confidence_;  // Classify() escalates names less confident than this to slower steps
+
+    // An item name from the database, sanitized and split into words once
+    struct CatalogName {
+        std::string full_name; // The name as written in the database ex. Octane - MG-88
+        std::vector<std::string> words; // The sanitized words of the name ex. octane, mg88
+        int word_count; // The number of words counted by CountNumberOfWords()
+        std::string sorted_words; // The sanitized words sorted and joined with spaces, for MatchClosestItemName()
+    };
+    std::vector<CatalogName> catalog_names_; // Every item name in database_
 
-	  // Decode the positions and orientations of the text boxes
-    // Ref:
-    // https://github.com/spmallick/learnopencv/blob/master/TextDetectionEAST/textDetection.cpp
-    void Decode(const cv::Mat& scores, const cv::Mat& geometry,
-                float scoreThresh, std::vector<cv::RotatedRect>& detections,
-                std::vector<float>& confidences);
+    struct PendingTile; // An image part way through ClassifyBatch(), defined in ItemClassifier.cpp
 
+    bool LoadImage(const cv::Mat& image); // Keeps a 3 channel version of image as image_ and clears the last detections
+    const cv::Mat& GetGrayImage(); // Returns the single channel version of image_, converting it on first use
+    const cv::Mat& GetOcrImage(); // Returns the image Tesseract's regions are cropped from: gray_, or image_ if SetGrayscaleOcr(false)
+    void DetectTextInImage(); // Runs the network on image_ to detect its text boxes
+    void DetectTextInTiles(std::vector<PendingTile>& tiles); // Detects the text boxes of every tile, passing tiles of the same input size through the network together
+    std::vector<ClassificationResult> ClassifyImages(const std::vector<cv::Mat>& images,
+                                                     std::vector<TokenRecord>* records,
+                                                     bool use_cache); // Runs the full pipeline on several images, looking each up in the cache by its pixels only if use_cache
+    bool StartClassification(const cv::Mat& image, PendingTile& tile,
+                             ClassificationResult& result); // Runs the steps that need no network; returns false if the tile still needs its text detected
+    ClassificationResult FinishClassification(PendingTile& tile); // Reads a tile's detected boxes and matches its words to the closest item name
+    void ConsiderWords(RecordedStep step, const std::vector<std::string>& words,
+                       const std::vector<float>& confidences, const std::vector<cv::Rect>& regions,
+                       PendingTile& tile); // Classifies the words one step read and keeps them if they beat the steps before
+    void MatchClosestWords(PendingTile& tile); // Tolerates misread characters in the most confident words if no step was confident enough
+    void RememberResult(const PendingTile& tile, const ClassificationResult& result); // Adds a result to the cache and, if it is confident, to the visual index
+    tesseract::TessBaseAPI& GetOcr(); // Returns the text recognition engine, initializing it on first use
+    void RecognizeWords(const cv::Mat& region, int page_segmentation_mode,
+                        std::vector<std::string>& words, std::vector<float>& confidences); // Reads every word in a region with its confidence from 0 to 1
+    void ReadTextBand(std::vector<std::string>& words, std::vector<float>& confidences,
+                      std::vector<cv::Rect>& regions); // Reads the fixed text band of a tile without text boxes, with the region of each word
+    std::vector<std::string> ReadTextBoxes(bool enhance, std::vector<float>& confidences,
+                                           std::vector<cv::Rect>& regions); // Reads each detected box, optionally enlarged and binarized first, with the box of each word
+    cv::Mat EnhanceForOcr(const cv::Mat& region) const; // Enlarges and binarizes a region into dark text on a light background
+    ClassificationResult ResolveTokens(const ClassifiedTokens& tokens, const std::string& label_paint,
+                                       float label_confidence); // Matches classified words to an item, preferring the paint label read from pixels
+    std::string MatchNormalizedWords(const std::vector<std::string>& normalized_words); // Matches words already normalized by NormalizeToken() to a real item
+    std::string MatchClosestNormalizedWords(const std::vector<std::string>& normalized_words,
+                                            float& similarity); // Matches normalized words to the item name with the fewest differing characters
+    std::string PreferDetectedPaint(const std::string& ocr_paint); // Returns the paint read from image_'s paint label, or ocr_paint if there is no label
+    void ForgetDetections(); // Clears the image and detections left by the last call to DetectText()
+    std::vector<DetectionAnnotation> DescribeTextDetections() const; // Returns the detected boxes in image_'s pixels, labeled with their text and confidence
+    cv::Size ComputeInputSize(const cv::Size& image_size) const; // Computes the network input size for an image
+    cv::Mat DecodeImage(const unsigned char* encoded_image, size_t size) const; // Decodes an encoded image held in memory, or returns an empty Mat
 	  cv::Rect AddPadding(cv::Mat input_image, cv::Rect cropped_box, int padding); // Adds padding to text detections
     void Sanitize(std::string& word_or_item);  // Sanitizes words for better matching
     int CountNumberOfWords(const std::string& sanitized_string); // Counts the number of words in a sanitized string
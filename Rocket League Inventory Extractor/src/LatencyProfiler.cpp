@@ -0,0 +1,223 @@
+/* Rocket League Classification Latency Profiler
+by Ridas Jagelavicius
+*/
+
+#include <cmath>
+#include <cstdlib>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+
+#include "LatencyProfiler.h"
+#include "MemoryUsage.h"
+
+// The names of each stage, in the same order as PipelineStage
+const char* const STAGE_NAMES[] = {
+    "LoadNetwork", "ReadImage", "Preprocess",  "Forward",     "Decode",
+    "NonMaxSuppression", "InitOcr", "RecognizeLayout", "RecognizeBox", "DetectPaint",
+    "MatchName", "MatchClosestName", "CacheLookup", "VisualLookup"};
+static_assert(sizeof(STAGE_NAMES) / sizeof(STAGE_NAMES[0]) ==
+                  static_cast<size_t>(PipelineStage::Count),
+              "Every pipeline stage needs a name");
+
+// Where ReportAtExit() writes the report
+static std::string path_to_exit_report;
+
+constexpr double BYTES_PER_MEGABYTE = 1024.0 * 1024.0;  // Report() shows memory in megabytes
+
+// Default constructor - creates an empty histogram for every stage
+LatencyProfiler::LatencyProfiler() : tracking_memory_(false) {
+    Reset();
+}
+
+// Returns the profiler that ItemClassifier records every stage to
+LatencyProfiler& LatencyProfiler::Global() {
+    static LatencyProfiler profiler;
+    return profiler;
+}
+
+// Records how long a single run of a stage took
+void LatencyProfiler::Record(PipelineStage stage, double microseconds) {
+    Histogram& histogram = histograms_[static_cast<int>(stage)];
+    histogram.buckets[GetBucket(microseconds)].fetch_add(1, std::memory_order_relaxed);
+    histogram.count.fetch_add(1, std::memory_order_relaxed);
+    histogram.total_nanoseconds.fetch_add(
+        static_cast<uint64_t>(microseconds * 1000), std::memory_order_relaxed);
+}
+
+// Returns a percentile of a stage's latency
+double LatencyProfiler::GetPercentile(PipelineStage stage,
+                                      double percentile) const {
+    const Histogram& histogram = histograms_[static_cast<int>(stage)];
+    uint64_t count = histogram.count.load(std::memory_order_relaxed);
+    if (count == 0) return 0;
+
+    // The rank of the sample the percentile falls on
+    uint64_t rank = static_cast<uint64_t>(std::ceil(percentile / 100.0 * count));
+    if (rank == 0) rank = 1;
+
+    uint64_t seen = 0;
+    for (int bucket = 0; bucket < BUCKET_COUNT; ++bucket) {
+        seen += histogram.buckets[bucket].load(std::memory_order_relaxed);
+        if (seen >= rank) return GetBucketUpperBound(bucket);
+    }
+    return GetBucketUpperBound(BUCKET_COUNT - 1);
+}
+
+// Returns the mean latency of a stage
+double LatencyProfiler::GetMean(PipelineStage stage) const {
+    const Histogram& histogram = histograms_[static_cast<int>(stage)];
+    uint64_t count = histogram.count.load(std::memory_order_relaxed);
+    if (count == 0) return 0;
+    return histogram.total_nanoseconds.load(std::memory_order_relaxed) / 1000.0 /
+           count;
+}
+
+// Returns how many times a stage was recorded
+uint64_t LatencyProfiler::GetCount(PipelineStage stage) const {
+    return histograms_[static_cast<int>(stage)].count.load(
+        std::memory_order_relaxed);
+}
+
+// Sets whether ScopedStageTimer also records resident memory around each stage
+void LatencyProfiler::SetMemoryTracking(bool enabled) {
+    tracking_memory_.store(enabled, std::memory_order_relaxed);
+}
+
+// Returns whether ScopedStageTimer records memory
+bool LatencyProfiler::IsTrackingMemory() const {
+    return tracking_memory_.load(std::memory_order_relaxed);
+}
+
+// Records the resident memory of the process after a single run of a stage
+void LatencyProfiler::RecordMemory(PipelineStage stage, size_t resident_bytes,
+                                   int64_t growth_bytes) {
+    Histogram& histogram = histograms_[static_cast<int>(stage)];
+    histogram.growth_bytes.fetch_add(growth_bytes, std::memory_order_relaxed);
+
+    // Raise the peak unless another thread has already raised it further
+    uint64_t peak = histogram.peak_resident_bytes.load(std::memory_order_relaxed);
+    while (resident_bytes > peak &&
+           !histogram.peak_resident_bytes.compare_exchange_weak(
+               peak, resident_bytes, std::memory_order_relaxed)) {
+    }
+}
+
+// Returns the most resident memory seen after a stage
+size_t LatencyProfiler::GetPeakResidentBytes(PipelineStage stage) const {
+    return static_cast<size_t>(histograms_[static_cast<int>(stage)]
+                                   .peak_resident_bytes.load(std::memory_order_relaxed));
+}
+
+// Returns how much a stage has grown the resident memory across every recorded run
+int64_t LatencyProfiler::GetMemoryGrowth(PipelineStage stage) const {
+    return histograms_[static_cast<int>(stage)].growth_bytes.load(
+        std::memory_order_relaxed);
+}
+
+// Returns a table of the count, p50, p95, p99 and mean latency of every recorded stage
+std::string LatencyProfiler::Report() const {
+    std::stringstream output;
+    output << std::left << std::setw(20) << "Stage" << std::right
+           << std::setw(10) << "Count" << std::setw(12) << "p50 (ms)"
+           << std::setw(12) << "p95 (ms)" << std::setw(12) << "p99 (ms)"
+           << std::setw(12) << "Mean (ms)";
+    if (IsTrackingMemory())
+        output << std::setw(12) << "Peak (MB)" << std::setw(14) << "Growth (MB)";
+    output << std::endl;
+
+    output << std::fixed << std::setprecision(3);
+    for (int i = 0; i < static_cast<int>(PipelineStage::Count); ++i) {
+        PipelineStage stage = static_cast<PipelineStage>(i);
+        if (GetCount(stage) == 0) continue;
+
+        output << std::left << std::setw(20) << GetStageName(stage)
+               << std::right << std::setw(10) << GetCount(stage)
+               << std::setw(12) << GetPercentile(stage, 50) / 1000
+               << std::setw(12) << GetPercentile(stage, 95) / 1000
+               << std::setw(12) << GetPercentile(stage, 99) / 1000
+               << std::setw(12) << GetMean(stage) / 1000;
+        if (IsTrackingMemory())
+            output << std::setw(12) << GetPeakResidentBytes(stage) / BYTES_PER_MEGABYTE
+                   << std::setw(14) << GetMemoryGrowth(stage) / BYTES_PER_MEGABYTE;
+        output << std::endl;
+    }
+    return output.str();
+}
+
+// Clears every histogram
+void LatencyProfiler::Reset() {
+    for (Histogram& histogram : histograms_) {
+        for (std::atomic<uint64_t>& bucket : histogram.buckets) bucket = 0;
+        histogram.count = 0;
+        histogram.total_nanoseconds = 0;
+        histogram.peak_resident_bytes = 0;
+        histogram.growth_bytes = 0;
+    }
+}
+
+// Writes the Report() of the global profiler when the process exits
+void LatencyProfiler::ReportAtExit(const std::string& path_to_report) {
+    static bool registered = false;
+    path_to_exit_report = path_to_report;
+
+    // Construct the global profiler first so it outlives the exit handler
+    Global();
+
+    if (!registered) {
+        registered = true;
+        std::atexit([] {
+            std::string report = LatencyProfiler::Global().Report();
+            if (path_to_exit_report.empty()) {
+                std::cout << report;
+            } else {
+                std::ofstream output(path_to_exit_report);
+                output << report;
+            }
+        });
+    }
+}
+
+// Returns the printable name of a stage
+std::string LatencyProfiler::GetStageName(PipelineStage stage) {
+    return STAGE_NAMES[static_cast<int>(stage)];
+}
+
+// Returns the bucket a latency falls in
+int LatencyProfiler::GetBucket(double microseconds) {
+    if (microseconds <= 1) return 0;
+
+    int bucket = static_cast<int>(std::ceil(std::log2(microseconds) * BUCKETS_PER_DOUBLING));
+    if (bucket >= BUCKET_COUNT) return BUCKET_COUNT - 1;
+    return bucket;
+}
+
+// Returns the largest latency in a bucket
+double LatencyProfiler::GetBucketUpperBound(int bucket) {
+    return std::exp2(static_cast<double>(bucket) / BUCKETS_PER_DOUBLING);
+}
+
+// Starts timing a stage
+ScopedStageTimer::ScopedStageTimer(PipelineStage stage)
+    : stage_(stage),
+      start_(std::chrono::steady_clock::now()),
+      start_resident_bytes_(LatencyProfiler::Global().IsTrackingMemory()
+                                ? GetResidentBytes()
+                                : 0) {
+    /* Nothing */ }
+
+// Stops timing and records the stage
+ScopedStageTimer::~ScopedStageTimer() {
+    std::chrono::duration<double, std::micro> elapsed =
+        std::chrono::steady_clock::now() - start_;
+    LatencyProfiler::Global().Record(stage_, elapsed.count());
+
+    // Only stages that started with tracking on have a starting point to compare to
+    if (start_resident_bytes_ != 0) {
+        size_t resident_bytes = GetResidentBytes();
+        LatencyProfiler::Global().RecordMemory(
+            stage_, resident_bytes,
+            static_cast<int64_t>(resident_bytes) - static_cast<int64_t>(start_resident_bytes_));
+    }
+}
@@ -0,0 +1,160 @@
+#pragma once
+
+/* Rocket League Classification Latency Profiler
+by Ridas Jagelavicius
+*/
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <string>
+
+// The stages of the classification pipeline that are timed
+enum class PipelineStage {
+    LoadNetwork,        // cv::dnn::readNet
+    ReadImage,          // cv::imread / cv::imdecode
+    Preprocess,         // cv::dnn::blobFromImage
+    Forward,            // The network's forward pass
+    Decode,             // Decoding the network output into text boxes
+    NonMaxSuppression,  // cv::dnn::NMSBoxes
+    InitOcr,            // Creating and initializing Tesseract
+    RecognizeLayout,    // Running Tesseract on the fixed text band of a tile, without text boxes
+    RecognizeBox,       // Running Tesseract on a single text box
+    DetectPaint,        // Detecting paint from the pixels of the image
+    MatchName,          // ItemClassifier::MatchTextToItemName
+    MatchClosestName,   // ItemClassifier::MatchClosestItemName
+    CacheLookup,        // Hashing an image and looking it up in a ClassificationCache
+    VisualLookup,       // Computing a tile's signature and looking it up in a VisualIndex
+    Count               // The number of stages, not a stage itself
+};
+
+class LatencyProfiler {
+   public:
+    // Default constructor - creates an empty histogram for every stage
+    LatencyProfiler();
+
+    /** Returns the profiler that ItemClassifier records every stage to
+        @return The process-wide profiler
+    */
+    static LatencyProfiler& Global();
+
+    /** Records how long a single run of a stage took
+        Recording is lock-free and may be called from several threads at once
+        @param stage - The stage that was timed
+        @param microseconds - How long the stage took in microseconds
+    */
+    void Record(PipelineStage stage, double microseconds);
+
+    /** Returns a percentile of a stage's latency
+        Latencies are grouped into logarithmic buckets, so the result is the upper edge of
+        the bucket the percentile falls in and is accurate to within about 20%
+        @param stage - The stage to query
+        @param percentile - The percentile to return between 0 and 100 ex. 95
+        @return The latency in microseconds, or 0 if the stage was never recorded
+    */
+    double GetPercentile(PipelineStage stage, double percentile) const;
+
+    /** Returns the mean latency of a stage
+        @param stage - The stage to query
+        @return The mean latency in microseconds, or 0 if the stage was never recorded
+    */
+    double GetMean(PipelineStage stage) const;
+
+    /** Returns how many times a stage was recorded
+        @param stage - The stage to query
+        @return The number of recorded runs of the stage
+    */
+    uint64_t GetCount(PipelineStage stage) const;
+
+    /** Sets whether ScopedStageTimer also records the process's resident memory around each stage
+        Reading the resident memory costs a few microseconds per stage, so it is off by default
+        @param enabled - Whether to record memory
+    */
+    void SetMemoryTracking(bool enabled);
+
+    /** Returns whether ScopedStageTimer records memory
+        @return Whether memory tracking is enabled
+    */
+    bool IsTrackingMemory() const;
+
+    /** Records the resident memory of the process after a single run of a stage
+        Recording is lock-free and may be called from several threads at once
+        @param stage - The stage that ran
+        @param resident_bytes - The resident memory once the stage finished, from GetResidentBytes()
+        @param growth_bytes - How much the resident memory changed while the stage ran
+    */
+    void RecordMemory(PipelineStage stage, size_t resident_bytes, int64_t growth_bytes);
+
+    /** Returns the most resident memory seen after a stage
+        @param stage - The stage to query
+        @return The peak resident memory in bytes, or 0 if memory was never recorded for the stage
+    */
+    size_t GetPeakResidentBytes(PipelineStage stage) const;
+
+    /** Returns how much a stage has grown the resident memory across every recorded run
+        A stage whose growth keeps rising over a long run is holding on to memory
+        @param stage - The stage to query
+        @return The total change in resident memory in bytes, which is negative if the stage freed memory
+    */
+    int64_t GetMemoryGrowth(PipelineStage stage) const;
+
+    /** Returns a table of the count, p50, p95, p99 and mean latency of every recorded stage
+        When memory is tracked, the peak resident memory and total growth of each stage are added
+        @return A formatted table with one row per stage, in milliseconds (and megabytes)
+    */
+    std::string Report() const;
+
+    // Clears every histogram and the recorded memory
+    void Reset();
+
+    /** Writes the Report() of the global profiler when the process exits
+        @param path_to_report - The file to write the report to, or an empty string for standard output
+    */
+    static void ReportAtExit(const std::string& path_to_report);
+
+    /** Returns the printable name of a stage
+        @param stage - The stage to name
+        @return The name of the stage ex. Forward
+    */
+    static std::string GetStageName(PipelineStage stage);
+
+   private:
+    static constexpr int BUCKETS_PER_DOUBLING = 4;  // Sub-buckets between each power of two
+    static constexpr int BUCKET_COUNT = 34 * BUCKETS_PER_DOUBLING;  // Covers 1 microsecond to ~4.7 hours
+
+    // The latency histogram of a single stage
+    struct Histogram {
+        std::array<std::atomic<uint64_t>, BUCKET_COUNT> buckets;
+        std::atomic<uint64_t> count;
+        std::atomic<uint64_t> total_nanoseconds;
+        std::atomic<uint64_t> peak_resident_bytes;
+        std::atomic<int64_t> growth_bytes;
+    };
+
+    std::array<Histogram, static_cast<int>(PipelineStage::Count)> histograms_;
+    std::atomic<bool> tracking_memory_; // Whether ScopedStageTimer records memory
+
+    static int GetBucket(double microseconds); // Returns the bucket a latency falls in
+    static double GetBucketUpperBound(int bucket); // Returns the largest latency in a bucket
+};
+
+// Times the enclosing scope and records it to the global LatencyProfiler when destroyed
+class ScopedStageTimer {
+   public:
+    /** Starts timing a stage
+        @param stage - The stage being timed
+    */
+    explicit ScopedStageTimer(PipelineStage stage);
+
+    // Stops timing and records the stage
+    ~ScopedStageTimer();
+
+    ScopedStageTimer(const ScopedStageTimer&) = delete;
+    ScopedStageTimer& operator=(const ScopedStageTimer&) = delete;
+
+   private:
+    PipelineStage stage_; // The stage being timed
+    std::chrono::steady_clock::time_point start_; // When timing started
+    size_t start_resident_bytes_; // The resident memory when timing started, or 0 if memory is not tracked
+};
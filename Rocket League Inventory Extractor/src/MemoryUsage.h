@@ -0,0 +1,13 @@
+#pragma once
+
+/* Rocket League Process Memory Usage
+by Ridas Jagelavicius
+*/
+
+#include <cstddef>
+
+/** Returns how much physical memory the process is using (its resident set or working set)
+    Reads /proc/self/statm on Linux, the task info on macOS and the working set on Windows
+    @return The resident memory in bytes, or 0 on platforms where it cannot be read
+*/
+size_t GetResidentBytes();
@@ -0,0 +1,150 @@
+/* Rocket League OCR Vocabulary
+by Ridas Jagelavicius
+*/
+
+#include <algorithm>
+#include <cctype>
+#include <chrono>
+#include <filesystem>
+#include <fstream>
+#include <functional>
+#include <set>
+#include <sstream>
+#include <thread>
+
+#include "OcrVocabulary.h"
+#include "TokenClassifier.h"
+
+constexpr char DIGITS[] = "0123456789";  // Always whitelisted, since patterns accept any digit
+
+// Custom constructor - collects every word that can appear on an item tile
+OcrVocabulary::OcrVocabulary(const std::vector<std::string>& item_names) {
+    for (const std::string& name : item_names) AddWords(name, false);
+
+    // Paint labels are written in capitals
+    for (const std::string& trait : GetTraitNames()) AddWords(trait, true);
+
+    std::sort(words_.begin(), words_.end());
+    words_.erase(std::unique(words_.begin(), words_.end()), words_.end());
+
+    std::set<std::string> patterns;
+    std::set<std::string> characters;
+    for (const std::string& word : words_) {
+        std::string pattern;
+        bool has_digit = false;
+
+        for (size_t i = 0; i < word.size(); ++i) {
+            unsigned char letter = static_cast<unsigned char>(word[i]);
+
+            // A character outside ASCII is kept whole, lead byte and continuation bytes
+            size_t length = 1;
+            if (letter >= 0x80)
+                while (i + length < word.size() &&
+                       (static_cast<unsigned char>(word[i + length]) & 0xC0) == 0x80)
+                    length++;
+            characters.insert(word.substr(i, length));
+
+            if (std::isdigit(letter)) {
+                pattern += "\\d";
+                has_digit = true;
+            } else if (letter == '\\') {
+                pattern += "\\\\";
+            } else {
+                pattern += word.substr(i, length);
+            }
+            i += length - 1;
+        }
+        if (has_digit) patterns.insert(pattern);
+    }
+
+    patterns_.assign(patterns.begin(), patterns.end());
+    for (const char* digit = DIGITS; *digit != '\0'; ++digit)
+        characters.insert(std::string(1, *digit));
+    for (const std::string& character : characters) whitelist_ += character;
+}
+
+// Returns every word that can appear on a tile
+const std::vector<std::string>& OcrVocabulary::GetWords() const {
+    return words_;
+}
+
+// Returns a pattern for every word with digits in it
+const std::vector<std::string>& OcrVocabulary::GetPatterns() const {
+    return patterns_;
+}
+
+// Returns every character used by the words, plus the digits
+const std::string& OcrVocabulary::GetWhitelist() const {
+    return whitelist_;
+}
+
+// Writes the words, patterns and a config file that loads them both and sets the whitelist
+std::string OcrVocabulary::WriteTesseractConfig(const std::string& directory) const {
+    std::string contents;
+    for (const std::string& word : words_) contents += word + '\n';
+    for (const std::string& pattern : patterns_) contents += pattern + '\n';
+    contents += whitelist_;
+
+    std::ostringstream name;
+    name << "rl-ocr-" << std::hex << std::hash<std::string>()(contents);
+    std::string base = (std::filesystem::path(directory) / name.str()).string();
+    std::string path_to_words = base + ".user-words";
+    std::string path_to_patterns = base + ".user-patterns";
+    std::string path_to_config = base + ".config";
+
+    // Tesseract reads the rest of each config line as the value, so paths may contain spaces
+    std::vector<std::string> config = {"user_words_file " + path_to_words,
+                                       "user_patterns_file " + path_to_patterns,
+                                       "tessedit_char_whitelist " + whitelist_};
+    if (!WriteLines(path_to_words, words_) ||
+        !WriteLines(path_to_patterns, patterns_) ||
+        !WriteLines(path_to_config, config))
+        return "";
+    return path_to_config;
+}
+
+// Adds each word of text, and optionally an all capitals copy of it
+void OcrVocabulary::AddWords(const std::string& text, bool add_capitals) {
+    std::stringstream words(text);
+    std::string word;
+    while (words >> word) {
+        // Skip separators such as the - in Octane - MG-88
+        bool has_letter = std::any_of(word.begin(), word.end(), [](char letter) {
+            return std::isalnum(static_cast<unsigned char>(letter)) ||
+                   static_cast<unsigned char>(letter) >= 0x80;
+        });
+        if (!has_letter) continue;
+
+        words_.push_back(word);
+        if (add_capitals) {
+            std::transform(word.begin(), word.end(), word.begin(), [](char letter) {
+                return static_cast<char>(std::toupper(static_cast<unsigned char>(letter)));
+            });
+            words_.push_back(word);
+        }
+    }
+}
+
+// Writes one line per string to a new file, then moves it into place
+bool OcrVocabulary::WriteLines(const std::string& path_to_file,
+                               const std::vector<std::string>& lines) const {
+    // Another classifier may be reading or writing the same file, so it is replaced whole
+    std::ostringstream temporary;
+    temporary << path_to_file << '.' << std::hex
+              << std::hash<std::thread::id>()(std::this_thread::get_id())
+              << std::chrono::steady_clock::now().time_since_epoch().count() << ".tmp";
+    {
+        std::ofstream output(temporary.str());
+        if (!output) return false;
+        for (const std::string& line : lines) output << line << '\n';
+        if (!output) return false;
+    }
+
+    std::error_code error;
+    std::filesystem::rename(temporary.str(), path_to_file, error);
+    if (error) {
+        std::filesystem::remove(temporary.str(), error);
+        return std::filesystem::exists(path_to_file, error);
+    }
+    return true;
+}
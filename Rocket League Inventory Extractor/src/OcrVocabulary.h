@@ -0,0 +1,51 @@
+#pragma once
+
+/* Rocket League OCR Vocabulary
+by Ridas Jagelavicius
+*/
+
+#include <string>
+#include <vector>
+
+class OcrVocabulary {
+   public:
+    /** Custom constructor - collects every word that can appear on an item tile
+        The words of each item name are combined with every paint, certification and
+        modifier (in the case they are written on a tile and in capitals, as on paint labels)
+        @param item_names - The full name of every item ex. from ItemDatabase::GetAllNames()
+    */
+    explicit OcrVocabulary(const std::vector<std::string>& item_names);
+
+    /** Returns every word that can appear on a tile, sorted and without duplicates
+        Words made only of punctuation (ex. the - in Octane - MG-88) are left out
+        @return The words in the form Tesseract expects in a user words file
+    */
+    const std::vector<std::string>& GetWords() const;
+
+    /** Returns a pattern for every word with digits in it, with each digit replaced by \d
+        ex. MG-88 becomes MG-\d\d, so Tesseract also prefers codes it has not seen
+        @return The patterns in the form Tesseract expects in a user patterns file
+    */
+    const std::vector<std::string>& GetPatterns() const;
+
+    /** Returns every character used by the words, plus the digits
+        @return The characters as UTF-8, for tessedit_char_whitelist
+    */
+    const std::string& GetWhitelist() const;
+
+    /** Writes the words, patterns and a config file that loads them both and sets the whitelist
+        The file names include a hash of the vocabulary, so classifiers built from the same
+        database share the files and a changed database never reads stale ones
+        @param directory - The folder to write the files into, which must exist
+        @return The full path to the config file to pass to TessBaseAPI::Init(), or an empty string if a file could not be written
+    */
+    std::string WriteTesseractConfig(const std::string& directory) const;
+
+   private:
+    std::vector<std::string> words_; // Every word that can appear on a tile
+    std::vector<std::string> patterns_; // A pattern for every word with digits
+    std::string whitelist_; // Every character in words_ and the digits
+
+    void AddWords(const std::string& text, bool add_capitals); // Adds each word of text, and optionally an all capitals copy of it
+    bool WriteLines(const std::string& path_to_file, const std::vector<std::string>& lines) const; // Writes one line per string to a new file, then moves it into place
+};
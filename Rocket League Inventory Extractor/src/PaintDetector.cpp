@@ -0,0 +1,177 @@
+/* Rocket League Paint Detector
+by Ridas Jagelavicius
+*/
+
+#include <algorithm>
+#include <opencv2/imgproc.hpp>
+
+#include "PaintDetector.h"
+
+constexpr float BAND_TOP = 0.55f;  // The paint label lies between these fractions of the tile height
+constexpr float BAND_BOTTOM = 0.82f;
+constexpr float MAX_PAINT_DISTANCE = 16.0f;  // How far (in 8-bit Lab) a pixel may be from a paint and still match it
+constexpr float MIN_LABEL_WIDTH = 0.2f;  // Label width bounds as fractions of the tile width
+constexpr float MAX_LABEL_WIDTH = 0.9f;
+constexpr float MIN_LABEL_HEIGHT = 0.05f;  // Label height bounds as fractions of the tile height
+constexpr float MAX_LABEL_HEIGHT = 0.15f;
+constexpr float MAX_LABEL_OFFSET = 0.12f;  // How far from the tile center the label may be, as a fraction of the tile width
+constexpr float MIN_LABEL_FILL = 0.75f;  // The fraction of the label's bounding box that must be its paint
+
+// The color of each paint label, measured from in-game screenshots
+struct PaintReference {
+    const char* name;
+    unsigned char red, green, blue;
+};
+
+constexpr PaintReference PAINT_REFERENCES[] = {
+    {"Black", 24, 27, 30},     {"White", 235, 235, 235},
+    {"Grey", 120, 120, 120},   {"Crimson", 168, 23, 28},
+    {"Pink", 214, 72, 170},    {"Cobalt", 41, 71, 255},
+    {"Sky Blue", 80, 200, 240}, {"Burnt Sienna", 94, 36, 21},
+    {"Saffron", 174, 176, 10}, {"Lime", 140, 230, 20},
+    {"Forest Green", 21, 142, 35}, {"Orange", 240, 130, 20},
+    {"Purple", 140, 50, 200}};
+
+// Default constructor - converts the reference paint colors to Lab
+PaintDetector::PaintDetector() {
+    const int count = sizeof(PAINT_REFERENCES) / sizeof(PAINT_REFERENCES[0]);
+
+    cv::Mat bgr(1, count, CV_8UC3);
+    for (int i = 0; i < count; ++i) {
+        paints_.push_back(PAINT_REFERENCES[i].name);
+        label_colors_.push_back(cv::Scalar(PAINT_REFERENCES[i].blue,
+                                           PAINT_REFERENCES[i].green,
+                                           PAINT_REFERENCES[i].red));
+        bgr.at<cv::Vec3b>(0, i) =
+            cv::Vec3b(PAINT_REFERENCES[i].blue, PAINT_REFERENCES[i].green,
+                      PAINT_REFERENCES[i].red);
+    }
+
+    cv::Mat lab;
+    cv::cvtColor(bgr, lab, cv::COLOR_BGR2Lab);
+    for (int i = 0; i < count; ++i) {
+        const cv::Vec3b& color = lab.at<cv::Vec3b>(0, i);
+        references_.push_back(cv::Vec3f(color[0], color[1], color[2]));
+    }
+}
+
+// Detects the paint of an item from the colored paint label drawn on its tile
+std::string PaintDetector::DetectPaint(const cv::Mat& tile) const {
+    float confidence;
+    return DetectPaint(tile, confidence);
+}
+
+// Detects the paint of an item from its paint label and how solid the label was
+std::string PaintDetector::DetectPaint(const cv::Mat& tile, float& confidence) const {
+    confidence = 0;
+    if (tile.empty() || tile.channels() != 3) return "";
+
+    // Only the horizontal band that can contain the label is examined
+    int top = static_cast<int>(BAND_TOP * tile.rows);
+    int bottom = static_cast<int>(BAND_BOTTOM * tile.rows);
+    cv::Mat lab;
+    cv::cvtColor(tile.rowRange(top, bottom), lab, cv::COLOR_BGR2Lab);
+
+    // Label each pixel with its nearest paint, or -1 if it is not close to any
+    cv::Mat nearest(lab.rows, lab.cols, CV_8UC1);
+    std::vector<int> counts(paints_.size(), 0);
+    const float max_distance = MAX_PAINT_DISTANCE * MAX_PAINT_DISTANCE;
+
+    for (int y = 0; y < lab.rows; ++y) {
+        const cv::Vec3b* pixels = lab.ptr<cv::Vec3b>(y);
+        unsigned char* labels = nearest.ptr<unsigned char>(y);
+
+        for (int x = 0; x < lab.cols; ++x) {
+            float best_distance = max_distance;
+            int best_paint = -1;
+
+            for (size_t p = 0; p < references_.size(); ++p) {
+                float dl = pixels[x][0] - references_[p][0];
+                float da = pixels[x][1] - references_[p][1];
+                float db = pixels[x][2] - references_[p][2];
+                float distance = dl * dl + da * da + db * db;
+                if (distance < best_distance) {
+                    best_distance = distance;
+                    best_paint = static_cast<int>(p);
+                }
+            }
+
+            labels[x] = static_cast<unsigned char>(best_paint + 1);
+            if (best_paint >= 0) counts[best_paint]++;
+        }
+    }
+
+    // Look for the largest label-shaped region of a single paint
+    const int min_area = static_cast<int>(MIN_LABEL_WIDTH * tile.cols *
+                                          MIN_LABEL_HEIGHT * tile.rows *
+                                          MIN_LABEL_FILL);
+    cv::Mat close_kernel = cv::getStructuringElement(cv::MORPH_RECT, cv::Size(5, 5));
+    std::string best_paint;
+    int best_area = 0;
+
+    for (size_t p = 0; p < paints_.size(); ++p) {
+        if (counts[p] < min_area) continue;
+
+        // Closing fills the gaps left by the white text written on the label
+        cv::Mat mask;
+        cv::compare(nearest, static_cast<double>(p + 1), mask, cv::CMP_EQ);
+        cv::morphologyEx(mask, mask, cv::MORPH_CLOSE, close_kernel);
+
+        cv::Mat components, stats, centroids;
+        int count = cv::connectedComponentsWithStats(mask, components, stats, centroids);
+        for (int i = 1; i < count; ++i) {
+            cv::Rect region(stats.at<int>(i, cv::CC_STAT_LEFT),
+                            stats.at<int>(i, cv::CC_STAT_TOP),
+                            stats.at<int>(i, cv::CC_STAT_WIDTH),
+                            stats.at<int>(i, cv::CC_STAT_HEIGHT));
+            int area = stats.at<int>(i, cv::CC_STAT_AREA);
+
+            if (area > best_area &&
+                IsLabelShaped(region, area, tile.size(), mask.size())) {
+                best_area = area;
+                best_paint = paints_[p];
+                confidence = std::min(1.0f, static_cast<float>(area) / region.area());
+            }
+        }
+    }
+    return best_paint;
+}
+
+// Looks up the color of a paint's label
+bool PaintDetector::GetLabelColor(const std::string& paint,
+                                  cv::Scalar& color) const {
+    for (size_t p = 0; p < paints_.size(); ++p) {
+        if (paints_[p] == paint) {
+            color = label_colors_[p];
+            return true;
+        }
+    }
+    return false;
+}
+
+// Returns whether a connected region of one paint is shaped like a paint label
+bool PaintDetector::IsLabelShaped(const cv::Rect& region, int area,
+                                  const cv::Size& tile_size,
+                                  const cv::Size& band_size) const {
+    // Item art often continues past the band or the tile, but a label never does
+    if (region.x <= 0 || region.y <= 0 ||
+        region.x + region.width >= band_size.width ||
+        region.y + region.height >= band_size.height)
+        return false;
+
+    if (region.width < MIN_LABEL_WIDTH * tile_size.width ||
+        region.width > MAX_LABEL_WIDTH * tile_size.width)
+        return false;
+
+    if (region.height < MIN_LABEL_HEIGHT * tile_size.height ||
+        region.height > MAX_LABEL_HEIGHT * tile_size.height)
+        return false;
+
+    // Labels are centered horizontally
+    float center = region.x + region.width / 2.0f;
+    if (std::abs(center - tile_size.width / 2.0f) >
+        MAX_LABEL_OFFSET * tile_size.width)
+        return false;
+
+    return area >= MIN_LABEL_FILL * region.area();
+}
@@ -0,0 +1,48 @@
+#pragma once
+
+/* Rocket League Paint Detector
+by Ridas Jagelavicius
+*/
+
+#include <string>
+#include <vector>
+#include <opencv2/opencv.hpp>
+
+class PaintDetector {
+   public:
+    // Default constructor - converts the reference paint colors to Lab
+    PaintDetector();
+
+    /** Detects the paint of an item from the colored paint label drawn on its tile
+        Painted items show a rounded label (ex. "COBALT") centered just above the item name.
+        The label is found by matching each pixel to the nearest known paint in Lab space
+        and looking for a solid, label-shaped region of a single paint.
+        @param tile - A BGR image of a single rocket league item
+        @return The paint of the item ex. Cobalt or Burnt Sienna, or an empty string if no paint label was found
+    */
+    std::string DetectPaint(const cv::Mat& tile) const;
+
+    /** Detects the paint of an item from its paint label and reports how solid the label was
+        @param tile - A BGR image of a single rocket league item
+        @param confidence - Set to the fraction of the label's bounding box covered by its paint,
+                            from 0 to 1, or 0 if no paint label was found
+        @return The paint of the item ex. Cobalt or Burnt Sienna, or an empty string if no paint label was found
+    */
+    std::string DetectPaint(const cv::Mat& tile, float& confidence) const;
+
+    /** Looks up the color of a paint's label
+        @param paint - The paint to look up ex. Cobalt
+        @param color - Set to the BGR color of the paint's label if the paint is known
+        @return Whether the paint is known
+    */
+    bool GetLabelColor(const std::string& paint, cv::Scalar& color) const;
+
+   private:
+    std::vector<std::string> paints_; // The name of every known paint
+    std::vector<cv::Vec3f> references_; // The Lab color of each paint label, in the same order as paints_
+    std::vector<cv::Scalar> label_colors_; // The BGR color of each paint label, in the same order as paints_
+
+    // Returns whether a connected region of one paint is shaped like a paint label
+    bool IsLabelShaped(const cv::Rect& region, int area, const cv::Size& tile_size,
+                       const cv::Size& band_size) const;
+};
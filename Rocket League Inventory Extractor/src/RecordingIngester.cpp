@@ -0,0 +1,139 @@
+/* Rocket League Inventory Recording Ingester
+by Ridas Jagelavicius
+*/
+
+#include <algorithm>
+#include <cmath>
+#include <iostream>
+#include <opencv2/imgproc.hpp>
+#include <opencv2/videoio.hpp>
+
+#include "RecordingIngester.h"
+
+constexpr int MAX_TILE_HASH_DISTANCE = 6;  // Tiles whose hashes differ by at most this many bits may be the same tile, if their colors and text also match
+constexpr double EMPTY_TILE_DEVIATION = 4.0;  // Tiles with less pixel deviation than this are empty slots
+
+// Custom constructor
+RecordingIngester::RecordingIngester(ItemClassifier& classifier,
+                                     const ItemDatabase& database,
+                                     const InventoryGrid& grid)
+    : classifier_(classifier),
+      database_(database),
+      grid_(grid),
+      scroll_offset_(0),
+      seen_tiles_(MAX_TILE_HASH_DISTANCE),
+      classified_tiles_(0) {
+    /* Nothing */ }
+
+// Reads a screen recording of a scrolling inventory and adds each item to an Inventory
+int RecordingIngester::Ingest(const std::string& path_to_recording,
+                              Inventory& inventory) {
+    // VideoCapture reads both video files and printf-style image sequences
+    cv::VideoCapture capture(path_to_recording);
+    if (!capture.isOpened()) {
+        std::cout << "Recording not found at provided path" << std::endl;
+        return -1;
+    }
+
+    scroll_offset_ = 0;
+    previous_grid_.release();
+    read_slots_.clear();
+
+    int frames = 0;
+    cv::Mat frame;
+    while (capture.read(frame)) {
+        frames++;
+
+        // Skip frames that do not contain the whole grid
+        if ((grid_.region & cv::Rect(0, 0, frame.cols, frame.rows)) !=
+            grid_.region)
+            continue;
+
+        cv::Mat gray_grid;
+        cv::cvtColor(frame(grid_.region), gray_grid, cv::COLOR_BGR2GRAY);
+        TrackScroll(gray_grid);
+        ReadVisibleSlots(frame, inventory);
+    }
+    return frames;
+}
+
+// Returns the number of tiles that were sent to the ItemClassifier
+int RecordingIngester::GetClassifiedTileCount() const {
+    return classified_tiles_;
+}
+
+// Returns the number of grid slots that were added to the Inventory
+int RecordingIngester::GetSlotCount() const {
+    return static_cast<int>(read_slots_.size());
+}
+
+// Updates scroll_offset_ from the movement between two frames
+void RecordingIngester::TrackScroll(const cv::Mat& gray_grid) {
+    cv::Mat current;
+    gray_grid.convertTo(current, CV_32F);
+
+    if (!previous_grid_.empty()) {
+        // Phase correlation finds the translation between the two frames.
+        // Scrolling down moves the grid contents up, so the shift is negative
+        cv::Point2d shift = cv::phaseCorrelate(previous_grid_, current);
+        scroll_offset_ -= shift.y;
+        if (scroll_offset_ < 0) scroll_offset_ = 0;
+    }
+    previous_grid_ = current;
+}
+
+// Adds every newly visible slot to the Inventory
+void RecordingIngester::ReadVisibleSlots(const cv::Mat& frame,
+                                         Inventory& inventory) {
+    const int row_pitch = grid_.cell_height + grid_.spacing_y;
+    const int column_pitch = grid_.cell_width + grid_.spacing_x;
+
+    // The first row whose top edge is fully on screen
+    int row = static_cast<int>(std::ceil(scroll_offset_ / row_pitch));
+    int y = static_cast<int>(std::lround(row * row_pitch - scroll_offset_));
+
+    for (; y + grid_.cell_height <= grid_.region.height; y += row_pitch, ++row) {
+        for (int column = 0; column < grid_.columns; ++column) {
+            int slot = row * grid_.columns + column;
+            if (read_slots_.count(slot)) continue;
+
+            cv::Rect cell(grid_.region.x + column * column_pitch,
+                          grid_.region.y + y, grid_.cell_width,
+                          grid_.cell_height);
+            if ((cell & grid_.region) != cell) continue;
+
+            // Empty slots are not marked as read, so a tile that is still being drawn is read in a later frame
+            cv::Mat tile = frame(cell);
+            cv::Scalar mean, deviation;
+            cv::meanStdDev(tile, mean, deviation);
+            double spread = 0;
+            for (int channel = 0; channel < tile.channels(); ++channel)
+                spread = std::max(spread, deviation[channel]);
+            if (spread < EMPTY_TILE_DEVIATION) continue;
+
+            read_slots_.insert(slot);
+
+            ClassificationResult result = ClassifyTile(tile);
+            if (result.name.empty()) continue;
+
+            std::string price = database_.GetPriceOf(result.name, result.paint);
+            InventoryItem item(result.name, result.certification, result.paint,
+                               price);
+            inventory.AddItem(item);
+        }
+    }
+}
+
+// Classifies a tile or returns the result of a matching tile
+ClassificationResult RecordingIngester::ClassifyTile(const cv::Mat& tile) {
+    // Identical items render identical tiles, so only classify new ones. The hashes alone
+    // cannot see paints or certifications, so a match must also share its colors and text band
+    TileSignature signature = VisualIndex::ComputeSignature(tile);
+    ClassificationResult result;
+    if (seen_tiles_.Lookup(signature, result)) return result;
+
+    classified_tiles_++;
+    result = classifier_.Classify(tile);
+    seen_tiles_.Add(signature, result);
+    return result;
+}
@@ -0,0 +1,70 @@
+#pragma once
+
+/* Rocket League Inventory Recording Ingester
+by Ridas Jagelavicius
+*/
+
+#include <string>
+#include <vector>
+#include <unordered_set>
+#include <opencv2/opencv.hpp>
+
+#include "Inventory.h"
+#include "ItemClassifier.h"
+#include "ItemDatabase.h"
+#include "VisualIndex.h"
+
+// Describes where the inventory grid sits in each frame of a recording
+struct InventoryGrid {
+    cv::Rect region; // The area of the frame that contains the scrolling item grid
+    int columns; // The number of item tiles in each row of the grid
+    int cell_width; // The width of a single item tile in pixels
+    int cell_height; // The height of a single item tile in pixels
+    int spacing_x; // The horizontal gap between two tiles in pixels
+    int spacing_y; // The vertical gap between two rows of tiles in pixels
+};
+
+class RecordingIngester {
+   public:
+    /** Custom constructor
+        @param classifier - The ItemClassifier used to classify tiles that have not been seen before
+        @param database - The ItemDatabase used to price classified items
+        @param grid - The position and dimensions of the inventory grid in each frame
+    */
+    RecordingIngester(ItemClassifier& classifier, const ItemDatabase& database,
+                      const InventoryGrid& grid);
+
+    /** Reads a screen recording of a scrolling inventory and adds each item to an Inventory
+        Every grid slot is added exactly once, and tiles that look like a tile that has
+        already been classified, down to its colors and text, reuse that result instead of
+        running text detection again
+        @param path_to_recording - A video file or an image sequence pattern ex. frames/%04d.png
+        @param inventory - The Inventory that classified items are added to
+        @return The number of frames read, or -1 if the recording could not be opened
+    */
+    int Ingest(const std::string& path_to_recording, Inventory& inventory);
+
+    /** Returns the number of tiles that were sent to the ItemClassifier
+        @return The number of visually unique tiles classified so far
+    */
+    int GetClassifiedTileCount() const;
+
+    /** Returns the number of grid slots that were added to the Inventory
+        @return The number of slots read so far, including ones that reused a previous classification
+    */
+    int GetSlotCount() const;
+
+   private:
+    ItemClassifier& classifier_; // Classifies tiles that have not been seen before
+    const ItemDatabase& database_; // Prices classified items
+    InventoryGrid grid_; // The layout of the inventory grid
+    double scroll_offset_; // How far the grid has scrolled since the first frame in pixels
+    cv::Mat previous_grid_; // The grayscale grid region of the previous frame
+    std::unordered_set<int> read_slots_; // Indices of grid slots already added to the Inventory
+    VisualIndex seen_tiles_; // Every distinct tile classified so far
+    int classified_tiles_; // The number of calls made to the ItemClassifier
+
+    void TrackScroll(const cv::Mat& gray_grid); // Updates scroll_offset_ from the movement between two frames
+    void ReadVisibleSlots(const cv::Mat& frame, Inventory& inventory); // Adds every newly visible slot to the Inventory
+    ClassificationResult ClassifyTile(const cv::Mat& tile); // Classifies a tile or returns the result of a matching tile
+};
@@ -0,0 +1,98 @@
+/* Rocket League Classification Result Formats
+by Ridas Jagelavicius
+*/
+
+#include <cstdio>
+
+#include "ResultFormat.h"
+
+constexpr char CSV_HEADER[] =
+    "path,name,paint,certification,price,name_confidence,paint_confidence,"
+    "certification_confidence,error";
+constexpr char READ_ERROR[] = "image could not be read";  // The error of an image that did not succeed
+
+// Writes a confidence with a fixed number of decimals, so every line looks alike
+static std::string FormatConfidence(float confidence) {
+    char text[16];
+    std::snprintf(text, sizeof(text), "%.4f", confidence);
+    return text;
+}
+
+// Quotes a string for JSON, escaping quotes, backslashes and control characters
+static std::string QuoteJsonString(const std::string& text) {
+    std::string quoted = "\"";
+    for (char letter : text) {
+        switch (letter) {
+            case '"': quoted += "\\\""; break;
+            case '\\': quoted += "\\\\"; break;
+            case '\n': quoted += "\\n"; break;
+            case '\r': quoted += "\\r"; break;
+            case '\t': quoted += "\\t"; break;
+            default:
+                if (static_cast<unsigned char>(letter) < 0x20) {
+                    char escaped[8];
+                    std::snprintf(escaped, sizeof(escaped), "\\u%04x", letter);
+                    quoted += escaped;
+                } else {
+                    quoted += letter;  // UTF-8 is written as it is
+                }
+        }
+    }
+    return quoted + "\"";
+}
+
+// Parses the name of an output format
+bool ParseOutputFormat(const std::string& name, OutputFormat& format) {
+    if (name == "jsonl" || name == "json") {
+        format = OutputFormat::JsonLines;
+        return true;
+    }
+    if (name == "csv") {
+        format = OutputFormat::Csv;
+        return true;
+    }
+    return false;
+}
+
+// Returns the line written before any result, if the format has one
+std::string FormatResultHeader(OutputFormat format) {
+    return format == OutputFormat::Csv ? std::string(CSV_HEADER) + "\n" : "";
+}
+
+// Formats one classified image as a single line
+std::string FormatResult(const ClassifiedImage& image, OutputFormat format) {
+    const ClassificationResult& result = image.result;
+    std::string error = image.succeeded ? "" : READ_ERROR;
+
+    // The fields are written in the same order in both formats
+    if (format == OutputFormat::Csv) {
+        return QuoteCsvField(image.path) + "," + QuoteCsvField(result.name) + "," +
+               QuoteCsvField(result.paint) + "," + QuoteCsvField(result.certification) + "," +
+               QuoteCsvField(image.price) + "," + FormatConfidence(result.name_confidence) +
+               "," + FormatConfidence(result.paint_confidence) + "," +
+               FormatConfidence(result.certification_confidence) + "," +
+               QuoteCsvField(error) + "\n";
+    }
+
+    return "{\"path\":" + QuoteJsonString(image.path) +
+           ",\"name\":" + QuoteJsonString(result.name) +
+           ",\"paint\":" + QuoteJsonString(result.paint) +
+           ",\"certification\":" + QuoteJsonString(result.certification) +
+           ",\"price\":" + QuoteJsonString(image.price) +
+           ",\"name_confidence\":" + FormatConfidence(result.name_confidence) +
+           ",\"paint_confidence\":" + FormatConfidence(result.paint_confidence) +
+           ",\"certification_confidence\":" + FormatConfidence(result.certification_confidence) +
+           ",\"error\":" + QuoteJsonString(error) + "}\n";
+}
+
+// Quotes a CSV field if it holds a comma, quote or line break
+std::string QuoteCsvField(const std::string& field) {
+    if (field.find_first_of(",\"\r\n") == std::string::npos) return field;
+
+    std::string quoted = "\"";
+    for (char letter : field) {
+        if (letter == '"') quoted += '"';  // Quotes are escaped by doubling them
+        quoted += letter;
+    }
+    return quoted + "\"";
+}
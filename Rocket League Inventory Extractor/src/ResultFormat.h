@@ -0,0 +1,52 @@
+#pragma once
+
+/* Rocket League Classification Result Formats
+by Ridas Jagelavicius
+*/
+
+#include <string>
+
+#include "ItemClassifier.h"
+
+// How classified images are written for other programs to read
+enum class OutputFormat {
+    JsonLines, // One JSON object per line
+    Csv // A header line, then one comma separated row per image
+};
+
+// The outcome of classifying one image file
+struct ClassifiedImage {
+    std::string path; // The image file that was classified
+    bool succeeded = false; // Whether the image could be read and classified
+    ClassificationResult result; // The extracted traits, if succeeded
+    std::string price; // The price range of the item ex. 40-50, or an empty string if it is unknown
+};
+
+/** Parses the name of an output format
+    @param name - jsonl or csv
+    @param format - Set to the named format
+    @return Whether the name was recognized
+*/
+bool ParseOutputFormat(const std::string& name, OutputFormat& format);
+
+/** Returns the line written before any result, if the format has one
+    @param format - The format of the results that follow
+    @return The CSV header ending in a newline, or an empty string for JSON Lines
+*/
+std::string FormatResultHeader(OutputFormat format);
+
+/** Formats one classified image as a single line
+    Both formats hold the path, name, paint, certification, price and the three confidences,
+    plus an error that is empty unless the image could not be read.
+    Text is escaped, so a line never contains a newline of its own
+    @param image - The classified image
+    @param format - The format to write
+    @return The line, ending in a newline
+*/
+std::string FormatResult(const ClassifiedImage& image, OutputFormat format);
+
+/** Quotes a CSV field if it holds a comma, quote or line break
+    @param field - The text of the field
+    @return The field as it should be written in a CSV row
+*/
+std::string QuoteCsvField(const std::string& field);
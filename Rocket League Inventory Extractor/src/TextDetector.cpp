@@ -0,0 +1,405 @@
+/* Rocket League Text Detector
+by Ridas Jagelavicius
+*/
+
+#include <algorithm>
+#include <cctype>
+#include <cmath>
+#include <iostream>
+
+#include "LatencyProfiler.h"
+#include "TextDetector.h"
+
+constexpr float CONFIDENCE_THRESHOLD = .50;  // How confident we want to be that our text box properly encloses the text
+constexpr float NON_MAX_SUPPRESSION_THRESHOLD = .4;  // This will change detection accuracy and the number of text boxes made
+constexpr float EAST_IMAGE_SCALE = 1.0;  // EAST preprocessing image scale factor
+constexpr int EAST_REGION_CELLS = 4;  // EAST cells are grouped into regions this many cells (16 pixels) wide and high
+constexpr int EAST_TOP_K = 2;  // The most confident cells of each region that are decoded into boxes
+constexpr float DB_IMAGE_SCALE = 1.0 / 255;  // DB was trained on pixels scaled to 0 to 1
+const cv::Scalar DB_MEAN(122.67891434, 116.66876762, 104.00698793);  // The BGR mean DB was trained with
+constexpr float DB_BINARY_THRESHOLD = .3;  // Pixels more likely than this to be text are grouped into boxes
+constexpr float DB_UNCLIP_RATIO = 2.0;  // How far DB's shrunken text regions are grown back, relative to their area over perimeter
+constexpr float DB_MIN_SIDE = 3;  // Regions thinner than this many pixels are noise
+constexpr size_t DB_MAX_CANDIDATES = 200;  // The most regions decoded per image
+
+// Custom constructor - prepares to load a network
+TextDetector::TextDetector(const std::string& path_to_model, DetectorBackend backend)
+    : path_to_model_(path_to_model), backend_(backend) {}
+
+// Detects the text boxes of several images in one pass through the network
+std::vector<TextDetections> TextDetector::Detect(const std::vector<cv::Mat>& images,
+                                                 const cv::Size& input_size) {
+    std::vector<TextDetections> detections(images.size());
+    if (images.empty()) return detections;
+    LoadNetwork();
+
+    /* Preprocesses an image.
+          The link below explains exactly how this works, but essentially,
+          preprocessing is a multi-step process that "helps combat illumination
+      changes"
+      https://www.pyimagesearch.com/2017/11/06/deep-learning-opencvs-blobfromimage-works/
+      */
+    {
+        ScopedStageTimer timer(PipelineStage::Preprocess);
+        int shape[] = {static_cast<int>(images.size()), 3, input_size.height, input_size.width};
+        blob_.create(4, shape, CV_32F);
+        Preprocess(images, blob_);
+    }
+
+    // Pass the input images through the network and obtain its outputs
+    std::vector<cv::Mat> outputs;
+    {
+        ScopedStageTimer timer(PipelineStage::Forward);
+        std::vector<cv::String> output_names = GetOutputNames();
+        if (output_names.empty()) output_names = net_.getUnconnectedOutLayersNames();
+        net_.setInput(blob_);
+        net_.forward(outputs, output_names);
+    }
+
+    for (size_t n = 0; n < images.size(); ++n) {
+        TextDetections& image_detections = detections[n];
+
+        // Decode predicted bounding boxes.
+        {
+            ScopedStageTimer timer(PipelineStage::Decode);
+            DecodeBoxes(outputs, static_cast<int>(n), image_detections);
+        }
+
+        // Filter out the best candidates for the correct text box using
+        // non-maximum suppression, keeping only the boxes that survive
+        ScopedStageTimer timer(PipelineStage::NonMaxSuppression);
+        std::vector<int> kept = SuppressOverlappingBoxes(
+            image_detections.boxes, image_detections.confidences, NON_MAX_SUPPRESSION_THRESHOLD);
+        TextDetections survivors;
+        survivors.boxes.reserve(kept.size());
+        survivors.confidences.reserve(kept.size());
+        for (int index : kept) {
+            survivors.indices.push_back(static_cast<int>(survivors.boxes.size()));
+            survivors.boxes.push_back(image_detections.boxes[index]);
+            survivors.confidences.push_back(image_detections.confidences[index]);
+        }
+        image_detections = std::move(survivors);
+    }
+    return detections;
+}
+
+// Writes one image into a blob as cv::dnn::blobFromImage() would
+void TextDetector::WriteToBlob(const cv::Mat& image, double scale, const cv::Scalar& mean,
+                               bool swap_rb, cv::Mat& blob, int index) {
+    const int height = blob.size[2];
+    const int width = blob.size[3];
+    const bool resize = image.size() != cv::Size(width, height);
+    if (resize) cv::resize(image, resized_, cv::Size(width, height), 0, 0, cv::INTER_LINEAR);
+
+    // The mean is given in the blob's channel order, so it is swapped back to subtract it from BGR
+    (resize ? resized_ : image).convertTo(converted_, CV_32F);
+    cv::subtract(converted_, swap_rb ? cv::Scalar(mean[2], mean[1], mean[0]) : mean, converted_);
+    if (scale != 1) cv::multiply(converted_, cv::Scalar::all(scale), converted_);
+
+    // Split the channels straight into the blob's planes, in RGB order if asked
+    std::vector<cv::Mat> planes;
+    for (int c = 0; c < 3; ++c)
+        planes.push_back(cv::Mat(height, width, CV_32F, blob.ptr<float>(index, swap_rb ? 2 - c : c)));
+    cv::split(converted_, planes);
+}
+
+// Loads the network and selects its backend and target
+void TextDetector::LoadNetwork() {
+    if (!net_.empty()) return;
+    CV_Assert(!path_to_model_.empty());
+
+    // Load network once and keep it for every following image
+    ScopedStageTimer timer(PipelineStage::LoadNetwork);
+    net_ = cv::dnn::readNet(path_to_model_);
+
+    DetectorBackend backend = backend_;
+    if (!IsBackendAvailable(backend)) {
+        std::cerr << GetDetectorBackendName(backend)
+                  << " is not available in this build of OpenCV, using opencv instead" << std::endl;
+        backend = DetectorBackend::OpenCv;
+    }
+    net_.setPreferableBackend(backend == DetectorBackend::OpenVino
+                                  ? cv::dnn::DNN_BACKEND_INFERENCE_ENGINE
+                                  : cv::dnn::DNN_BACKEND_OPENCV);
+    net_.setPreferableTarget(cv::dnn::DNN_TARGET_CPU);
+}
+
+// Writes images into EAST's input blob
+void EastTextDetector::Preprocess(const std::vector<cv::Mat>& images, cv::Mat& blob) {
+    // Each image keeps its own mean subtracted, exactly as if it were passed alone
+    for (size_t n = 0; n < images.size(); ++n)
+        WriteToBlob(images[n], EAST_IMAGE_SCALE, cv::mean(images[n]), true, blob,
+                    static_cast<int>(n));
+}
+
+// Returns EAST's score and geometry layers
+std::vector<cv::String> EastTextDetector::GetOutputNames() const {
+    // Specify the output layers for the network
+    std::vector<cv::String> outNames(2);
+    outNames[0] = "feature_fusion/Conv_7/Sigmoid";  // Confidence
+    outNames[1] = "feature_fusion/concat_3";        // Geometry
+    return outNames;
+}
+
+// Decode the positions and orientations of the text boxes
+// Ref:
+// https://github.com/spmallick/learnopencv/blob/master/TextDetectionEAST/textDetection.cpp
+void EastTextDetector::DecodeBoxes(const std::vector<cv::Mat>& outputs, int image_index,
+                                   TextDetections& detections) {
+    const cv::Mat& scores = outputs[0];
+    const cv::Mat& geometry = outputs[1];
+    detections.boxes.clear();
+    detections.confidences.clear();
+    CV_Assert(scores.dims == 4);
+    CV_Assert(geometry.dims == 4);
+    CV_Assert(image_index < scores.size[0]);
+    CV_Assert(scores.size[0] == geometry.size[0]);
+    CV_Assert(scores.size[1] == 1);
+    CV_Assert(geometry.size[1] == 5);
+    CV_Assert(scores.size[2] == geometry.size[2]);
+    CV_Assert(scores.size[3] == geometry.size[3]);
+
+    const int height = scores.size[2];
+    const int width = scores.size[3];
+
+    // Keep the EAST_TOP_K most confident cells of each region; a score of 0 marks an empty slot
+    struct Cell {
+        float score;
+        int x, y;
+    };
+    const int region_columns = (width + EAST_REGION_CELLS - 1) / EAST_REGION_CELLS;
+    const int region_rows = (height + EAST_REGION_CELLS - 1) / EAST_REGION_CELLS;
+    std::vector<Cell> regions(static_cast<size_t>(region_columns) * region_rows * EAST_TOP_K,
+                              Cell{0, 0, 0});
+    for (int y = 0; y < height; ++y) {
+        const float* scoresData = scores.ptr<float>(image_index, 0, y);
+        Cell* row = &regions[static_cast<size_t>(y / EAST_REGION_CELLS) * region_columns * EAST_TOP_K];
+        for (int x = 0; x < width; ++x) {
+            float score = scoresData[x];
+            if (score < CONFIDENCE_THRESHOLD) continue;
+
+            // Replace the least confident cell of the region if this one beats it
+            Cell* slots = row + (x / EAST_REGION_CELLS) * EAST_TOP_K;
+            Cell* weakest = slots;
+            for (int k = 1; k < EAST_TOP_K; ++k)
+                if (slots[k].score < weakest->score) weakest = slots + k;
+            if (score > weakest->score) *weakest = Cell{score, x, y};
+        }
+    }
+
+    // Only the kept cells pay for the trigonometry of decoding their box
+    for (const Cell& cell : regions) {
+        if (cell.score == 0) continue;
+        const int x = cell.x, y = cell.y;
+        const float* x0_data = geometry.ptr<float>(image_index, 0, y);
+        const float* x1_data = geometry.ptr<float>(image_index, 1, y);
+        const float* x2_data = geometry.ptr<float>(image_index, 2, y);
+        const float* x3_data = geometry.ptr<float>(image_index, 3, y);
+        const float* anglesData = geometry.ptr<float>(image_index, 4, y);
+
+        // Decode a prediction.
+        // Multiple by 4 because feature maps are 4 time less than input
+        // image.
+        float offsetX = x * 4.0f, offsetY = y * 4.0f;
+        float angle = anglesData[x];
+        float cosA = std::cos(angle);
+        float sinA = std::sin(angle);
+        float h = x0_data[x] + x2_data[x];
+        float w = x1_data[x] + x3_data[x];
+
+        cv::Point2f offset(
+            offsetX + cosA * x1_data[x] + sinA * x2_data[x],
+            offsetY - sinA * x1_data[x] + cosA * x2_data[x]);
+        cv::Point2f p1 = cv::Point2f(-sinA * h, -cosA * h) + offset;
+        cv::Point2f p3 = cv::Point2f(-cosA * w, sinA * w) + offset;
+        cv::RotatedRect r(0.5f * (p1 + p3), cv::Size2f(w, h),
+                            -angle * 180.0f / (float)CV_PI);
+        detections.boxes.push_back(r);
+        detections.confidences.push_back(cell.score);
+    }
+}
+
+// Writes images into DB's input blob
+void DbTextDetector::Preprocess(const std::vector<cv::Mat>& images, cv::Mat& blob) {
+    for (size_t n = 0; n < images.size(); ++n)
+        WriteToBlob(images[n], DB_IMAGE_SCALE, DB_MEAN, false, blob, static_cast<int>(n));
+}
+
+// Returns no names, so the network's own output, the probability map, is used
+std::vector<cv::String> DbTextDetector::GetOutputNames() const {
+    return std::vector<cv::String>();
+}
+
+// Groups the text pixels of DB's probability map into rotated boxes
+// Ref: https://github.com/MhLiao/DB (structure/representers/seg_detector_representer.py)
+void DbTextDetector::DecodeBoxes(const std::vector<cv::Mat>& outputs, int image_index,
+                                 TextDetections& detections) {
+    const cv::Mat& output = outputs[0];
+    detections.boxes.clear();
+    detections.confidences.clear();
+    CV_Assert(output.dims == 4);
+    CV_Assert(image_index < output.size[0]);
+    CV_Assert(output.size[1] == 1);
+
+    // The map is the size of the network input, so boxes need no scaling here
+    const int height = output.size[2];
+    const int width = output.size[3];
+    cv::Mat probability(height, width, CV_32F,
+                        const_cast<float*>(output.ptr<float>(image_index, 0, 0)));
+    cv::Mat text;
+    cv::compare(probability, DB_BINARY_THRESHOLD, text, cv::CMP_GT);
+
+    std::vector<std::vector<cv::Point>> contours;
+    cv::findContours(text, contours, cv::RETR_LIST, cv::CHAIN_APPROX_SIMPLE);
+    if (contours.size() > DB_MAX_CANDIDATES) contours.resize(DB_MAX_CANDIDATES);
+
+    cv::Mat mask;
+    for (const std::vector<cv::Point>& contour : contours) {
+        cv::RotatedRect box = cv::minAreaRect(contour);
+        if (std::min(box.size.width, box.size.height) < DB_MIN_SIDE) continue;
+
+        // A region's confidence is the mean probability of the pixels inside it
+        cv::Rect bounds = cv::boundingRect(contour) & cv::Rect(0, 0, width, height);
+        if (bounds.empty()) continue;
+        mask = cv::Mat::zeros(bounds.height, bounds.width, CV_8U);
+        cv::fillPoly(mask, std::vector<std::vector<cv::Point>>{contour}, cv::Scalar(255), cv::LINE_8,
+                     0, cv::Point(-bounds.x, -bounds.y));
+        float score = static_cast<float>(cv::mean(probability(bounds), mask)[0]);
+        if (score < CONFIDENCE_THRESHOLD) continue;
+
+        // DB is trained to predict text regions shrunk by this distance, so they are grown back
+        float area = box.size.width * box.size.height;
+        float perimeter = 2 * (box.size.width + box.size.height);
+        float distance = area * DB_UNCLIP_RATIO / perimeter;
+        box.size.width += 2 * distance;
+        box.size.height += 2 * distance;
+        if (std::min(box.size.width, box.size.height) < DB_MIN_SIDE + 2) continue;
+
+        detections.boxes.push_back(box);
+        detections.confidences.push_back(score);
+    }
+}
+
+// Keeps the most confident of each group of overlapping rotated boxes
+std::vector<int> SuppressOverlappingBoxes(const std::vector<cv::RotatedRect>& boxes,
+                                          const std::vector<float>& confidences,
+                                          float overlap_threshold) {
+    // Most confident first; equally confident boxes keep their order, as in cv::dnn::NMSBoxes()
+    std::vector<int> order(boxes.size());
+    for (size_t i = 0; i < order.size(); ++i) order[i] = static_cast<int>(i);
+    std::stable_sort(order.begin(), order.end(),
+                     [&](int a, int b) { return confidences[a] > confidences[b]; });
+
+    std::vector<int> kept;
+    std::vector<cv::Rect2f> kept_bounds;
+    std::vector<float> kept_areas;
+    std::vector<cv::Point2f> intersection;
+    for (int index : order) {
+        const cv::RotatedRect& box = boxes[index];
+        cv::Rect2f bounds = box.boundingRect2f();
+        float area = box.size.width * box.size.height;
+
+        bool overlaps = false;
+        for (size_t k = 0; k < kept.size() && !overlaps; ++k) {
+            cv::Rect2f shared = bounds & kept_bounds[k];
+            if (shared.width <= 0 || shared.height <= 0) continue;
+
+            // Unless one box could lie inside the other (which counts as a full overlap), the
+            // rotated boxes overlap no more than their bounds or the smaller box, so this is the
+            // largest intersection over union the pair could have
+            if (shared != bounds && shared != kept_bounds[k]) {
+                float most = std::min(shared.width * shared.height, std::min(area, kept_areas[k]));
+                if (most <= overlap_threshold * (area + kept_areas[k] - most)) continue;
+            }
+
+            // Ref: rotatedRectIOU() in OpenCV's modules/dnn/src/nms.cpp
+            intersection.clear();
+            int result = cv::rotatedRectangleIntersection(box, boxes[kept[k]], intersection);
+            if (intersection.empty() || result == cv::INTERSECT_NONE) continue;
+            if (result == cv::INTERSECT_FULL) {
+                overlaps = true;
+                continue;
+            }
+            float shared_area = static_cast<float>(cv::contourArea(intersection));
+            overlaps = shared_area / (area + kept_areas[k] - shared_area) > overlap_threshold;
+        }
+
+        if (!overlaps) {
+            kept.push_back(index);
+            kept_bounds.push_back(bounds);
+            kept_areas.push_back(area);
+        }
+    }
+    return kept;
+}
+
+// Creates the detector for a model
+std::unique_ptr<TextDetector> CreateTextDetector(const std::string& path_to_model,
+                                                 const DetectorOptions& options) {
+    if (options.model == DetectorModel::Db)
+        return std::unique_ptr<TextDetector>(new DbTextDetector(path_to_model, options.backend));
+    return std::unique_ptr<TextDetector>(new EastTextDetector(path_to_model, options.backend));
+}
+
+// Returns a copy of text in lowercase
+static std::string ToLower(std::string text) {
+    std::transform(text.begin(), text.end(), text.begin(),
+                   [](unsigned char c) { return static_cast<char>(std::tolower(c)); });
+    return text;
+}
+
+// Guesses the architecture of a model from its file name
+DetectorModel GuessDetectorModel(const std::string& path_to_model) {
+    std::string name = ToLower(path_to_model.substr(path_to_model.find_last_of("/\\") + 1));
+    bool onnx = name.size() >= 5 && name.compare(name.size() - 5, 5, ".onnx") == 0;
+    return onnx && name.find("east") == std::string::npos ? DetectorModel::Db
+                                                         : DetectorModel::East;
+}
+
+// Returns whether cv::dnn can run networks on a backend on this machine
+bool IsBackendAvailable(DetectorBackend backend) {
+    if (backend == DetectorBackend::OpenCv) return true;
+    for (const std::pair<cv::dnn::Backend, cv::dnn::Target>& available :
+         cv::dnn::getAvailableBackends()) {
+        if (available.first == cv::dnn::DNN_BACKEND_INFERENCE_ENGINE &&
+            available.second == cv::dnn::DNN_TARGET_CPU)
+            return true;
+    }
+    return false;
+}
+
+// Reads a model architecture written as east or db
+bool ParseDetectorModel(const std::string& text, DetectorModel& model) {
+    std::string name = ToLower(text);
+    if (name == "east") {
+        model = DetectorModel::East;
+    } else if (name == "db") {
+        model = DetectorModel::Db;
+    } else {
+        return false;
+    }
+    return true;
+}
+
+// Reads a backend written as opencv or openvino
+bool ParseDetectorBackend(const std::string& text, DetectorBackend& backend) {
+    std::string name = ToLower(text);
+    if (name == "opencv") {
+        backend = DetectorBackend::OpenCv;
+    } else if (name == "openvino") {
+        backend = DetectorBackend::OpenVino;
+    } else {
+        return false;
+    }
+    return true;
+}
+
+// Returns the name of a model architecture
+std::string GetDetectorModelName(DetectorModel model) {
+    return model == DetectorModel::Db ? "db" : "east";
+}
+
+// Returns the name of a backend
+std::string GetDetectorBackendName(DetectorBackend backend) {
+    return backend == DetectorBackend::OpenVino ? "openvino" : "opencv";
+}
@@ -0,0 +1,185 @@
+#pragma once
+
+/* Rocket League Text Detector
+by Ridas Jagelavicius
+*/
+
+#include <memory>
+#include <string>
+#include <vector>
+#include <opencv2/opencv.hpp>
+#include <opencv2/dnn.hpp>
+
+// The network architectures that can detect the text boxes of a tile
+enum class DetectorModel {
+    East, // EAST (frozen_east_text_detection.pb), which predicts a rotated box at every 4th pixel
+    Db // Differentiable Binarization ex. DB_TD500_resnet18.onnx, lighter and predicts a text probability per pixel
+};
+
+// Where cv::dnn runs the network; both run on the CPU
+enum class DetectorBackend {
+    OpenCv, // OpenCV's own layers, always available
+    OpenVino // Intel's OpenVINO inference engine, only if OpenCV was built with it
+};
+
+// How ItemClassifier detects text boxes
+struct DetectorOptions {
+    DetectorModel model = DetectorModel::East; // The architecture of the model file
+    DetectorBackend backend = DetectorBackend::OpenCv; // Where the network runs
+};
+
+// The text boxes detected in one image, in the coordinates of its network input size
+struct TextDetections {
+    std::vector<cv::RotatedRect> boxes; // The candidate boxes; after Detect(), only the boxes kept by non-maximum suppression
+    std::vector<float> confidences; // The confidence of each box in boxes, from 0 to 1
+    std::vector<int> indices; // The indices of the boxes kept by non-maximum suppression, most confident first
+};
+
+class TextDetector {
+   public:
+    /** Custom constructor - prepares to load a network; it is only loaded on first use
+        Quantized (INT8) models are loaded the same way as their full precision versions
+        @param path_to_model - The full file path to the model
+        @param backend - Where to run the network; OpenCv is used if the backend is not available
+    */
+    TextDetector(const std::string& path_to_model, DetectorBackend backend);
+
+    virtual ~TextDetector() = default;
+
+    /** Detects the text boxes of several images in one pass through the network
+        Overlapping candidates are suppressed with SuppressOverlappingBoxes() and only the kept
+        boxes are returned, so a dense screenshot does not leave thousands of candidates behind
+        @param images - BGR images, which are all resized to input_size
+        @param input_size - The network input size, a multiple of 32 in both directions
+        @return The detections of each image, in the same order as images
+    */
+    std::vector<TextDetections> Detect(const std::vector<cv::Mat>& images,
+                                       const cv::Size& input_size);
+
+   protected:
+    /** Writes images into the network's input blob
+        @param images - BGR images
+        @param blob - A blob already shaped [images, 3, height, width]; each image is resized to its height and width
+    */
+    virtual void Preprocess(const std::vector<cv::Mat>& images, cv::Mat& blob) = 0;
+
+    /** Writes one image into a blob exactly as cv::dnn::blobFromImage() would, straight into the
+        blob's planes and through buffers kept between images, rather than into a new blob per image
+        @param image - A BGR image, resized to the blob's height and width
+        @param scale - Multiplies every pixel after the mean is subtracted
+        @param mean - Subtracted from every pixel, in the order of the blob's channels
+        @param swap_rb - Whether the blob's channels are RGB rather than BGR
+        @param blob - A blob of shape [images, 3, height, width]
+        @param index - The image of the blob to write
+    */
+    void WriteToBlob(const cv::Mat& image, double scale, const cv::Scalar& mean, bool swap_rb,
+                     cv::Mat& blob, int index);
+
+    /** Returns the names of the layers whose outputs are passed to DecodeBoxes()
+        @return The output layer names, or an empty vector for the layers whose outputs nothing consumes
+    */
+    virtual std::vector<cv::String> GetOutputNames() const = 0;
+
+    /** Decodes the boxes of one image of the batch from the network's outputs
+        @param outputs - The outputs named by GetOutputNames(), in that order
+        @param image_index - The image of the batch to decode
+        @param detections - Set to the candidate boxes and their confidences
+    */
+    virtual void DecodeBoxes(const std::vector<cv::Mat>& outputs, int image_index,
+                             TextDetections& detections) = 0;
+
+   private:
+    std::string path_to_model_; // The full file path to the model
+    DetectorBackend backend_; // Where the network runs
+    cv::dnn::Net net_; // The network, loaded from path_to_model_ on first use
+    cv::Mat blob_; // The input blob, reused while the batch size and input size stay the same
+    cv::Mat resized_; // An image resized to the input size, reused by WriteToBlob()
+    cv::Mat converted_; // resized_ as floating point with the mean subtracted, reused by WriteToBlob()
+
+    void LoadNetwork(); // Loads the network and selects its backend and target
+};
+
+// Detects text with EAST, which outputs a score map and the geometry of a box at every 4th pixel
+// Every cell inside a word predicts the box of the whole word, so only the most confident cells of
+// each small region are decoded into boxes; the rest would be suppressed as duplicates anyway
+class EastTextDetector : public TextDetector {
+   public:
+    using TextDetector::TextDetector;
+
+   protected:
+    void Preprocess(const std::vector<cv::Mat>& images, cv::Mat& blob) override;
+    std::vector<cv::String> GetOutputNames() const override;
+    void DecodeBoxes(const std::vector<cv::Mat>& outputs, int image_index,
+                     TextDetections& detections) override;
+};
+
+// Detects text with Differentiable Binarization, which outputs the probability of text at every pixel
+class DbTextDetector : public TextDetector {
+   public:
+    using TextDetector::TextDetector;
+
+   protected:
+    void Preprocess(const std::vector<cv::Mat>& images, cv::Mat& blob) override;
+    std::vector<cv::String> GetOutputNames() const override;
+    void DecodeBoxes(const std::vector<cv::Mat>& outputs, int image_index,
+                     TextDetections& detections) override;
+};
+
+/** Keeps the most confident of each group of overlapping rotated boxes, exactly as cv::dnn::NMSBoxes()
+    does with no score threshold. Boxes are compared with every kept box, but a pair whose axis
+    aligned bounds cannot overlap by more than the threshold is rejected without computing the
+    overlap of the rotated boxes, which is most pairs on a tile with a lot of text
+    @param boxes - The candidate boxes
+    @param confidences - The confidence of each box in boxes
+    @param overlap_threshold - A box is dropped if its intersection over union with a kept box is above this
+    @return The indices of the kept boxes, most confident first
+*/
+std::vector<int> SuppressOverlappingBoxes(const std::vector<cv::RotatedRect>& boxes,
+                                          const std::vector<float>& confidences,
+                                          float overlap_threshold);
+
+/** Creates the detector for a model
+    @param path_to_model - The full file path to the model
+    @param options - The architecture of the model and where to run it
+    @return A detector that loads the model on first use
+*/
+std::unique_ptr<TextDetector> CreateTextDetector(const std::string& path_to_model,
+                                                 const DetectorOptions& options);
+
+/** Guesses the architecture of a model from its file name
+    @param path_to_model - The path or name of the model file
+    @return Db for .onnx files without "east" in their name, otherwise East
+*/
+DetectorModel GuessDetectorModel(const std::string& path_to_model);
+
+/** Returns whether cv::dnn can run networks on a backend on this machine
+    @param backend - The backend to check
+    @return Whether the backend is available with a CPU target
+*/
+bool IsBackendAvailable(DetectorBackend backend);
+
+/** Reads a model architecture written as east or db
+    @param text - The architecture to read, in any case
+    @param model - Set to the architecture read
+    @return Whether text names an architecture
+*/
+bool ParseDetectorModel(const std::string& text, DetectorModel& model);
+
+/** Reads a backend written as opencv or openvino
+    @param text - The backend to read, in any case
+    @param backend - Set to the backend read
+    @return Whether text names a backend
+*/
+bool ParseDetectorBackend(const std::string& text, DetectorBackend& backend);
+
+/** Returns the name of a model architecture, as ParseDetectorModel() reads it
+    @param model - The architecture
+    @return east or db
+*/
+std::string GetDetectorModelName(DetectorModel model);
+
+/** Returns the name of a backend, as ParseDetectorBackend() reads it
+    @param backend - The backend
+    @return opencv or openvino
+*/
+std::string GetDetectorBackendName(DetectorBackend backend);
@@ -0,0 +1,83 @@
+/* Rocket League Text Normalizer
+by Ridas Jagelavicius
+*/
+
+#include <array>
+#include <cstdint>
+
+#include "TextNormalizer.h"
+
+// Each table entry is the byte to write in place of a byte of text, or one of these actions
+// NUL and SOH never appear in OCR output, so their values are free to be used as actions
+constexpr uint8_t DROP = 0;  // The byte is removed
+constexpr uint8_t HYPHEN = 1;  // The byte is removed, along with a space directly after it
+
+typedef std::array<uint8_t, 256> NormalizationTable;
+
+// Builds the lookup table of a mode at compile time
+constexpr NormalizationTable BuildTable(NormalizationMode mode) {
+    NormalizationTable table{};
+    for (int byte = 0; byte < 256; byte++) {
+        // Letters are lowercased, everything else is kept as is
+        table[byte] = static_cast<uint8_t>(byte >= 'A' && byte <= 'Z' ? byte - 'A' + 'a' : byte);
+    }
+
+    const char noise[] = "\n[]{}!/\\.:;_";
+    for (int i = 0; noise[i] != '\0'; i++)
+        table[static_cast<uint8_t>(noise[i])] = DROP;
+
+    if (mode == NormalizationMode::Word) {
+        table['-'] = HYPHEN;
+    } else {
+        table['-'] = DROP;
+        table[' '] = DROP;
+    }
+
+    table[0] = DROP;
+    table[1] = DROP;
+    return table;
+}
+
+constexpr NormalizationTable WORD_TABLE = BuildTable(NormalizationMode::Word);
+constexpr NormalizationTable KEY_TABLE = BuildTable(NormalizationMode::Key);
+
+static_assert(WORD_TABLE['A'] == 'a' && WORD_TABLE[' '] == ' ' && WORD_TABLE['-'] == HYPHEN,
+              "Word mode keeps spaces and treats hyphens specially");
+static_assert(KEY_TABLE[' '] == DROP && KEY_TABLE['-'] == DROP && KEY_TABLE['Z'] == 'z',
+              "Key mode drops spaces and hyphens");
+
+// Normalizes text for matching in a single pass over a 256-entry lookup table
+void NormalizeText(const char* text, size_t length, NormalizationMode mode,
+                   std::string& output) {
+    const NormalizationTable& table =
+        mode == NormalizationMode::Word ? WORD_TABLE : KEY_TABLE;
+
+    // Write straight into the buffer, then trim it to what was written
+    output.resize(length);
+    char* out = &output[0];
+    size_t written = 0;
+
+    for (size_t i = 0; i < length; i++) {
+        uint8_t action = table[static_cast<uint8_t>(text[i])];
+        if (action > HYPHEN) {
+            out[written++] = static_cast<char>(action);
+        } else if (action == HYPHEN) {
+            // "Item - Characteristic" is 2 words, not 3
+            if (i + 1 < length && text[i + 1] == ' ') i++;
+        }
+    }
+    output.resize(written);
+}
+
+// Normalizes text for matching, reusing the capacity of output
+void NormalizeText(const std::string& text, NormalizationMode mode,
+                   std::string& output) {
+    NormalizeText(text.data(), text.size(), mode, output);
+}
+
+// Normalizes text for matching
+std::string NormalizeText(const std::string& text, NormalizationMode mode) {
+    std::string output;
+    NormalizeText(text.data(), text.size(), mode, output);
+    return output;
+}
@@ -0,0 +1,41 @@
+#pragma once
+
+/* Rocket League Text Normalizer
+by Ridas Jagelavicius
+*/
+
+#include <cstddef>
+#include <string>
+
+// How text is normalized
+enum class NormalizationMode {
+    Word,  // Keeps spaces between words, drops a hyphen and a space directly after it ex. "Octane - MG-88" -> "octane mg88"
+    Key    // Drops every space and hyphen, giving a database key ex. "Octane - MG-88" -> "octanemg88"
+};
+
+/** Normalizes text for matching in a single pass over a 256-entry lookup table
+    OCR noise ([ ] { } ! / \ . : ; _ and newlines) is removed and letters are converted to lowercase.
+    Bytes outside ASCII (ex. the a-umlaut in Jager) are kept unchanged
+    @param text - The text to normalize
+    @param length - The number of bytes in text
+    @param mode - Whether to keep spaces between words or build a database key
+    @param output - Replaced with the normalized text. Its capacity is reused, so passing
+                    the same string for many calls avoids allocating for each one
+*/
+void NormalizeText(const char* text, size_t length, NormalizationMode mode,
+                   std::string& output);
+
+/** Normalizes text for matching, reusing the capacity of output
+    @param text - The text to normalize
+    @param mode - Whether to keep spaces between words or build a database key
+    @param output - Replaced with the normalized text
+*/
+void NormalizeText(const std::string& text, NormalizationMode mode,
+                   std::string& output);
+
+/** Normalizes text for matching
+    @param text - The text to normalize
+    @param mode - Whether to keep spaces between words or build a database key
+    @return The normalized text
+*/
+std::string NormalizeText(const std::string& text, NormalizationMode mode);
@@ -0,0 +1,83 @@
+/* Rocket League Thread Budget
+by Ridas Jagelavicius
+*/
+
+#include <algorithm>
+#include <cctype>
+#include <cstdlib>
+#include <stdexcept>
+#include <thread>
+
+#include <opencv2/opencv.hpp>
+
+#include "ThreadBudget.h"
+
+// Returns the number of cores the machine reports
+size_t CountCores() {
+    return std::max(1u, std::thread::hardware_concurrency());
+}
+
+// Returns a budget that gives every core to exactly one thread
+ThreadBudget SplitThreadBudget(size_t workers, size_t cores) {
+    ThreadBudget budget;
+    budget.workers = std::max<size_t>(1, workers);
+    budget.intra_op_threads = std::max<size_t>(1, cores / budget.workers);
+    return budget;
+}
+
+// Lists every useful budget for a number of cores
+std::vector<ThreadBudget> ListThreadBudgets(size_t cores) {
+    cores = std::max<size_t>(1, cores);
+    std::vector<ThreadBudget> budgets;
+    for (size_t workers = 1; workers <= cores; workers++) {
+        ThreadBudget budget = SplitThreadBudget(workers, cores);
+
+        // More workers with the same intra-op threads only helps if they use more of the cores
+        if (!budgets.empty() && budgets.back().intra_op_threads == budget.intra_op_threads)
+            budgets.back() = budget;
+        else
+            budgets.push_back(budget);
+    }
+    return budgets;
+}
+
+// Reads a budget written as <workers>x<intra-op threads>
+bool ParseThreadBudget(const std::string& text, ThreadBudget& budget) {
+    size_t x = text.find_first_of("xX");
+    if (x == std::string::npos || x == 0 || x + 1 == text.size()) return false;
+    for (size_t i = 0; i < text.size(); i++)
+        if (i != x && !std::isdigit(static_cast<unsigned char>(text[i]))) return false;
+
+    ThreadBudget parsed;
+    try {
+        parsed.workers = std::stoul(text.substr(0, x));
+        parsed.intra_op_threads = std::stoul(text.substr(x + 1));
+    } catch (const std::exception&) {
+        return false;  // Too large to be a number of threads
+    }
+    if (parsed.workers == 0 || parsed.intra_op_threads == 0) return false;
+    budget = parsed;
+    return true;
+}
+
+// Writes a budget as <workers>x<intra-op threads>
+std::string FormatThreadBudget(const ThreadBudget& budget) {
+    return std::to_string(budget.workers) + "x" + std::to_string(budget.intra_op_threads);
+}
+
+// Limits the threads OpenCV and Tesseract start inside each call
+bool ApplyThreadBudget(const ThreadBudget& budget) {
+    int threads = static_cast<int>(std::max<size_t>(1, budget.intra_op_threads));
+    cv::setNumThreads(threads);
+
+    // Tesseract only runs in parallel when it was built with OpenMP, which reads this at startup
+    const char* limit = std::getenv("OMP_THREAD_LIMIT");
+    bool limited = limit != nullptr && std::atoi(limit) > 0 && std::atoi(limit) <= threads;
+    std::string value = std::to_string(threads);
+#ifdef _WIN32
+    _putenv_s("OMP_THREAD_LIMIT", value.c_str());
+#else
+    setenv("OMP_THREAD_LIMIT", value.c_str(), 1);
+#endif
+    return limited;
+}
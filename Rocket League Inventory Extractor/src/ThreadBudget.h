@@ -0,0 +1,57 @@
+#pragma once
+
+/* Rocket League Thread Budget
+by Ridas Jagelavicius
+*/
+
+#include <cstddef>
+#include <string>
+#include <vector>
+
+// How the cores of a machine are split between classifiers and the libraries they call
+struct ThreadBudget {
+    size_t workers = 1; // Threads that each run their own ItemClassifier
+    size_t intra_op_threads = 1; // Threads OpenCV and Tesseract may use inside a single call
+};
+
+/** Returns the number of cores the machine reports
+    @return std::thread::hardware_concurrency(), or 1 if it is unknown
+*/
+size_t CountCores();
+
+/** Returns a budget that gives every core to exactly one thread
+    @param workers - The number of classifier threads wanted
+    @param cores - The number of cores to split between them
+    @return A budget of the workers, each allowed cores / workers intra-op threads (at least 1)
+*/
+ThreadBudget SplitThreadBudget(size_t workers, size_t cores);
+
+/** Lists every useful budget for a number of cores, from 1 worker using every core to one worker
+    per core. Each number of workers is given as many intra-op threads as fit in the cores
+    @param cores - The number of cores to split
+    @return The budgets in order of increasing workers, without two that use the same split
+*/
+std::vector<ThreadBudget> ListThreadBudgets(size_t cores);
+
+/** Reads a budget written as <workers>x<intra-op threads> ex. 8x2
+    @param text - The budget to read
+    @param budget - Set to the budget read
+    @return Whether text is a valid budget with at least one of each
+*/
+bool ParseThreadBudget(const std::string& text, ThreadBudget& budget);
+
+/** Writes a budget as <workers>x<intra-op threads>, the form ParseThreadBudget() reads
+    @param budget - The budget to write
+    @return The budget as text ex. 8x2
+*/
+std::string FormatThreadBudget(const ThreadBudget& budget);
+
+/** Limits the threads OpenCV and Tesseract start inside each call to the budget's intra-op threads
+    OpenCV's DNN and image functions share one process wide pool, sized with cv::setNumThreads().
+    Tesseract's OpenMP reads OMP_THREAD_LIMIT when the process starts, so the variable is also
+    set here for the processes this one starts, but only limits this process if it was set
+    before it started. Call before the first image is classified
+    @param budget - The budget to apply
+    @return Whether OMP_THREAD_LIMIT was already set no higher than the budget allows
+*/
+bool ApplyThreadBudget(const ThreadBudget& budget);
@@ -0,0 +1,161 @@
+/* Rocket League Synthetic Item Tile Renderer
+by Ridas Jagelavicius
+*/
+
+#include <algorithm>
+#include <cctype>
+#include <cmath>
+#include <opencv2/imgproc.hpp>
+
+#include "TileRenderer.h"
+
+constexpr int TILE_WIDTH = 137;  // The size of an in-game tile at 1080p
+constexpr int TILE_HEIGHT = 155;
+constexpr int FONT = cv::FONT_HERSHEY_DUPLEX;  // The closest built-in font to the game's
+constexpr int ART_SHAPES = 6;  // How many shapes make up the item art
+constexpr double NAME_FONT_SCALE = 0.45;  // Font sizes at a scale of 1
+constexpr double LABEL_FONT_SCALE = 0.38;
+constexpr double CERTIFICATION_FONT_SCALE = 0.36;
+constexpr float LABEL_TOP = 0.64f;  // Where the paint label starts, as a fraction of the tile height
+constexpr float LABEL_HEIGHT = 0.11f;  // The height of the paint label, as a fraction of the tile height
+constexpr float MIN_LABEL_WIDTH = 0.3f;  // The narrowest paint label, as a fraction of the tile width
+constexpr float NAME_CENTER = 0.88f;  // Where the item name is centered, as a fraction of the tile height
+
+// The color of item names of each rarity, as written in the database
+struct RarityColor {
+    const char* rarity;
+    unsigned char red, green, blue;
+};
+
+constexpr RarityColor RARITY_COLORS[] = {
+    {"Uncommon", 120, 190, 222}, {"Rare", 90, 140, 230},
+    {"Veryrare", 150, 110, 235}, {"Import", 235, 70, 70},
+    {"Exotic", 235, 200, 60},    {"Blackmarket", 230, 80, 200},
+    {"Limited", 245, 140, 40}};
+
+const cv::Scalar BACKGROUND_COLOR(71, 56, 39);  // The tile background (BGR)
+const cv::Scalar BORDER_COLOR(190, 150, 90);  // The tile outline (BGR)
+const cv::Scalar CERTIFICATION_BAR_COLOR(35, 30, 25);  // The bar behind a certification (BGR)
+const cv::Scalar CERTIFICATION_TEXT_COLOR(200, 200, 200);  // The certification text (BGR)
+
+// Custom constructor
+TileRenderer::TileRenderer(unsigned seed) : random_(seed) { /* Nothing */ }
+
+// Returns the size of a tile rendered at a scale
+cv::Size TileRenderer::GetTileSize(double scale) const {
+    return cv::Size(static_cast<int>(std::lround(TILE_WIDTH * scale)),
+                    static_cast<int>(std::lround(TILE_HEIGHT * scale)));
+}
+
+// Renders an item tile laid out like the in-game inventory
+cv::Mat TileRenderer::RenderTile(const InventoryItem& item, double scale) {
+    cv::Size size = GetTileSize(scale);
+    int thickness = std::max(1, static_cast<int>(std::lround(scale)));
+
+    // Vary the background slightly so no two tiles are identical
+    std::uniform_int_distribution<int> jitter(-8, 8);
+    cv::Scalar background(BACKGROUND_COLOR[0] + jitter(random_),
+                          BACKGROUND_COLOR[1] + jitter(random_),
+                          BACKGROUND_COLOR[2] + jitter(random_));
+    cv::Mat tile(size, CV_8UC3, background);
+    cv::rectangle(tile, cv::Rect(1, 1, size.width - 2, size.height - 2),
+                  BORDER_COLOR, thickness, cv::LINE_AA);
+    DrawItemArt(tile);
+
+    // The paint label sits just above the item name
+    cv::Scalar label_color;
+    bool painted = paints_.GetLabelColor(item.GetColor(), label_color);
+    if (painted) {
+        std::string label = item.GetColor();
+        std::transform(label.begin(), label.end(), label.begin(), ::toupper);
+
+        // Label text stays thin at every scale, as it is in game, so the label remains mostly paint
+        double font_scale = LABEL_FONT_SCALE * scale;
+        cv::Size text = GetTextSize(label, font_scale, 0.8 * size.width, 1);
+        int width = std::max(static_cast<int>(MIN_LABEL_WIDTH * size.width),
+                             text.width + static_cast<int>(0.12 * size.width));
+        int height = static_cast<int>(LABEL_HEIGHT * size.height);
+        cv::Rect region((size.width - width) / 2,
+                        static_cast<int>(LABEL_TOP * size.height), width, height);
+        cv::rectangle(tile, region, label_color, cv::FILLED);
+
+        // Light labels (White, Saffron, Lime) have dark text
+        bool light = label_color[0] + label_color[1] + label_color[2] > 500;
+        DrawCenteredText(tile, label, region.y + height / 2, font_scale,
+                         0.8 * size.width, 1,
+                         light ? cv::Scalar(40, 40, 40) : cv::Scalar(255, 255, 255));
+    }
+
+    // The certification bar sits above the paint label, or in its place
+    if (!item.GetCertification().empty()) {
+        std::string certification = item.GetCertification();
+        std::transform(certification.begin(), certification.end(),
+                       certification.begin(), ::toupper);
+
+        double font_scale = CERTIFICATION_FONT_SCALE * scale;
+        cv::Size text = GetTextSize(certification, font_scale,
+                                    0.85 * size.width, thickness);
+        int height = text.height + static_cast<int>(0.06 * size.height);
+        int bottom = static_cast<int>((painted ? LABEL_TOP : LABEL_TOP + LABEL_HEIGHT) *
+                                      size.height);
+        cv::Rect bar(static_cast<int>(0.04 * size.width), bottom - height,
+                     static_cast<int>(0.92 * size.width), height);
+        cv::rectangle(tile, bar, CERTIFICATION_BAR_COLOR, cv::FILLED);
+        DrawCenteredText(tile, certification, bar.y + height / 2, font_scale,
+                         0.85 * size.width, thickness, CERTIFICATION_TEXT_COLOR);
+    }
+
+    DrawCenteredText(tile, item.GetName(),
+                     static_cast<int>(NAME_CENTER * size.height),
+                     NAME_FONT_SCALE * scale, 0.92 * size.width, thickness,
+                     GetRarityColor(item.GetRarity()));
+    return tile;
+}
+
+// Draws random overlapping shapes where the item's picture would be
+void TileRenderer::DrawItemArt(cv::Mat& tile) {
+    std::uniform_real_distribution<double> unit(0, 1);
+    std::uniform_int_distribution<int> channel(40, 220);
+
+    for (int i = 0; i < ART_SHAPES; i++) {
+        cv::Point center(static_cast<int>((0.2 + 0.6 * unit(random_)) * tile.cols),
+                         static_cast<int>((0.15 + 0.35 * unit(random_)) * tile.rows));
+        cv::Size axes(static_cast<int>((0.05 + 0.15 * unit(random_)) * tile.cols),
+                      static_cast<int>((0.05 + 0.1 * unit(random_)) * tile.rows));
+        cv::Scalar color(channel(random_), channel(random_), channel(random_));
+        cv::ellipse(tile, center, axes, 180 * unit(random_), 0, 360, color,
+                    cv::FILLED, cv::LINE_AA);
+    }
+}
+
+// Draws text centered on a row, shrunk to fit max_width
+void TileRenderer::DrawCenteredText(cv::Mat& tile, const std::string& text,
+                                    int center_y, double font_scale,
+                                    double max_width, int thickness,
+                                    const cv::Scalar& color) const {
+    cv::Size size = GetTextSize(text, font_scale, max_width, thickness);
+    cv::Point origin((tile.cols - size.width) / 2, center_y + size.height / 2);
+    cv::putText(tile, text, origin, FONT, font_scale, color, thickness,
+                cv::LINE_AA);
+}
+
+// Measures text, shrinking font_scale until it fits
+cv::Size TileRenderer::GetTextSize(const std::string& text, double& font_scale,
+                                   double max_width, int thickness) const {
+    int baseline = 0;
+    cv::Size size = cv::getTextSize(text, FONT, font_scale, thickness, &baseline);
+    if (size.width > max_width) {
+        font_scale *= max_width / size.width;
+        size = cv::getTextSize(text, FONT, font_scale, thickness, &baseline);
+    }
+    return size;
+}
+
+// Returns the color an item name is written in
+cv::Scalar TileRenderer::GetRarityColor(const std::string& rarity) const {
+    for (const RarityColor& color : RARITY_COLORS) {
+        if (rarity == color.rarity)
+            return cv::Scalar(color.blue, color.green, color.red);
+    }
+    return cv::Scalar(230, 230, 230);
+}
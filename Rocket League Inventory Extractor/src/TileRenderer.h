@@ -0,0 +1,48 @@
+#pragma once
+
+/* Rocket League Synthetic Item Tile Renderer
+by Ridas Jagelavicius
+*/
+
+#include <random>
+#include <string>
+#include <opencv2/opencv.hpp>
+
+#include "InventoryItem.h"
+#include "PaintDetector.h"
+
+class TileRenderer {
+   public:
+    /** Custom constructor
+        @param seed - The seed of the random number generator, so the same tiles can be rendered again
+    */
+    TileRenderer(unsigned seed);
+
+    /** Renders an item tile laid out like the in-game inventory
+        The tile has a dark background with randomly generated item art, a certification
+        bar and a colored paint label (if the item has them) and the item name in the
+        color of its rarity. Text is shrunk to fit the tile when it is too long.
+        @param item - The item to render. Only its name, certification, paint and rarity are used
+        @param scale - The size of the tile relative to an in-game tile at 1080p (ex. 2 for 4K)
+        @return A BGR image of the tile
+    */
+    cv::Mat RenderTile(const InventoryItem& item, double scale = 1.0);
+
+    /** Returns the size of a tile rendered at a scale
+        @param scale - The size of the tile relative to an in-game tile at 1080p
+        @return The width and height of the tile in pixels
+    */
+    cv::Size GetTileSize(double scale) const;
+
+   private:
+    PaintDetector paints_; // Holds the color of every paint label
+    std::mt19937 random_; // Drives the background and item art
+
+    void DrawItemArt(cv::Mat& tile); // Draws random overlapping shapes where the item's picture would be
+    void DrawCenteredText(cv::Mat& tile, const std::string& text, int center_y,
+                          double font_scale, double max_width, int thickness,
+                          const cv::Scalar& color) const; // Draws text centered on a row, shrunk to fit max_width
+    cv::Size GetTextSize(const std::string& text, double& font_scale,
+                         double max_width, int thickness) const; // Measures text, shrinking font_scale until it fits
+    cv::Scalar GetRarityColor(const std::string& rarity) const; // Returns the color an item name is written in
+};
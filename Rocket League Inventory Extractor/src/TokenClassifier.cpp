@@ -0,0 +1,189 @@
+/* Rocket League Extracted Text Token Classifier
+by Ridas Jagelavicius
+*/
+
+#include <algorithm>
+#include <cstdint>
+
+#include "TextNormalizer.h"
+#include "TokenClassifier.h"
+
+// A word with special meaning and what it stands for
+struct Vocabulary {
+    const char* token; // The normalized word
+    TokenKind kind; // What the word describes
+    const char* canonical; // The paint or certification the word stands for, or nullptr
+};
+
+constexpr Vocabulary VOCABULARY[] = {
+    {"black", TokenKind::Paint, "Black"},
+    {"white", TokenKind::Paint, "White"},
+    {"grey", TokenKind::Paint, "Grey"},
+    {"crimson", TokenKind::Paint, "Crimson"},
+    {"pink", TokenKind::Paint, "Pink"},
+    {"cobalt", TokenKind::Paint, "Cobalt"},
+    {"blue", TokenKind::Paint, "Sky Blue"},
+    {"sienna", TokenKind::Paint, "Burnt Sienna"},
+    {"saffron", TokenKind::Paint, "Saffron"},
+    {"lime", TokenKind::Paint, "Lime"},
+    {"green", TokenKind::Paint, "Forest Green"},
+    {"orange", TokenKind::Paint, "Orange"},
+    {"purple", TokenKind::Paint, "Purple"},
+    {"burnt", TokenKind::PaintModifier, nullptr},
+    {"forest", TokenKind::PaintModifier, nullptr},
+    {"sky", TokenKind::PaintModifier, nullptr},
+    {"striker", TokenKind::Certification, "Striker"},
+    {"scorer", TokenKind::Certification, "Scorer"},
+    {"tactician", TokenKind::Certification, "Tactician"},
+    {"sweeper", TokenKind::Certification, "Sweeper"},
+    {"victor", TokenKind::Certification, "Victor"},
+    {"aviator", TokenKind::Certification, "Aviator"},
+    {"playmaker", TokenKind::Certification, "Playmaker"},
+    {"goalkeeper", TokenKind::Certification, "Goalkeeper"},
+    {"sniper", TokenKind::Certification, "Sniper"},
+    {"paragon", TokenKind::Certification, "Paragon"},
+    {"guardian", TokenKind::Certification, "Guardian"},
+    {"acrobat", TokenKind::Certification, "Acrobat"},
+    {"juggler", TokenKind::Certification, "Juggler"},
+    {"showoff", TokenKind::Certification, "Show-Off"},  // Normalizing removes the hyphen
+    {"turtle", TokenKind::Certification, "Turtle"},
+    {"certified", TokenKind::CertificationModifier, nullptr},
+    {"capable", TokenKind::CertificationModifier, nullptr},
+    {"skillfull", TokenKind::CertificationModifier, nullptr},
+    {"veteran", TokenKind::CertificationModifier, nullptr},
+    {"fantastic", TokenKind::CertificationModifier, nullptr},
+    {"incredible", TokenKind::CertificationModifier, nullptr},
+    {"ridiculous", TokenKind::CertificationModifier, nullptr},
+    {"daring", TokenKind::CertificationModifier, nullptr},
+    {"determined", TokenKind::CertificationModifier, nullptr}};
+
+constexpr int VOCABULARY_SIZE = sizeof(VOCABULARY) / sizeof(VOCABULARY[0]);
+constexpr int TABLE_BITS = 7;  // The table has 2^TABLE_BITS slots
+constexpr int TABLE_SIZE = 1 << TABLE_BITS;
+constexpr uint32_t HASH_SEED = 500;  // Found by searching for a seed that gives every word its own slot
+
+// Hashes a word with seeded 32-bit FNV-1a and returns its slot from the high bits
+constexpr int HashToSlot(const char* word, size_t length) {
+    uint32_t hash = 2166136261u ^ HASH_SEED;
+    for (size_t i = 0; i < length; i++) {
+        hash ^= static_cast<unsigned char>(word[i]);
+        hash *= 16777619u;
+    }
+    return static_cast<int>(hash >> (32 - TABLE_BITS));
+}
+
+// Returns the length of a string literal
+constexpr size_t Length(const char* word) {
+    size_t length = 0;
+    while (word[length] != '\0') length++;
+    return length;
+}
+
+// The index in VOCABULARY of the word in each slot, or -1 for an empty slot
+struct SlotTable {
+    int slots[TABLE_SIZE];
+};
+
+// Builds the slot table at compile time
+constexpr SlotTable BuildTable() {
+    SlotTable table{};
+    for (int i = 0; i < TABLE_SIZE; i++) table.slots[i] = -1;
+    for (int i = 0; i < VOCABULARY_SIZE; i++) {
+        const char* token = VOCABULARY[i].token;
+        table.slots[HashToSlot(token, Length(token))] = i;
+    }
+    return table;
+}
+
+// Returns whether every word in VOCABULARY was given its own slot
+constexpr bool IsPerfect(const SlotTable& table) {
+    int filled = 0;
+    for (int i = 0; i < TABLE_SIZE; i++) filled += table.slots[i] >= 0;
+    return filled == VOCABULARY_SIZE;
+}
+
+constexpr SlotTable TABLE = BuildTable();
+static_assert(IsPerfect(TABLE),
+              "Two words share a slot; choose a new HASH_SEED after changing VOCABULARY");
+
+// Normalizes an extracted word for matching
+std::string NormalizeToken(const std::string& token) {
+    return NormalizeText(token, NormalizationMode::Word);
+}
+
+// Classifies a single normalized word
+TokenKind ClassifyToken(const std::string& normalized_token, std::string& canonical) {
+    int index = TABLE.slots[HashToSlot(normalized_token.data(), normalized_token.size())];
+    if (index < 0 || normalized_token != VOCABULARY[index].token)
+        return TokenKind::NameWord;
+
+    if (VOCABULARY[index].canonical != nullptr)
+        canonical = VOCABULARY[index].canonical;
+    return VOCABULARY[index].kind;
+}
+
+// Lists every paint, certification and modifier as it is written on a tile
+std::vector<std::string> GetTraitNames() {
+    std::vector<std::string> names;
+    for (const Vocabulary& word : VOCABULARY) {
+        // Modifiers have no canonical name, so their word is capitalized instead
+        std::string name = word.canonical != nullptr ? word.canonical : word.token;
+        if (word.canonical == nullptr) name[0] = static_cast<char>(name[0] - 'a' + 'A');
+
+        if (std::find(names.begin(), names.end(), name) == names.end())
+            names.push_back(name);
+    }
+    return names;
+}
+
+// Sorts every extracted word into paint, certification and name words in a single pass
+ClassifiedTokens ClassifyTokens(const std::vector<std::string>& extracted,
+                                const std::vector<float>& confidences) {
+    ClassifiedTokens tokens;
+    tokens.name_words.reserve(extracted.size());
+    tokens.normalized_name_words.reserve(extracted.size());
+    bool found_paint = false;
+    bool found_certification = false;
+    float total_confidence = 0;
+    float name_confidence = 0;
+
+    // One buffer is reused for every word, so only name words allocate
+    std::string normalized;
+    for (size_t i = 0; i < extracted.size(); ++i) {
+        const std::string& word = extracted[i];
+        float confidence = i < confidences.size() ? confidences[i] : 0.0f;
+        total_confidence += confidence;
+        NormalizeText(word, NormalizationMode::Word, normalized);
+        std::string canonical;
+
+        switch (ClassifyToken(normalized, canonical)) {
+            case TokenKind::Paint:
+                tokens.paint = canonical;
+                tokens.paint_confidence = confidence;
+                found_paint = true;
+                break;
+            case TokenKind::Certification:
+                tokens.certification = canonical;
+                tokens.certification_confidence = confidence;
+                found_certification = true;
+                break;
+            case TokenKind::PaintModifier:
+            case TokenKind::CertificationModifier:
+                break;
+            case TokenKind::NameWord:
+                tokens.name_words.push_back(word);
+                tokens.normalized_name_words.push_back(normalized);
+                name_confidence += confidence;
+                break;
+        }
+    }
+
+    if (!tokens.name_words.empty())
+        tokens.name_confidence = name_confidence / tokens.name_words.size();
+    if (!extracted.empty()) {
+        float mean_confidence = total_confidence / extracted.size();
+        if (!found_paint) tokens.paint_confidence = mean_confidence;
+        if (!found_certification) tokens.certification_confidence = mean_confidence;
+    }
+    return tokens;
+}
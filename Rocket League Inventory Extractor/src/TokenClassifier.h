@@ -0,0 +1,62 @@
+#pragma once
+
+/* Rocket League Extracted Text Token Classifier
+by Ridas Jagelavicius
+*/
+
+#include <string>
+#include <vector>
+
+// What a single word extracted from an item tile describes
+enum class TokenKind {
+    Paint,                  // A paint or the distinguishing word of one ex. cobalt, sienna
+    PaintModifier,          // The first word of a two-word paint ex. burnt, sky
+    Certification,          // A base certification ex. paragon
+    CertificationModifier,  // A certification tier ex. capable
+    NameWord                // Anything else, which is taken to be part of the item name
+};
+
+// Every trait found in the words extracted from an item tile
+struct ClassifiedTokens {
+    std::string paint = "Default"; // The paint of the item ex. Burnt Sienna, or Default if no paint was found
+    std::string certification; // The base certification of the item ex. Show-Off, or an empty string
+    std::vector<std::string> name_words; // The words of the item name, as extracted
+    std::vector<std::string> normalized_name_words; // The words of the item name after NormalizeToken()
+    float paint_confidence = 0; // How sure the recognizer was of the paint word, from 0 to 1
+    float certification_confidence = 0; // How sure the recognizer was of the certification word, from 0 to 1
+    float name_confidence = 0; // The mean confidence of the name words, from 0 to 1
+};
+
+/** Normalizes an extracted word for matching with NormalizeText() in Word mode
+    Removes OCR noise such as [ or :, removes hyphens along with a space directly after
+    one (so "Octane - MG-88" becomes "octane mg88") and converts to lowercase
+    @param token - A word or phrase extracted from an image
+    @return The normalized word or phrase
+*/
+std::string NormalizeToken(const std::string& token);
+
+/** Classifies a single normalized word
+    Words are looked up in a perfect hash table built at compile time, so each lookup
+    hashes the word once and compares at most one string
+    @param normalized_token - A word normalized with NormalizeToken()
+    @param canonical - Set to the full paint or certification the word stands for
+                       ex. Burnt Sienna for sienna, or left unchanged for name words and modifiers
+    @return What the word describes
+*/
+TokenKind ClassifyToken(const std::string& normalized_token, std::string& canonical);
+
+/** Lists every paint, certification and modifier as it is written on a tile
+    @return Each paint and certification ex. Burnt Sienna or Show-Off, and each modifier capitalized ex. Capable
+*/
+std::vector<std::string> GetTraitNames();
+
+/** Sorts every extracted word into paint, certification and name words in a single pass
+    Each word is normalized once. When several paints or certifications are found the last one is kept.
+    A paint or certification that was not found gets the mean confidence of every word, since that
+    is how sure the recognizer was that it did not miss one
+    @param extracted - The words extracted by ItemClassifier::ExtractText()
+    @param confidences - The recognizer's confidence in each word from 0 to 1, or empty to leave every confidence 0
+    @return The paint, certification and remaining name words
+*/
+ClassifiedTokens ClassifyTokens(const std::vector<std::string>& extracted,
+                                const std::vector<float>& confidences = std::vector<float>());
@@ -0,0 +1,168 @@
+/* Rocket League OCR Token Recording
+by Ridas Jagelavicius
+*/
+
+#include <algorithm>
+#include <cstring>
+
+#include "TokenRecording.h"
+
+constexpr char RECORDING_MAGIC[8] = {'R', 'L', 'T', 'O', 'K', 'E', 'N', 'S'};  // Starts every recording
+constexpr uint32_t RECORDING_VERSION = 1;  // Raised whenever the layout of a record changes
+constexpr uint32_t MAX_STRING_BYTES = 1 << 16;  // Longer strings mean the recording is damaged
+constexpr uint32_t MAX_COUNT = 1 << 20;  // More passes or words than this mean the recording is damaged
+
+// Writes an unsigned integer as 4 little endian bytes, so recordings move between machines
+static void WriteUint32(std::ostream& output, uint32_t value) {
+    char bytes[4];
+    for (int i = 0; i < 4; i++) bytes[i] = static_cast<char>((value >> (8 * i)) & 0xFF);
+    output.write(bytes, 4);
+}
+
+// Writes a signed integer as 4 little endian bytes
+static void WriteInt32(std::ostream& output, int value) {
+    WriteUint32(output, static_cast<uint32_t>(value));
+}
+
+// Writes a float as the 4 little endian bytes of its bits
+static void WriteFloat(std::ostream& output, float value) {
+    uint32_t bits;
+    std::memcpy(&bits, &value, sizeof(bits));
+    WriteUint32(output, bits);
+}
+
+// Writes a string as its length followed by its bytes
+static void WriteString(std::ostream& output, const std::string& text) {
+    uint32_t length = static_cast<uint32_t>(std::min<size_t>(text.size(), MAX_STRING_BYTES));
+    WriteUint32(output, length);
+    output.write(text.data(), length);
+}
+
+// Reads an unsigned integer written by WriteUint32()
+static bool ReadUint32(std::istream& input, uint32_t& value) {
+    unsigned char bytes[4];
+    if (!input.read(reinterpret_cast<char*>(bytes), 4)) return false;
+    value = 0;
+    for (int i = 0; i < 4; i++) value |= static_cast<uint32_t>(bytes[i]) << (8 * i);
+    return true;
+}
+
+// Reads a signed integer written by WriteInt32()
+static bool ReadInt32(std::istream& input, int& value) {
+    uint32_t bits;
+    if (!ReadUint32(input, bits)) return false;
+    value = static_cast<int>(bits);
+    return true;
+}
+
+// Reads a float written by WriteFloat()
+static bool ReadFloat(std::istream& input, float& value) {
+    uint32_t bits;
+    if (!ReadUint32(input, bits)) return false;
+    std::memcpy(&value, &bits, sizeof(value));
+    return true;
+}
+
+// Reads a string written by WriteString()
+static bool ReadString(std::istream& input, std::string& text) {
+    uint32_t length;
+    if (!ReadUint32(input, length) || length > MAX_STRING_BYTES) return false;
+    text.resize(length);
+    return length == 0 || static_cast<bool>(input.read(&text[0], length));
+}
+
+// Custom constructor - creates (or replaces) a recording
+TokenRecordWriter::TokenRecordWriter(const std::string& path_to_file)
+    : output_(path_to_file, std::ios::binary | std::ios::trunc), count_(0) {
+    output_.write(RECORDING_MAGIC, sizeof(RECORDING_MAGIC));
+    WriteUint32(output_, RECORDING_VERSION);
+}
+
+// Returns whether the recording could be created
+bool TokenRecordWriter::IsOpen() const {
+    return output_.is_open() && static_cast<bool>(output_);
+}
+
+// Appends a record to the recording
+bool TokenRecordWriter::Write(const TokenRecord& record) {
+    if (!IsOpen()) return false;
+
+    WriteString(output_, record.image_id);
+    WriteInt32(output_, record.image_width);
+    WriteInt32(output_, record.image_height);
+    WriteString(output_, record.label_paint);
+    WriteFloat(output_, record.label_confidence);
+
+    WriteUint32(output_, static_cast<uint32_t>(record.passes.size()));
+    for (const RecordedPass& pass : record.passes) {
+        output_.put(static_cast<char>(pass.step));
+        WriteUint32(output_, static_cast<uint32_t>(pass.words.size()));
+        for (const RecordedWord& word : pass.words) {
+            WriteString(output_, word.text);
+            WriteFloat(output_, word.confidence);
+            WriteInt32(output_, word.x);
+            WriteInt32(output_, word.y);
+            WriteInt32(output_, word.width);
+            WriteInt32(output_, word.height);
+        }
+    }
+
+    if (!output_) return false;
+    count_++;
+    return true;
+}
+
+// Returns the number of records written so far
+uint64_t TokenRecordWriter::GetCount() const {
+    return count_;
+}
+
+// Custom constructor - opens a recording written by TokenRecordWriter
+TokenRecordReader::TokenRecordReader(const std::string& path_to_file)
+    : input_(path_to_file, std::ios::binary), valid_(false) {
+    char magic[sizeof(RECORDING_MAGIC)];
+    uint32_t version;
+    valid_ = input_.read(magic, sizeof(magic)) &&
+             std::memcmp(magic, RECORDING_MAGIC, sizeof(magic)) == 0 &&
+             ReadUint32(input_, version) && version == RECORDING_VERSION;
+}
+
+// Returns whether the file could be opened and is a recording
+bool TokenRecordReader::IsOpen() const {
+    return valid_;
+}
+
+// Reads the next record
+bool TokenRecordReader::Next(TokenRecord& record) {
+    if (!valid_) return false;
+
+    // The end of the file is only clean between records
+    if (input_.peek() == std::char_traits<char>::eof()) return false;
+
+    uint32_t pass_count;
+    valid_ = ReadString(input_, record.image_id) && ReadInt32(input_, record.image_width) &&
+             ReadInt32(input_, record.image_height) &&
+             ReadString(input_, record.label_paint) &&
+             ReadFloat(input_, record.label_confidence) && ReadUint32(input_, pass_count) &&
+             pass_count <= MAX_COUNT;
+    if (!valid_) return false;
+
+    record.passes.resize(pass_count);
+    for (RecordedPass& pass : record.passes) {
+        int step = input_.get();
+        uint32_t word_count;
+        valid_ = step >= 0 && step <= static_cast<int>(RecordedStep::EnhancedTextBoxes) &&
+                 ReadUint32(input_, word_count) && word_count <= MAX_COUNT;
+        if (!valid_) return false;
+        pass.step = static_cast<RecordedStep>(step);
+
+        pass.words.resize(word_count);
+        for (RecordedWord& word : pass.words) {
+            valid_ = ReadString(input_, word.text) && ReadFloat(input_, word.confidence) &&
+                     ReadInt32(input_, word.x) && ReadInt32(input_, word.y) &&
+                     ReadInt32(input_, word.width) && ReadInt32(input_, word.height);
+            if (!valid_) return false;
+        }
+    }
+    return true;
+}
@@ -0,0 +1,96 @@
+#pragma once
+
+/* Rocket League OCR Token Recording
+by Ridas Jagelavicius
+*/
+
+#include <cstdint>
+#include <fstream>
+#include <string>
+#include <vector>
+
+// The step of ItemClassifier::Classify() that read a set of words
+enum class RecordedStep : uint8_t {
+    TextBand = 0, // The fixed text band of a tile, read in one pass
+    TextBoxes = 1, // Each text box detected by EAST
+    EnhancedTextBoxes = 2 // The same boxes, enlarged and binarized
+};
+
+// A word as Tesseract read it, with where it was read from
+struct RecordedWord {
+    std::string text; // The raw text of the word, before normalization
+    float confidence = 0; // How sure Tesseract was of the word, from 0 to 1
+    int x = 0; // The region the word was read from (the text box or band), in image pixels
+    int y = 0;
+    int width = 0;
+    int height = 0;
+};
+
+// Every word read by one step, in reading order
+struct RecordedPass {
+    RecordedStep step = RecordedStep::TextBand; // The step that read the words
+    std::vector<RecordedWord> words; // The words the step read
+};
+
+// The recognition output of one image, enough to run matching again without the image
+struct TokenRecord {
+    std::string image_id; // Identifies the image to whoever replays it ex. its file name
+    int image_width = 0; // The size of the image the words were read from
+    int image_height = 0;
+    std::string label_paint; // The paint read from the pixels of the paint label, or an empty string
+    float label_confidence = 0; // How much of the paint label the paint filled
+    std::vector<RecordedPass> passes; // Every step that ran, in the order it ran
+};
+
+class TokenRecordWriter {
+   public:
+    /** Custom constructor - creates (or replaces) a recording
+        Records are written in a compact binary form, about the size of the text they hold
+        @param path_to_file - The full file path to write the recording to
+    */
+    explicit TokenRecordWriter(const std::string& path_to_file);
+
+    /** Returns whether the recording could be created
+        @return Whether Write() can save records
+    */
+    bool IsOpen() const;
+
+    /** Appends a record to the recording
+        @param record - The record to write
+        @return Whether the record was written
+    */
+    bool Write(const TokenRecord& record);
+
+    /** Returns the number of records written so far
+        @return The number of successful calls to Write()
+    */
+    uint64_t GetCount() const;
+
+   private:
+    std::ofstream output_; // The recording being written
+    uint64_t count_; // The number of records written
+};
+
+class TokenRecordReader {
+   public:
+    /** Custom constructor - opens a recording written by TokenRecordWriter
+        Records are read one at a time, so recordings of any size take little memory
+        @param path_to_file - The full file path to the recording
+    */
+    explicit TokenRecordReader(const std::string& path_to_file);
+
+    /** Returns whether the file could be opened and is a recording
+        @return Whether Next() can read records
+    */
+    bool IsOpen() const;
+
+    /** Reads the next record
+        @param record - Set to the next record
+        @return Whether a record was read; false at the end of the recording or at a damaged record
+    */
+    bool Next(TokenRecord& record);
+
+   private:
+    std::ifstream input_; // The recording being read
+    bool valid_; // Whether the file is a recording and no damaged record has been read
+};
@@ -0,0 +1,204 @@
+/* Rocket League Visual Index of Classified Tiles
+by Ridas Jagelavicius
+*/
+
+#include <cstdlib>
+#include <fstream>
+#include <iomanip>
+#include <sstream>
+#include <opencv2/imgproc.hpp>
+
+#include "ImageHash.h"
+#include "VisualIndex.h"
+
+constexpr int COLOR_GRID = 4;  // Colors are compared on a COLOR_GRID x COLOR_GRID thumbnail
+constexpr float TEXT_BAND_TOP = .50;  // A tile's certification, paint label and name all lie below this fraction of its height, as in ItemClassifier.cpp
+constexpr int BAND_PIXEL_DIFFERENCE = 32;  // A text band pixel differs if its gray levels are further apart than this
+constexpr int MAX_BAND_PIXELS = 4;  // The most text band pixels that may differ in a match; compression noise changes about 1, another certification at least 12
+
+// Custom constructor
+VisualIndex::VisualIndex(int max_distance, int max_color_difference)
+    : max_distance_(max_distance), max_color_difference_(max_color_difference) {
+    /* Nothing */
+}
+
+// Computes the signature of a tile
+TileSignature VisualIndex::ComputeSignature(const cv::Mat& tile) {
+    TileSignature signature;
+    if (tile.empty() || tile.channels() != 3) return signature;
+
+    signature.perceptual_hash = PerceptualHash(tile);
+    signature.difference_hash = DifferenceHash(tile);
+
+    cv::Mat thumbnail;
+    cv::resize(tile, thumbnail, cv::Size(COLOR_GRID, COLOR_GRID), 0, 0, cv::INTER_AREA);
+    for (int y = 0; y < COLOR_GRID; ++y) {
+        const unsigned char* row = thumbnail.ptr<unsigned char>(y);
+        for (int x = 0; x < COLOR_GRID * 3; ++x)
+            signature.colors[y * COLOR_GRID * 3 + x] = row[x];
+    }
+
+    // The band keeps enough detail to read a short word, so another certification is not missed
+    cv::Mat gray, band;
+    int top = static_cast<int>(TEXT_BAND_TOP * tile.rows);
+    cv::cvtColor(tile.rowRange(top, tile.rows), gray, cv::COLOR_BGR2GRAY);
+    cv::resize(gray, band, cv::Size(TEXT_BAND_WIDTH, TEXT_BAND_HEIGHT), 0, 0, cv::INTER_AREA);
+    for (int y = 0; y < TEXT_BAND_HEIGHT; ++y) {
+        const unsigned char* row = band.ptr<unsigned char>(y);
+        for (int x = 0; x < TEXT_BAND_WIDTH; ++x)
+            signature.text_band[y * TEXT_BAND_WIDTH + x] = row[x];
+    }
+    return signature;
+}
+
+// Finds the closest classified tile that looks the same as a tile
+bool VisualIndex::Lookup(const TileSignature& signature,
+                         ClassificationResult& result) const {
+    if (IsEmpty(signature)) return false;
+
+    std::lock_guard<std::mutex> lock(mutex_);
+    int closest = FindClosest(signature);
+    if (closest < 0) return false;
+
+    result = entries_[closest].result;
+    return true;
+}
+
+// Adds a classified tile to the index, unless a matching tile is already in it
+void VisualIndex::Add(const TileSignature& signature,
+                      const ClassificationResult& result) {
+    if (IsEmpty(signature)) return;
+
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (FindClosest(signature) >= 0) return;
+    entries_.push_back({signature, result});
+}
+
+// Returns the number of tiles in the index
+size_t VisualIndex::GetSize() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return entries_.size();
+}
+
+// Saves the index to a file so it can be loaded by a later run
+bool VisualIndex::WriteToFile(const std::string& path_to_file) const {
+    std::ofstream output(path_to_file);
+    if (!output) return false;
+
+    // One tab separated line per tile: both hashes, the colors, the text band, then the result
+    std::lock_guard<std::mutex> lock(mutex_);
+    for (const Entry& entry : entries_) {
+        output << std::hex << entry.signature.perceptual_hash << '\t'
+               << entry.signature.difference_hash << '\t' << std::setfill('0');
+        for (uint8_t color : entry.signature.colors)
+            output << std::setw(2) << static_cast<int>(color);
+        output << '\t';
+        for (uint8_t pixel : entry.signature.text_band)
+            output << std::setw(2) << static_cast<int>(pixel);
+        output << std::dec << std::setfill(' ') << '\t' << entry.result.name
+               << '\t' << entry.result.paint << '\t'
+               << entry.result.certification << '\t'
+               << entry.result.name_confidence << '\t'
+               << entry.result.paint_confidence << '\t'
+               << entry.result.certification_confidence << '\n';
+    }
+    return static_cast<bool>(output);
+}
+
+// Adds every tile saved by WriteToFile() to the index
+bool VisualIndex::ReadFromFile(const std::string& path_to_file) {
+    std::ifstream input(path_to_file);
+    if (!input) return false;
+
+    std::string line;
+    while (std::getline(input, line)) {
+        if (!line.empty() && line.back() == '\r') line.pop_back();
+
+        std::stringstream fields(line);
+        std::string perceptual_hash, difference_hash, colors, text_band;
+        std::string confidences[3];
+        Entry entry;
+        std::getline(fields, perceptual_hash, '\t');
+        std::getline(fields, difference_hash, '\t');
+        std::getline(fields, colors, '\t');
+        std::getline(fields, text_band, '\t');
+        std::getline(fields, entry.result.name, '\t');
+        std::getline(fields, entry.result.paint, '\t');
+        std::getline(fields, entry.result.certification, '\t');
+        for (std::string& confidence : confidences)
+            std::getline(fields, confidence, '\t');
+
+        // Skip lines that were cut short or written before tiles had a text band
+        if (colors.size() != entry.signature.colors.size() * 2 ||
+            text_band.size() != entry.signature.text_band.size() * 2)
+            continue;
+        try {
+            entry.signature.perceptual_hash = std::stoull(perceptual_hash, nullptr, 16);
+            entry.signature.difference_hash = std::stoull(difference_hash, nullptr, 16);
+            for (size_t i = 0; i < entry.signature.colors.size(); ++i)
+                entry.signature.colors[i] = static_cast<uint8_t>(
+                    std::stoi(colors.substr(i * 2, 2), nullptr, 16));
+            for (size_t i = 0; i < entry.signature.text_band.size(); ++i)
+                entry.signature.text_band[i] = static_cast<uint8_t>(
+                    std::stoi(text_band.substr(i * 2, 2), nullptr, 16));
+
+            // Files written before results had confidences leave them at 0
+            if (!confidences[2].empty()) {
+                entry.result.name_confidence = std::stof(confidences[0]);
+                entry.result.paint_confidence = std::stof(confidences[1]);
+                entry.result.certification_confidence = std::stof(confidences[2]);
+            }
+        } catch (const std::exception&) {
+            continue;
+        }
+
+        std::lock_guard<std::mutex> lock(mutex_);
+        entries_.push_back(entry);
+    }
+    return true;
+}
+
+// Returns the index of the closest matching entry, or -1
+int VisualIndex::FindClosest(const TileSignature& signature) const {
+    int closest = -1;
+    int closest_distance = 2 * 64 + 1;
+
+    // Hamming distances are a few instructions each, so a linear scan handles
+    // thousands of tiles in microseconds
+    for (size_t i = 0; i < entries_.size(); ++i) {
+        const TileSignature& candidate = entries_[i].signature;
+        int perceptual = HammingDistance(signature.perceptual_hash, candidate.perceptual_hash);
+        if (perceptual > max_distance_) continue;
+        int difference = HammingDistance(signature.difference_hash, candidate.difference_hash);
+        if (difference > max_distance_) continue;
+
+        bool same_colors = true;
+        for (size_t c = 0; c < signature.colors.size() && same_colors; ++c)
+            same_colors = std::abs(signature.colors[c] - candidate.colors[c]) <=
+                          max_color_difference_;
+        if (!same_colors) continue;
+
+        // Only the text band can tell certifications apart, so it is compared last
+        int differing_pixels = 0;
+        for (size_t p = 0; p < signature.text_band.size() && differing_pixels <= MAX_BAND_PIXELS; ++p)
+            differing_pixels += std::abs(signature.text_band[p] - candidate.text_band[p]) >
+                                BAND_PIXEL_DIFFERENCE;
+        if (differing_pixels > MAX_BAND_PIXELS) continue;
+
+        if (perceptual + difference < closest_distance) {
+            closest = static_cast<int>(i);
+            closest_distance = perceptual + difference;
+        }
+    }
+    return closest;
+}
+
+// Returns whether a signature is all zeros, as ComputeSignature() returns for an unusable tile
+bool VisualIndex::IsEmpty(const TileSignature& signature) {
+    if (signature.perceptual_hash != 0 || signature.difference_hash != 0) return false;
+    for (uint8_t color : signature.colors)
+        if (color != 0) return false;
+    for (uint8_t pixel : signature.text_band)
+        if (pixel != 0) return false;
+    return true;
+}
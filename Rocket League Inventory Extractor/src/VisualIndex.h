@@ -0,0 +1,91 @@
+#pragma once
+
+/* Rocket League Visual Index of Classified Tiles
+by Ridas Jagelavicius
+*/
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <vector>
+#include <opencv2/opencv.hpp>
+
+#include "ItemClassifier.h"
+
+constexpr int TEXT_BAND_WIDTH = 96;  // The width the text band of a tile is shrunk to for its signature
+constexpr int TEXT_BAND_HEIGHT = 48;  // The height the text band of a tile is shrunk to, enough to tell certifications apart
+
+// What a tile looks like, in a form that survives compression noise
+struct TileSignature {
+    uint64_t perceptual_hash = 0; // PerceptualHash() of the tile
+    uint64_t difference_hash = 0; // DifferenceHash() of the tile
+    std::array<uint8_t, 48> colors{}; // The tile shrunk to 4x4 BGR pixels, since both hashes ignore color
+    std::array<uint8_t, TEXT_BAND_WIDTH * TEXT_BAND_HEIGHT> text_band{}; // The lower half of the tile (certification, paint label and name) in gray, since the hashes are too coarse to read words
+};
+
+class VisualIndex {
+   public:
+    /** Custom constructor
+        @param max_distance - How many bits each hash of a tile may differ by and still match
+        @param max_color_difference - How far (0-255) any of the 4x4 colors may differ and still match
+    */
+    VisualIndex(int max_distance = 4, int max_color_difference = 24);
+
+    /** Computes the signature of a tile
+        @param tile - A BGR image of a single rocket league item
+        @return The signature of the tile, which is all zeros if the tile is empty or not BGR
+    */
+    static TileSignature ComputeSignature(const cv::Mat& tile);
+
+    /** Finds the closest classified tile that looks the same as a tile
+        A tile matches only if both of its hashes and its colors are within the limits given to
+        the constructor and almost none of its text band's pixels differ, so the same item in a
+        different paint or with a different certification does not match
+        @param signature - The signature of the tile to look up
+        @param result - Set to the result of the closest matching tile if one was found
+        @return Whether a matching tile was found, which is never the case for an all zero signature
+    */
+    bool Lookup(const TileSignature& signature, ClassificationResult& result) const;
+
+    /** Adds a classified tile to the index, unless a matching tile is already in it
+        An all zero signature is ignored, since every unusable tile has it
+        @param signature - The signature of the classified tile
+        @param result - The result of classifying the tile
+    */
+    void Add(const TileSignature& signature, const ClassificationResult& result);
+
+    /** Returns the number of tiles in the index
+        @return The number of indexed tiles
+    */
+    size_t GetSize() const;
+
+    /** Saves the index to a file so it can be loaded by a later run
+        @param path_to_file - The file to write
+        @return Whether the file could be written
+    */
+    bool WriteToFile(const std::string& path_to_file) const;
+
+    /** Adds every tile saved by WriteToFile() to the index
+        Tiles saved before signatures had a text band are skipped, as they could match another certification
+        @param path_to_file - The file to read
+        @return Whether the file exists and could be read
+    */
+    bool ReadFromFile(const std::string& path_to_file);
+
+   private:
+    // A classified tile
+    struct Entry {
+        TileSignature signature;
+        ClassificationResult result;
+    };
+
+    int max_distance_; // How many bits each hash may differ by
+    int max_color_difference_; // How far any of the 4x4 colors may differ
+    std::vector<Entry> entries_; // Every indexed tile
+    mutable std::mutex mutex_; // Guards entries_, so one index can be shared between classifiers
+
+    int FindClosest(const TileSignature& signature) const; // Returns the index of the closest matching entry, or -1
+    static bool IsEmpty(const TileSignature& signature); // Returns whether a signature is all zeros
+};
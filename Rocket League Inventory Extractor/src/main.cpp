@@ -3,6 +3,7 @@
 
 #include <string>
 
+#include "DetectionWriter.h"
 #include "ItemClassifier.h"
 #include "ItemDatabase.h"
 #include "Inventory.h"
@@ -32,6 +33,7 @@ int main() {
  ItemClassifier classifier(path_to_model_for_text_detection, path_to_database); // Extracts item info from image
  Inventory inv = Inventory(path_to_database); // Holds items
  ItemDatabase db(path_to_database); // Can be queried for prices, types, rarity, full names
+ DetectionWriter writer("..//detections//"); // Writes images with rendered text detections in the background
 
  int imageNumber = 1;
 
@@ -61,8 +63,9 @@ int main() {
      InventoryItem item(name, certification, paint, price);
      inv.AddItem(item);
 
-     // Show detected text - Press any key to continue
-     classifier.RenderTextDetections();
+     // Save detected text to detections/item<number>.png without waiting for the disk
+     // Call classifier.RenderTextDetections() instead to show it in a window
+     classifier.RenderTextDetections(writer, "item" + std::to_string(imageNumber - 1) + ".png");
  }
 
  // Print different lists
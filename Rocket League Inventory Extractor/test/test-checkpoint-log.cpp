@@ -0,0 +1,114 @@
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+#include <string>
+
+#include "../catch.hpp"
+#include "../src/CheckpointLog.h"
+
+// Writes a stand-in image file whose contents only matter for its size and time
+static void WriteFile(const std::string& path, const std::string& contents) {
+    std::ofstream(path, std::ios::binary) << contents;
+}
+
+TEST_CASE("CheckpointLog results can be read back by the next run") {
+    std::filesystem::remove("test-checkpoint.log");
+    WriteFile("test-checkpoint-a.png", "a");
+
+    ClassifiedImage image;
+    image.path = "test-checkpoint-a.png";
+    image.succeeded = true;
+    image.result.name = "Octane - MG-88";
+    image.result.paint = "Cobalt";
+    image.result.name_confidence = 0.75f;
+    image.price = "40-50";
+    {
+        CheckpointLog log("test-checkpoint.log");
+        REQUIRE(log.IsOpen());
+        REQUIRE(log.Append(image));
+    }
+
+    {
+        CheckpointLog log("test-checkpoint.log");
+        ClassifiedImage resumed;
+        REQUIRE(log.GetSize() == 1);
+        REQUIRE(log.Lookup("test-checkpoint-a.png", resumed));
+        REQUIRE(resumed.succeeded);
+        REQUIRE(resumed.result.name == "Octane - MG-88");
+        REQUIRE(resumed.result.paint == "Cobalt");
+        REQUIRE(resumed.result.certification.empty());
+        REQUIRE(resumed.result.name_confidence == Approx(0.75f));
+        REQUIRE(resumed.price == "40-50");
+    }
+    std::remove("test-checkpoint.log");
+    std::remove("test-checkpoint-a.png");
+}
+
+TEST_CASE("CheckpointLog does not log failed images") {
+    std::filesystem::remove("test-checkpoint.log");
+    WriteFile("test-checkpoint-a.png", "a");
+
+    {
+        CheckpointLog log("test-checkpoint.log");
+        ClassifiedImage image;
+        image.path = "test-checkpoint-a.png";
+        REQUIRE_FALSE(log.Append(image));
+        REQUIRE(log.GetSize() == 0);
+    }
+    std::remove("test-checkpoint.log");
+    std::remove("test-checkpoint-a.png");
+}
+
+TEST_CASE("CheckpointLog classifies changed images again") {
+    std::filesystem::remove("test-checkpoint.log");
+    WriteFile("test-checkpoint-a.png", "a");
+
+    ClassifiedImage image;
+    image.path = "test-checkpoint-a.png";
+    image.succeeded = true;
+    {
+        CheckpointLog log("test-checkpoint.log");
+        REQUIRE(log.Append(image));
+    }
+
+    WriteFile("test-checkpoint-a.png", "a larger image");
+    {
+        CheckpointLog log("test-checkpoint.log");
+        REQUIRE_FALSE(log.Lookup("test-checkpoint-a.png", image));
+    }
+    std::remove("test-checkpoint.log");
+    std::remove("test-checkpoint-a.png");
+}
+
+TEST_CASE("CheckpointLog discards a line cut short by a crash") {
+    std::filesystem::remove("test-checkpoint.log");
+    WriteFile("test-checkpoint-a.png", "a");
+    WriteFile("test-checkpoint-b.png", "b");
+
+    ClassifiedImage image;
+    image.path = "test-checkpoint-a.png";
+    image.succeeded = true;
+    {
+        CheckpointLog log("test-checkpoint.log");
+        REQUIRE(log.Append(image));
+    }
+    std::ofstream("test-checkpoint.log", std::ios::app | std::ios::binary)
+        << "test-checkpoint-b.png\t1\t";
+
+    {
+        CheckpointLog log("test-checkpoint.log");
+        REQUIRE(log.GetSize() == 1);
+        image.path = "test-checkpoint-b.png";
+        REQUIRE(log.Append(image));
+    }
+
+    // The cut line is gone, so the line appended after it is read whole
+    {
+        CheckpointLog log("test-checkpoint.log");
+        REQUIRE(log.GetSize() == 2);
+        REQUIRE(log.Lookup("test-checkpoint-b.png", image));
+    }
+    std::remove("test-checkpoint.log");
+    std::remove("test-checkpoint-a.png");
+    std::remove("test-checkpoint-b.png");
+}
@@ -0,0 +1,67 @@
+#include <cstdio>
+#include <filesystem>
+#include <string>
+
+#include "../catch.hpp"
+#include "../src/ClassificationCache.h"
+
+ClassificationResult wildcat_ears = {"Wildcat Ears", "Cobalt", ""};
+ClassificationResult toon_sketch = {"Toon Sketch", "Default", "Show-Off", 0.9f, 1.0f, 0.75f};
+
+std::string path_to_cache_store =
+    (std::filesystem::temp_directory_path() / "rl-classification-cache-test.tsv").string();
+
+TEST_CASE("ClassificationCache returns an inserted result") {
+    ClassificationCache cache(4);
+    ClassificationResult result;
+    REQUIRE_FALSE(cache.Lookup(1, result));
+
+    cache.Insert(1, wildcat_ears);
+    REQUIRE(cache.Lookup(1, result));
+    REQUIRE(result.name == "Wildcat Ears");
+    REQUIRE(result.paint == "Cobalt");
+    REQUIRE(cache.GetHitCount() == 1);
+    REQUIRE(cache.GetMissCount() == 1);
+}
+
+TEST_CASE("ClassificationCache evicts the least recently used result") {
+    ClassificationCache cache(2);
+    ClassificationResult result;
+    cache.Insert(1, wildcat_ears);
+    cache.Insert(2, toon_sketch);
+    cache.Lookup(1, result);  // 2 is now the least recently used
+    cache.Insert(3, toon_sketch);
+
+    REQUIRE(cache.GetSize() == 2);
+    REQUIRE(cache.Lookup(1, result));
+    REQUIRE_FALSE(cache.Lookup(2, result));
+    REQUIRE(cache.Lookup(3, result));
+}
+
+TEST_CASE("ClassificationCache loads results saved by an earlier run") {
+    std::remove(path_to_cache_store.c_str());
+    {
+        ClassificationCache cache(4, path_to_cache_store);
+        cache.Insert(0xfeedbeef12345678ULL, toon_sketch);
+    }
+
+    ClassificationCache reloaded(4, path_to_cache_store);
+    ClassificationResult result;
+    REQUIRE(reloaded.Lookup(0xfeedbeef12345678ULL, result));
+    REQUIRE(result.name == "Toon Sketch");
+    REQUIRE(result.certification == "Show-Off");
+    REQUIRE(result.name_confidence == Approx(0.9f));
+    REQUIRE(result.certification_confidence == Approx(0.75f));
+    std::remove(path_to_cache_store.c_str());
+}
+
+TEST_CASE("ClassificationCache keeps results without a name") {
+    ClassificationCache cache(4, path_to_cache_store);
+    cache.Insert(7, ClassificationResult());
+    ClassificationResult result = wildcat_ears;
+    REQUIRE(cache.Lookup(7, result));
+    REQUIRE(result.name.empty());
+    cache.Clear();
+    REQUIRE(cache.GetSize() == 0);
+    std::remove(path_to_cache_store.c_str());
+}
@@ -0,0 +1,103 @@
+#include <chrono>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "../catch.hpp"
+#include "../src/BatchingClassifier.h"
+#include "../src/ClassificationServer.h"
+
+ItemClassifier server_classifier("missing-model.pb", "missing-database.json");
+
+TEST_CASE("ParseHttpRequestHead reads the request line and headers") {
+    HttpRequest request;
+    REQUIRE(ParseHttpRequestHead(
+        "POST /classify?debug=1 HTTP/1.1\r\nHost: 127.0.0.1\r\nContent-Length:  42 \r\n",
+        request));
+    REQUIRE(request.method == "POST");
+    REQUIRE(request.path == "/classify");
+    REQUIRE(request.headers["host"] == "127.0.0.1");
+    REQUIRE(request.headers["content-length"] == "42");
+}
+
+TEST_CASE("ParseHttpRequestHead rejects malformed requests") {
+    HttpRequest request;
+    REQUIRE_FALSE(ParseHttpRequestHead("", request));
+    REQUIRE_FALSE(ParseHttpRequestHead("GET /inventory", request));
+    REQUIRE_FALSE(ParseHttpRequestHead("GET inventory HTTP/1.1", request));
+    REQUIRE_FALSE(ParseHttpRequestHead("GET /inventory HTTP/1.1\r\nno colon\r\n", request));
+}
+
+TEST_CASE("ClassificationToJson writes every trait and confidence") {
+    ClassificationResult result;
+    result.name = "Octane - MG-88";
+    result.paint = "Cobalt";
+    result.name_confidence = 0.5f;
+    std::string json = ClassificationToJson(result, "40-50");
+    REQUIRE(json.find("\"name\":\"Octane - MG-88\"") != std::string::npos);
+    REQUIRE(json.find("\"paint\":\"Cobalt\"") != std::string::npos);
+    REQUIRE(json.find("\"price\":\"40-50\"") != std::string::npos);
+    REQUIRE(json.find("\"confidence\"") != std::string::npos);
+}
+
+TEST_CASE("BatchingClassifier classifies concurrent requests together") {
+    BatchingClassifier batching(server_classifier, 4, std::chrono::seconds(5));
+    std::string invalid = "not an image";
+
+    // The batch starts as soon as it is full rather than after the delay
+    std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+    std::vector<std::thread> callers;
+    std::vector<char> succeeded(4, true);
+    for (int i = 0; i < 4; i++)
+        callers.emplace_back([&, i] {
+            ClassificationResult result;
+            succeeded[i] = batching.Classify(
+                reinterpret_cast<const unsigned char*>(invalid.data()), invalid.size(), result);
+        });
+    for (std::thread& caller : callers) caller.join();
+    REQUIRE(std::chrono::steady_clock::now() - start < std::chrono::seconds(5));
+
+    BatchingStatistics statistics = batching.GetStatistics();
+    REQUIRE(statistics.requests == 4);
+    REQUIRE(statistics.failed_requests == 4);
+    REQUIRE(statistics.batches == 1);
+    REQUIRE(statistics.largest_batch == 4);
+    REQUIRE(succeeded == std::vector<char>(4, false));
+}
+
+TEST_CASE("BatchingClassifier does not hold a lone request past its delay") {
+    BatchingClassifier batching(server_classifier, 8, std::chrono::milliseconds(1));
+    ClassificationResult result;
+    bool decoded = true;
+    REQUIRE_FALSE(batching.Classify(nullptr, 0, result, &decoded));
+    REQUIRE_FALSE(decoded);
+    REQUIRE(batching.GetStatistics().batches == 1);
+}
+
+TEST_CASE("ClassificationServer routes requests") {
+    BatchingClassifier batching(server_classifier, 8, std::chrono::milliseconds(1));
+    ClassificationServer server(batching, "missing-database.json");
+
+    HttpRequest request;
+    request.method = "GET";
+    request.path = "/inventory";
+    HttpResponse response = server.Handle(request);
+    REQUIRE(response.status == 200);
+    REQUIRE(response.body.find("\"items\":[]") != std::string::npos);
+
+    request.path = "/classify";
+    REQUIRE(server.Handle(request).status == 405);
+
+    request.method = "POST";
+    request.body = "not an image";
+    REQUIRE(server.Handle(request).status == 400);
+
+    // The image decodes, but the missing model cannot classify it
+    std::vector<unsigned char> png;
+    cv::imencode(".png", cv::Mat(155, 131, CV_8UC3, cv::Scalar(71, 56, 39)), png);
+    request.body.assign(png.begin(), png.end());
+    REQUIRE(server.Handle(request).status == 500);
+
+    request.path = "/missing";
+    REQUIRE(server.Handle(request).status == 404);
+}
@@ -0,0 +1,80 @@
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "../catch.hpp"
+#include "../src/ClassifierDaemon.h"
+
+ItemClassifier daemon_classifier("missing-model.pb", "missing-database.json");
+
+TEST_CASE("ClassifierDaemon reports images that could not be read") {
+    std::vector<std::string> failed;
+    {
+        ClassifierDaemon daemon(daemon_classifier, DaemonLimits(),
+                                [&](const DaemonJob& job, const ClassificationResult& result,
+                                    bool succeeded) {
+                                    if (!succeeded) failed.push_back(job.id);
+                                });
+        daemon.Submit({"missing file", "missing-image.png", {}});
+        daemon.Submit({"invalid bytes", "", {'n', 'o', 't', ' ', 'a', 'n', ' ', 'i', 'm', 'a', 'g', 'e'}});
+        daemon.Flush();
+
+        DaemonStatistics statistics = daemon.GetStatistics();
+        REQUIRE(statistics.failed_jobs == 2);
+        REQUIRE(statistics.completed_jobs == 0);
+        REQUIRE(statistics.pending_jobs == 0);
+    }
+    REQUIRE(failed == std::vector<std::string>{"missing file", "invalid bytes"});
+}
+
+TEST_CASE("ClassifierDaemon keeps running when the result handler throws") {
+    int handled = 0;
+    ClassifierDaemon daemon(daemon_classifier, DaemonLimits(),
+                            [&](const DaemonJob&, const ClassificationResult&, bool) {
+                                handled++;
+                                throw std::runtime_error("handler failed");
+                            });
+    for (int i = 0; i < 3; i++) daemon.Submit({std::to_string(i), "missing-image.png", {}});
+    daemon.Flush();
+
+    REQUIRE(handled == 3);
+    REQUIRE(daemon.GetStatistics().failed_jobs == 3);
+    REQUIRE(daemon.GetStatistics().completed_jobs == 0);
+}
+
+TEST_CASE("ClassifierDaemon recycles the engines after a number of jobs") {
+    DaemonLimits limits;
+    limits.max_jobs_per_engine = 2;
+    limits.max_pending_jobs = 1;
+    ClassifierDaemon daemon(daemon_classifier, limits,
+                            [](const DaemonJob&, const ClassificationResult&, bool) {});
+    for (int i = 0; i < 5; i++) daemon.Submit({std::to_string(i), "missing-image.png", {}});
+    daemon.Flush();
+
+    DaemonStatistics statistics = daemon.GetStatistics();
+    REQUIRE(statistics.failed_jobs == 5);
+    REQUIRE(statistics.engine_recycles == 2);
+}
+
+TEST_CASE("ClassifierDaemon recycles the engines above its memory limit") {
+    DaemonLimits limits;
+    limits.max_resident_bytes = 1;  // Any process is larger than this
+    ClassifierDaemon daemon(daemon_classifier, limits,
+                            [](const DaemonJob&, const ClassificationResult&, bool) {});
+    daemon.Submit({"0", "missing-image.png", {}});
+    daemon.Flush();
+    REQUIRE(daemon.GetStatistics().engine_recycles == 1);
+    REQUIRE(daemon.GetStatistics().peak_resident_bytes > 0);
+}
+
+TEST_CASE("ClassifierDaemon finishes pending jobs when destroyed") {
+    int handled = 0;
+    {
+        ClassifierDaemon daemon(daemon_classifier, DaemonLimits(),
+                                [&](const DaemonJob&, const ClassificationResult&, bool) {
+                                    handled++;
+                                });
+        for (int i = 0; i < 3; i++) daemon.Submit({std::to_string(i), "missing-image.png", {}});
+    }
+    REQUIRE(handled == 3);
+}
@@ -0,0 +1,48 @@
+#include <cstdio>
+#include <string>
+#include <vector>
+
+#include "../catch.hpp"
+#include "../src/CorpusManifest.h"
+
+TEST_CASE("ReadManifest returns an empty vector for a missing manifest") {
+    REQUIRE(ReadManifest("not an actual file").empty());
+}
+
+TEST_CASE("WriteManifest output can be read back by ReadManifest") {
+    std::vector<LabeledImage> written = {
+        {"BSFGSP.png", "FGSP", "Burnt Sienna", ""},
+        {"CertToonSketch.png", "Toon Sketch", "Default", "Show-Off"}};
+    REQUIRE(WriteManifest("test-manifest.csv", written));
+
+    std::vector<LabeledImage> read = ReadManifest("test-manifest.csv");
+    REQUIRE(read.size() == 2);
+    REQUIRE(read[0].image == "BSFGSP.png");
+    REQUIRE(read[0].paint == "Burnt Sienna");
+    REQUIRE(read[0].certification.empty());
+    REQUIRE(read[1].name == "Toon Sketch");
+    REQUIRE(read[1].certification == "Show-Off");
+    std::remove("test-manifest.csv");
+}
+
+TEST_CASE("WriteManifest quotes names with commas and quotes so they read back whole") {
+    std::vector<LabeledImage> written = {
+        {"Sweet, Tooth.png", "Sweet Tooth, \"Inverted\"", "Default", "Striker"}};
+    REQUIRE(WriteManifest("test-manifest.csv", written));
+
+    std::vector<LabeledImage> read = ReadManifest("test-manifest.csv");
+    REQUIRE(read.size() == 1);
+    REQUIRE(read[0].image == "Sweet, Tooth.png");
+    REQUIRE(read[0].name == "Sweet Tooth, \"Inverted\"");
+    REQUIRE(read[0].paint == "Default");
+    REQUIRE(read[0].certification == "Striker");
+    std::remove("test-manifest.csv");
+}
+
+TEST_CASE("ReadManifest reads the bundled test image manifest") {
+    std::vector<LabeledImage> labeled = ReadManifest(
+        "C:\\Users\\Unknown_User\\Documents\\openFrameworks\\apps\\fantastic-"
+        "finale-astudent82828211\\Rocket League Inventory Extractor\\Test "
+        "Images for RL\\Isolated\\manifest.csv");
+    REQUIRE(labeled.size() == 23);
+}
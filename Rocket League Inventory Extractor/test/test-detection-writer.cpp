@@ -0,0 +1,63 @@
+#include <filesystem>
+#include <string>
+#include <opencv2/opencv.hpp>
+
+#include "../catch.hpp"
+#include "../src/DetectionWriter.h"
+
+std::filesystem::path detections_folder =
+    std::filesystem::temp_directory_path() / "rl-detection-writer-test";
+
+TEST_CASE("DetectionWriter writes every queued image") {
+    std::filesystem::remove_all(detections_folder);
+    DetectionWriter writer(detections_folder.string(), 4);
+    cv::Mat image(32, 32, CV_8UC3, cv::Scalar(0, 255, 0));
+
+    for (int i = 0; i < 10; i++)
+        writer.Write("image" + std::to_string(i) + ".png", image);
+    writer.Flush();
+
+    REQUIRE(writer.GetWrittenCount() == 10);
+    REQUIRE(writer.GetFailedCount() == 0);
+    REQUIRE(std::filesystem::exists(detections_folder / "image9.png"));
+}
+
+TEST_CASE("DetectionWriter draws annotations on the writer thread before writing") {
+    std::filesystem::remove_all(detections_folder);
+    DetectionWriter writer(detections_folder.string());
+    DetectionAnnotation box;
+    box.corners = {cv::Point2f(4, 4), cv::Point2f(27, 4), cv::Point2f(27, 27), cv::Point2f(4, 27)};
+    box.label = "Octane 0.93";
+    writer.Write("annotated.png", cv::Mat(32, 32, CV_8UC3, cv::Scalar(0, 0, 0)), {box});
+    writer.Flush();
+
+    cv::Mat written = cv::imread((detections_folder / "annotated.png").string());
+    REQUIRE(!written.empty());
+    REQUIRE(written.at<cv::Vec3b>(15, 4) == cv::Vec3b(0, 255, 0));
+    REQUIRE(written.at<cv::Vec3b>(27, 15) == cv::Vec3b(0, 255, 0));
+    REQUIRE(written.at<cv::Vec3b>(15, 15) == cv::Vec3b(0, 0, 0));
+}
+
+TEST_CASE("DetectionWriter writes pending images before it is destroyed") {
+    std::filesystem::remove_all(detections_folder);
+    {
+        DetectionWriter writer(detections_folder.string());
+        writer.Write("last.png", cv::Mat(16, 16, CV_8UC3, cv::Scalar(255, 0, 0)));
+    }
+    REQUIRE(std::filesystem::exists(detections_folder / "last.png"));
+}
+
+TEST_CASE("DetectionWriter counts images that could not be written") {
+    DetectionWriter writer(detections_folder.string());
+    writer.Write("unknown.extension", cv::Mat(16, 16, CV_8UC3));
+    writer.Flush();
+    REQUIRE(writer.GetFailedCount() == 1);
+}
+
+TEST_CASE("DetectionWriter ignores empty images") {
+    DetectionWriter writer(detections_folder.string());
+    writer.Write("empty.png", cv::Mat());
+    writer.Flush();
+    REQUIRE(writer.GetWrittenCount() == 0);
+    REQUIRE(writer.GetFailedCount() == 0);
+}
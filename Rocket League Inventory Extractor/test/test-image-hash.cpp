@@ -0,0 +1,61 @@
+#include <string>
+#include <opencv2/opencv.hpp>
+
+#include "../catch.hpp"
+#include "../src/ImageHash.h"
+
+// Draws a simple tile with a bright block in one corner
+cv::Mat MakeTile(int block_x, int block_y) {
+    cv::Mat tile(100, 100, CV_8UC3, cv::Scalar(40, 40, 40));
+    cv::rectangle(tile, cv::Rect(block_x, block_y, 40, 40),
+                  cv::Scalar(220, 220, 220), cv::FILLED);
+    return tile;
+}
+
+TEST_CASE("DifferenceHash returns 0 for an empty image") {
+    REQUIRE(DifferenceHash(cv::Mat()) == 0);
+}
+
+TEST_CASE("DifferenceHash is identical for identical images") {
+    REQUIRE(DifferenceHash(MakeTile(10, 10)) == DifferenceHash(MakeTile(10, 10)));
+}
+
+TEST_CASE("DifferenceHash is close for slightly noisy images") {
+    cv::Mat tile = MakeTile(10, 10);
+    cv::Mat noisy = tile.clone();
+    noisy.at<cv::Vec3b>(50, 50) = cv::Vec3b(45, 45, 45);
+    REQUIRE(HammingDistance(DifferenceHash(tile), DifferenceHash(noisy)) <= 2);
+}
+
+TEST_CASE("DifferenceHash differs for different images") {
+    REQUIRE(HammingDistance(DifferenceHash(MakeTile(10, 10)),
+                            DifferenceHash(MakeTile(50, 50))) > 6);
+}
+
+TEST_CASE("HammingDistance counts differing bits") {
+    REQUIRE(HammingDistance(0, 0) == 0);
+    REQUIRE(HammingDistance(0, 0xFF) == 8);
+    REQUIRE(HammingDistance(~0ULL, 0) == 64);
+}
+
+TEST_CASE("ContentHash is identical for identical bytes and differs otherwise") {
+    std::string bytes = "an encoded image";
+    std::string changed = "an encoded imagf";
+    REQUIRE(ContentHash(bytes.data(), bytes.size()) == ContentHash(bytes.data(), bytes.size()));
+    REQUIRE(ContentHash(bytes.data(), bytes.size()) != ContentHash(changed.data(), changed.size()));
+    REQUIRE(ContentHash(bytes.data(), bytes.size(), 1) != ContentHash(bytes.data(), bytes.size(), 2));
+}
+
+TEST_CASE("ContentHash of a region matches the hash of a copy of it") {
+    cv::Mat tile = MakeTile(10, 10);
+    cv::Mat region = tile(cv::Rect(5, 5, 50, 50));
+    REQUIRE(ContentHash(region) == ContentHash(region.clone()));
+}
+
+TEST_CASE("ContentHash changes when a single pixel changes") {
+    cv::Mat tile = MakeTile(10, 10);
+    cv::Mat changed = tile.clone();
+    changed.at<cv::Vec3b>(99, 99) = cv::Vec3b(41, 40, 40);
+    REQUIRE(ContentHash(tile) != ContentHash(changed));
+    REQUIRE(ContentHash(cv::Mat()) == 0);
+}
@@ -0,0 +1,74 @@
+#include <algorithm>
+#include <filesystem>
+#include <fstream>
+#include <string>
+#include <vector>
+
+#include "../catch.hpp"
+#include "../src/ImageListing.h"
+
+TEST_CASE("MatchesWildcard matches * and ?") {
+    REQUIRE(MatchesWildcard("OctaneMG88.png", "*.png"));
+    REQUIRE(MatchesWildcard("OctaneMG88.png", "Octane??88.*"));
+    REQUIRE(MatchesWildcard("OctaneMG88.png", "*"));
+    REQUIRE(MatchesWildcard("a.png", "*a*.png"));
+    REQUIRE_FALSE(MatchesWildcard("OctaneMG88.jpg", "*.png"));
+    REQUIRE_FALSE(MatchesWildcard("OctaneMG88.png", "Octane?88.png"));
+    REQUIRE_FALSE(MatchesWildcard("octane.png", "Octane.png"));
+}
+
+TEST_CASE("HasImageExtension accepts image extensions in any case") {
+    REQUIRE(HasImageExtension("Dominus.png"));
+    REQUIRE(HasImageExtension("shots/Dominus.JPG"));
+    REQUIRE_FALSE(HasImageExtension("manifest.csv"));
+    REQUIRE_FALSE(HasImageExtension("png"));
+}
+
+TEST_CASE("ListImages lists folders and patterns in sorted order") {
+    std::filesystem::path folder = "test-image-listing";
+    std::filesystem::remove_all(folder);
+    std::filesystem::create_directory(folder);
+    for (const char* name : {"b.png", "a.png", "c.jpg", "manifest.csv"})
+        std::ofstream((folder / name).string()) << name;
+
+    std::vector<std::string> listed = ListImages(folder.string());
+    REQUIRE(listed == std::vector<std::string>{(folder / "a.png").string(),
+                                               (folder / "b.png").string(),
+                                               (folder / "c.jpg").string()});
+
+    listed = ListImages((folder / "*.png").string());
+    REQUIRE(listed == std::vector<std::string>{(folder / "a.png").string(),
+                                               (folder / "b.png").string()});
+
+    // A single file is passed through even if it is missing, for the caller to report
+    REQUIRE(ListImages("missing.png") == std::vector<std::string>{"missing.png"});
+    std::filesystem::remove_all(folder);
+}
+
+TEST_CASE("ParseShard reads <index>/<count>") {
+    size_t index, count;
+    REQUIRE(ParseShard("0/8", index, count));
+    REQUIRE(index == 0);
+    REQUIRE(count == 8);
+    REQUIRE(ParseShard("7/8", index, count));
+    REQUIRE(index == 7);
+    REQUIRE_FALSE(ParseShard("8/8", index, count));
+    REQUIRE_FALSE(ParseShard("0/0", index, count));
+    REQUIRE_FALSE(ParseShard("1", index, count));
+    REQUIRE_FALSE(ParseShard("-1/4", index, count));
+    REQUIRE_FALSE(ParseShard("1/4x", index, count));
+}
+
+TEST_CASE("SelectShard splits paths into disjoint shards of equal size") {
+    std::vector<std::string> paths = {"a", "b", "c", "d", "e", "f", "g"};
+    std::vector<std::string> combined;
+    for (size_t index = 0; index < 3; index++) {
+        std::vector<std::string> shard = SelectShard(paths, index, 3);
+        REQUIRE(shard.size() >= 2);
+        REQUIRE(shard.size() <= 3);
+        combined.insert(combined.end(), shard.begin(), shard.end());
+    }
+    std::sort(combined.begin(), combined.end());
+    REQUIRE(combined == paths);
+    REQUIRE(SelectShard(paths, 1, 3) == std::vector<std::string>{"b", "e"});
+}
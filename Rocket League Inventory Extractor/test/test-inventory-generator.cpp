@@ -0,0 +1,38 @@
+#include <string>
+#include <vector>
+
+#include "../catch.hpp"
+#include "../src/InventoryGenerator.h"
+#include "../src/ItemDatabase.h"
+
+ItemDatabase generator_db(
+    "C:\\Users\\Unknown_User\\Documents\\openFrameworks\\apps\\fantastic-"
+    "finale-astudent82828211\\Rocket League Inventory Extractor\\Prices.json");
+
+TEST_CASE("InventoryGenerator builds a catalog from the database") {
+    InventoryGenerator generator(generator_db, 1);
+    REQUIRE(generator.GetCatalogSize() > 0);
+}
+
+TEST_CASE("GenerateItems returns the requested number of priced items") {
+    InventoryGenerator generator(generator_db, 1);
+    std::vector<InventoryItem> items = generator.GenerateItems(500);
+    REQUIRE(items.size() == 500);
+    for (const InventoryItem& item : items) {
+        REQUIRE(!item.GetName().empty());
+        REQUIRE(!item.GetPriceRange().empty());
+        REQUIRE(item.GetQuantity() >= 1);
+    }
+}
+
+TEST_CASE("InventoryGenerator generates the same items from the same seed") {
+    InventoryGenerator first(generator_db, 42);
+    InventoryGenerator second(generator_db, 42);
+    std::vector<InventoryItem> first_items = first.GenerateItems(100);
+    std::vector<InventoryItem> second_items = second.GenerateItems(100);
+    for (size_t i = 0; i < first_items.size(); i++) {
+        REQUIRE(first_items[i].GetName() == second_items[i].GetName());
+        REQUIRE(first_items[i].GetColor() == second_items[i].GetColor());
+        REQUIRE(first_items[i].GetCertification() == second_items[i].GetCertification());
+    }
+}
@@ -1,6 +1,7 @@
 #include <vector>
 #include <string>
 #include <fstream>
+#include <algorithm>
 
 #include "../catch.hpp"
 #include "../src/Inventory.h"
@@ -148,4 +149,45 @@ TEST_CASE("ReadInvFromFile clears an existing inventory") {
     inv.ReadInvFromFile();
 
     REQUIRE(inv.GetInventoryWorth() == invWorth);
-}
\ No newline at end of file
+}
+TEST_CASE("Merge sums quantities of matching items and appends new ones") {
+    std::vector<InventoryItem> held = {i11, i31, i41, i51};
+    Inventory inv(held, path_to_db);
+    Inventory partial(path_to_db);
+    partial.AddItem(i41);
+    partial.AddItem(i21);
+
+    inv.Merge(partial);
+    std::vector<InventoryItem> merged = inv.GetItems();
+    REQUIRE(merged.size() == held.size() + 1);
+    REQUIRE(merged[2] == i41);
+    REQUIRE(merged[2].GetQuantity() == 4);
+    REQUIRE(merged.back() == i21);
+
+    // The partial inventory is left as it was
+    REQUIRE(partial.GetItems().size() == 2);
+    REQUIRE(partial.GetItems()[0].GetQuantity() == 2);
+}
+
+TEST_CASE("Merge gives the same items whichever shard is merged first") {
+    Inventory first(path_to_db), second(path_to_db);
+    first.AddItem(i11);
+    first.AddItem(i51);
+    second.AddItem(i51);
+    second.AddItem(i31);
+
+    Inventory a(path_to_db), b(path_to_db);
+    a.Merge(first);
+    a.Merge(second);
+    b.Merge(second);
+    b.Merge(first);
+
+    REQUIRE(a.GetItems().size() == 3);
+    REQUIRE(b.GetItems().size() == 3);
+    for (const InventoryItem& item : a.GetItems()) {
+        std::vector<InventoryItem> other = b.GetItems();
+        std::vector<InventoryItem>::iterator found = std::find(other.begin(), other.end(), item);
+        REQUIRE(found != other.end());
+        REQUIRE(found->GetQuantity() == item.GetQuantity());
+    }
+}
@@ -1,8 +1,12 @@
 #include <string>
+#include <fstream>
+#include <iterator>
 
 #include "../catch.hpp"
+#include "../src/ClassificationCache.h"
 #include "../src/ItemClassifier.h"
 #include "../src/ItemDatabase.h"
+#include "../src/VisualIndex.h"
 
 ItemClassifier classifier(
     "C:\\Users\\Unknown_User\\Documents\\openFrameworks\\apps\\fantastic-"
@@ -23,6 +27,148 @@ TEST_CASE("ItemClassifier extracts text") {
     REQUIRE(!extracted.empty());
 }
 
+TEST_CASE("ItemClassifier extracts text from an image in memory") {
+    std::string path_to_image =
+        "C:\\Users\\Unknown_User\\Documents\\openFrameworks\\apps\\fantastic-"
+        "finale-astudent82828211\\Rocket League Inventory Extractor\\Test "
+        "Images for RL\\Isolated\\CobaltWildcatEars.png";
+
+    cv::Mat image = cv::imread(path_to_image);
+    classifier.DetectText(image);
+    REQUIRE(!classifier.ExtractText().empty());
+}
+
+TEST_CASE("ItemClassifier extracts text from an encoded image in memory") {
+    std::string path_to_image =
+        "C:\\Users\\Unknown_User\\Documents\\openFrameworks\\apps\\fantastic-"
+        "finale-astudent82828211\\Rocket League Inventory Extractor\\Test "
+        "Images for RL\\Isolated\\CobaltWildcatEars.png";
+
+    std::ifstream file(path_to_image, std::ios::binary);
+    std::vector<unsigned char> bytes((std::istreambuf_iterator<char>(file)),
+                                     std::istreambuf_iterator<char>());
+    classifier.DetectText(bytes.data(), bytes.size());
+    REQUIRE(!classifier.ExtractText().empty());
+}
+
+TEST_CASE("DetectText sizes the network input to the image") {
+    // CobaltWildcatEars.png is 131x155, which rounds to 128x160
+    std::string path_to_image =
+        "C:\\Users\\Unknown_User\\Documents\\openFrameworks\\apps\\fantastic-"
+        "finale-astudent82828211\\Rocket League Inventory Extractor\\Test "
+        "Images for RL\\Isolated\\CobaltWildcatEars.png";
+
+    classifier.DetectText(path_to_image);
+    REQUIRE(classifier.GetInputSize() == cv::Size(128, 160));
+}
+
+TEST_CASE("DetectText caps the network input size of large images") {
+    cv::Mat screenshot(2160, 3840, CV_8UC3, cv::Scalar(40, 20, 10));
+    classifier.DetectText(screenshot);
+    REQUIRE(classifier.GetInputSize() == cv::Size(1280, 736));
+}
+
+TEST_CASE("Classify returns an empty result for an invalid encoded image") {
+    std::vector<unsigned char> bytes = {'n', 'o', 't', ' ', 'a', 'n', ' ',
+                                        'i', 'm', 'a', 'g', 'e'};
+    ClassificationResult result = classifier.Classify(bytes.data(), bytes.size());
+    REQUIRE(result.name.empty());
+}
+
+TEST_CASE("Classify caches an encoded image once, by its bytes") {
+    std::string path_to_image =
+        "C:\\Users\\Unknown_User\\Documents\\openFrameworks\\apps\\fantastic-"
+        "finale-astudent82828211\\Rocket League Inventory Extractor\\Test "
+        "Images for RL\\Isolated\\CobaltWildcatEars.png";
+
+    std::ifstream file(path_to_image, std::ios::binary);
+    std::vector<unsigned char> bytes((std::istreambuf_iterator<char>(file)),
+                                     std::istreambuf_iterator<char>());
+    ClassificationCache cache(10);
+    classifier.SetCache(&cache);
+    ClassificationResult first = classifier.Classify(bytes.data(), bytes.size());
+    ClassificationResult second = classifier.Classify(bytes.data(), bytes.size());
+    classifier.SetCache(nullptr);
+
+    // One miss and one entry for the first upload, then one hit for the repeat
+    REQUIRE(cache.GetSize() == 1);
+    REQUIRE(cache.GetMissCount() == 1);
+    REQUIRE(cache.GetHitCount() == 1);
+    REQUIRE(second.name == first.name);
+}
+
+TEST_CASE("Classify does not cache a tile that matched no item") {
+    cv::Mat blank(155, 131, CV_8UC3, cv::Scalar(71, 56, 39));
+    ClassificationCache cache(10);
+    classifier.SetCache(&cache);
+    ClassificationResult first = classifier.Classify(blank);
+    ClassificationResult second = classifier.Classify(blank);
+    classifier.SetCache(nullptr);
+
+    REQUIRE(first.name.empty());
+    REQUIRE(second.name.empty());
+    REQUIRE(cache.GetSize() == 0);
+    REQUIRE(cache.GetHitCount() == 0);
+}
+
+TEST_CASE("Classify stops after the text band once the name is confident enough") {
+    cv::Mat image = cv::imread(
+        "C:\\Users\\Unknown_User\\Documents\\openFrameworks\\apps\\fantastic-"
+        "finale-astudent82828211\\Rocket League Inventory Extractor\\Test "
+        "Images for RL\\Isolated\\CobaltWildcatEars.png");
+
+    TokenRecord record;
+    classifier.SetMinimumConfidence(0);
+    classifier.Classify(image, record);
+    classifier.SetMinimumConfidence(.70f);
+    REQUIRE(record.passes.size() == 1);
+    REQUIRE(record.passes[0].step == RecordedStep::TextBand);
+}
+
+TEST_CASE("Classify escalates to the detected boxes while the name is not confident enough") {
+    cv::Mat image = cv::imread(
+        "C:\\Users\\Unknown_User\\Documents\\openFrameworks\\apps\\fantastic-"
+        "finale-astudent82828211\\Rocket League Inventory Extractor\\Test "
+        "Images for RL\\Isolated\\CobaltWildcatEars.png");
+
+    TokenRecord record;
+    classifier.SetMinimumConfidence(1);
+    classifier.Classify(image, record);
+    classifier.SetMinimumConfidence(.70f);
+    REQUIRE(record.passes.size() == 3);
+    REQUIRE(record.passes[1].step == RecordedStep::TextBoxes);
+    REQUIRE(record.passes[2].step == RecordedStep::EnhancedTextBoxes);
+
+    // Box words are scaled by the confidence of their box, which is never above 1
+    for (const RecordedWord& word : record.passes[1].words) REQUIRE(word.confidence <= 1.0f);
+}
+
+TEST_CASE("Classify looks up grayscale and BGRA tiles in the visual index") {
+    cv::Mat tile(155, 137, CV_8UC3, cv::Scalar(71, 56, 39));
+    cv::circle(tile, cv::Point(68, 55), 35, cv::Scalar(40, 40, 200), cv::FILLED);
+    cv::putText(tile, "Wildcat Ears", cv::Point(15, 140), cv::FONT_HERSHEY_SIMPLEX, 0.45,
+                cv::Scalar(230, 140, 90), 1, cv::LINE_AA);
+    cv::Mat bgra, gray, gray_bgr;
+    cv::cvtColor(tile, bgra, cv::COLOR_BGR2BGRA);
+    cv::cvtColor(tile, gray, cv::COLOR_BGR2GRAY);
+    cv::cvtColor(gray, gray_bgr, cv::COLOR_GRAY2BGR);
+
+    // The gray tile has lost the art's color, so it is indexed as a tile of its own
+    VisualIndex index;
+    index.Add(VisualIndex::ComputeSignature(tile), {"Wildcat Ears", "Crimson", ""});
+    index.Add(VisualIndex::ComputeSignature(gray_bgr), {"Wildcat Ears", "Grey", ""});
+    REQUIRE(index.GetSize() == 2);
+
+    classifier.SetVisualIndex(&index);
+    ClassificationResult bgra_result = classifier.Classify(bgra);
+    ClassificationResult gray_result = classifier.Classify(gray);
+    classifier.SetVisualIndex(nullptr);
+
+    REQUIRE(bgra_result.paint == "Crimson");
+    REQUIRE(gray_result.paint == "Grey");
+    REQUIRE(index.GetSize() == 2);
+}
+
 TEST_CASE("ExtractColor successfully extracts and removes paints") {
     std::vector<std::string> extracted = {"wildcat", "COBALT", "ears"};
     std::string color = classifier.ExtractColor(extracted);
@@ -58,6 +204,21 @@ TEST_CASE("ExtractCertification extracts and removes certifications and modifier
     REQUIRE(extracted.size() == 2);
 }
 
+TEST_CASE("ExtractCertification extracts hyphenated certifications") {
+    std::vector<std::string> extracted = {"SHOW-OFF", "toon", "sketch"};
+    std::string cert = classifier.ExtractCertification(extracted);
+    REQUIRE(cert == "Show-Off");
+    REQUIRE(extracted.size() == 2);
+}
+
+TEST_CASE("ExtractColor leaves certifications for ExtractCertification") {
+    std::vector<std::string> extracted = {"paragon", "wildcat", "COBALT", "ears"};
+    std::string color = classifier.ExtractColor(extracted);
+    REQUIRE(color == "Cobalt");
+    REQUIRE(extracted.size() == 3);
+    REQUIRE(classifier.ExtractCertification(extracted) == "Paragon");
+}
+
 TEST_CASE("ExtractCertification returns an empty string if uncertified item") {
     std::vector<std::string> extracted = {"wildcat", "ears",};
     std::string cert = classifier.ExtractCertification(extracted);
@@ -111,4 +272,51 @@ TEST_CASE("MatchTextToItemName returns an empty string if a match couldn't be ma
     words.push_back(word1);
     std::string solution = "";
     REQUIRE(solution == classifier.MatchTextToItemName(words));
-}
\ No newline at end of file
+}
+
+TEST_CASE("MatchClosestItemName tolerates misread characters") {
+    std::vector<std::string> words = {"GR", "Animus"};
+    float similarity;
+    REQUIRE(classifier.MatchClosestItemName(words, similarity) == "Animus GP");
+    REQUIRE(similarity > 0.75f);
+    REQUIRE(similarity < 1.0f);
+}
+
+TEST_CASE("MatchClosestItemName returns an empty string if no name is close") {
+    std::vector<std::string> words = {"Shouldnt", "Match"};
+    float similarity;
+    REQUIRE(classifier.MatchClosestItemName(words, similarity).empty());
+}
+
+TEST_CASE("ClassifyRecording matches recorded words without an image") {
+    TokenRecord record;
+    record.label_paint = "Cobalt";
+    record.label_confidence = 0.9f;
+
+    RecordedPass band;
+    band.step = RecordedStep::TextBand;
+    band.words.push_back({"Animus", 0.95f});
+    band.words.push_back({"GP", 0.9f});
+    record.passes.push_back(band);
+
+    ClassificationResult result = classifier.ClassifyRecording(record);
+    REQUIRE(result.name == "Animus GP");
+    REQUIRE(result.paint == "Cobalt");
+    REQUIRE(result.name_confidence > 0.9f);
+}
+
+TEST_CASE("ClassifyRecording escalates to later steps like Classify") {
+    TokenRecord record;
+    RecordedPass band;
+    band.step = RecordedStep::TextBand;
+    band.words.push_back({"Shouldnt", 0.3f});
+    RecordedPass boxes;
+    boxes.step = RecordedStep::TextBoxes;
+    boxes.words.push_back({"GR", 0.9f});
+    boxes.words.push_back({"Animus", 0.9f});
+    record.passes = {band, boxes};
+
+    // The misread box words are matched by MatchClosestItemName() once no step is confident
+    ClassificationResult result = classifier.ClassifyRecording(record);
+    REQUIRE(result.name == "Animus GP");
+}
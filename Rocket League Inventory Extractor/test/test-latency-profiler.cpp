@@ -0,0 +1,90 @@
+#include <string>
+
+#include "../catch.hpp"
+#include "../src/LatencyProfiler.h"
+#include "../src/MemoryUsage.h"
+
+TEST_CASE("LatencyProfiler starts empty") {
+    LatencyProfiler profiler;
+    REQUIRE(profiler.GetCount(PipelineStage::Forward) == 0);
+    REQUIRE(profiler.GetPercentile(PipelineStage::Forward, 50) == 0);
+    REQUIRE(profiler.GetMean(PipelineStage::Forward) == 0);
+}
+
+TEST_CASE("Record counts each run of a stage") {
+    LatencyProfiler profiler;
+    profiler.Record(PipelineStage::Forward, 100);
+    profiler.Record(PipelineStage::Forward, 200);
+    profiler.Record(PipelineStage::Decode, 50);
+    REQUIRE(profiler.GetCount(PipelineStage::Forward) == 2);
+    REQUIRE(profiler.GetCount(PipelineStage::Decode) == 1);
+    REQUIRE(profiler.GetMean(PipelineStage::Forward) == Approx(150));
+}
+
+TEST_CASE("GetPercentile is accurate to within a bucket") {
+    LatencyProfiler profiler;
+    for (int i = 1; i <= 100; i++) {
+        profiler.Record(PipelineStage::RecognizeBox, i * 1000);
+    }
+    double p50 = profiler.GetPercentile(PipelineStage::RecognizeBox, 50);
+    double p99 = profiler.GetPercentile(PipelineStage::RecognizeBox, 99);
+    REQUIRE(p50 >= 50000);
+    REQUIRE(p50 <= 50000 * 1.2);
+    REQUIRE(p99 >= 99000);
+    REQUIRE(p99 <= 99000 * 1.2);
+}
+
+TEST_CASE("Reset clears every stage") {
+    LatencyProfiler profiler;
+    profiler.Record(PipelineStage::MatchName, 10);
+    profiler.Reset();
+    REQUIRE(profiler.GetCount(PipelineStage::MatchName) == 0);
+}
+
+TEST_CASE("Report lists only recorded stages") {
+    LatencyProfiler profiler;
+    profiler.Record(PipelineStage::Forward, 1000);
+    std::string report = profiler.Report();
+    REQUIRE(report.find("Forward") != std::string::npos);
+    REQUIRE(report.find("Decode") == std::string::npos);
+}
+
+TEST_CASE("ScopedStageTimer records to the global profiler") {
+    uint64_t before = LatencyProfiler::Global().GetCount(PipelineStage::InitOcr);
+    {
+        ScopedStageTimer timer(PipelineStage::InitOcr);
+    }
+    REQUIRE(LatencyProfiler::Global().GetCount(PipelineStage::InitOcr) == before + 1);
+}
+
+TEST_CASE("RecordMemory keeps the peak and sums the growth of a stage") {
+    LatencyProfiler profiler;
+    profiler.RecordMemory(PipelineStage::Forward, 300, 200);
+    profiler.RecordMemory(PipelineStage::Forward, 250, -50);
+    REQUIRE(profiler.GetPeakResidentBytes(PipelineStage::Forward) == 300);
+    REQUIRE(profiler.GetMemoryGrowth(PipelineStage::Forward) == 150);
+
+    profiler.Reset();
+    REQUIRE(profiler.GetPeakResidentBytes(PipelineStage::Forward) == 0);
+}
+
+TEST_CASE("ScopedStageTimer records memory only while tracking is on") {
+    LatencyProfiler& profiler = LatencyProfiler::Global();
+    profiler.Reset();
+    {
+        ScopedStageTimer timer(PipelineStage::Decode);
+    }
+    REQUIRE(profiler.GetPeakResidentBytes(PipelineStage::Decode) == 0);
+
+    profiler.SetMemoryTracking(true);
+    {
+        ScopedStageTimer timer(PipelineStage::Decode);
+    }
+    REQUIRE(profiler.GetPeakResidentBytes(PipelineStage::Decode) > 0);
+    REQUIRE(profiler.Report().find("Peak (MB)") != std::string::npos);
+    profiler.SetMemoryTracking(false);
+}
+
+TEST_CASE("GetResidentBytes reads the memory used by the process") {
+    REQUIRE(GetResidentBytes() > 0);
+}
@@ -0,0 +1,64 @@
+#include <algorithm>
+#include <filesystem>
+#include <fstream>
+#include <string>
+#include <vector>
+
+#include "../catch.hpp"
+#include "../src/OcrVocabulary.h"
+
+OcrVocabulary vocabulary({"Octane - MG-88", "Wildcat Ears", "Animus GP"});
+
+// Returns whether a word is in a vocabulary list
+bool Contains(const std::vector<std::string>& words, const std::string& word) {
+    return std::find(words.begin(), words.end(), word) != words.end();
+}
+
+TEST_CASE("OcrVocabulary collects the words of item names") {
+    const std::vector<std::string>& words = vocabulary.GetWords();
+    REQUIRE(Contains(words, "Octane"));
+    REQUIRE(Contains(words, "MG-88"));
+    REQUIRE(Contains(words, "Ears"));
+    REQUIRE_FALSE(Contains(words, "-"));
+    REQUIRE(std::is_sorted(words.begin(), words.end()));
+}
+
+TEST_CASE("OcrVocabulary adds paints and certifications in capitals") {
+    const std::vector<std::string>& words = vocabulary.GetWords();
+    REQUIRE(Contains(words, "Cobalt"));
+    REQUIRE(Contains(words, "COBALT"));
+    REQUIRE(Contains(words, "SIENNA"));
+    REQUIRE(Contains(words, "Show-Off"));
+}
+
+TEST_CASE("OcrVocabulary turns words with digits into patterns") {
+    REQUIRE(vocabulary.GetPatterns() == std::vector<std::string>{"MG-\\d\\d"});
+}
+
+TEST_CASE("OcrVocabulary whitelists only the characters it uses") {
+    const std::string& whitelist = vocabulary.GetWhitelist();
+    REQUIRE(whitelist.find('W') != std::string::npos);
+    REQUIRE(whitelist.find('-') != std::string::npos);
+    REQUIRE(whitelist.find('0') != std::string::npos);
+    REQUIRE(whitelist.find('@') == std::string::npos);
+    REQUIRE(whitelist.find(' ') == std::string::npos);
+}
+
+TEST_CASE("OcrVocabulary writes a config that loads its files") {
+    std::string directory = std::filesystem::temp_directory_path().string();
+    std::string path_to_config = vocabulary.WriteTesseractConfig(directory);
+    REQUIRE(!path_to_config.empty());
+
+    std::ifstream config(path_to_config);
+    std::string line;
+    std::getline(config, line);
+    REQUIRE(line.rfind("user_words_file ", 0) == 0);
+    std::string path_to_words = line.substr(line.find(' ') + 1);
+
+    std::ifstream words(path_to_words);
+    std::getline(words, line);
+    REQUIRE(line == vocabulary.GetWords().front());
+
+    // The same vocabulary is written to the same files
+    REQUIRE(vocabulary.WriteTesseractConfig(directory) == path_to_config);
+}
@@ -0,0 +1,57 @@
+#include <string>
+#include <opencv2/opencv.hpp>
+
+#include "../catch.hpp"
+#include "../src/PaintDetector.h"
+
+PaintDetector detector;
+
+// Draws an item tile with an optional paint label above the item name
+cv::Mat MakeItemTile(bool painted, cv::Scalar label_color, std::string label) {
+    cv::Mat tile(155, 139, CV_8UC3, cv::Scalar(50, 30, 15));
+    if (painted) {
+        cv::rectangle(tile, cv::Rect(40, 101, 60, 17), label_color, cv::FILLED);
+        cv::putText(tile, label, cv::Point(44, 114), cv::FONT_HERSHEY_SIMPLEX,
+                    0.35, cv::Scalar(255, 255, 255), 1, cv::LINE_AA);
+    }
+    cv::putText(tile, "Wildcat Ears", cv::Point(20, 135),
+                cv::FONT_HERSHEY_SIMPLEX, 0.4, cv::Scalar(230, 150, 120), 1,
+                cv::LINE_AA);
+    return tile;
+}
+
+TEST_CASE("DetectPaint finds the paint label of a painted item") {
+    cv::Mat tile = MakeItemTile(true, cv::Scalar(255, 71, 41), "COBALT");
+    REQUIRE(detector.DetectPaint(tile) == "Cobalt");
+}
+
+TEST_CASE("DetectPaint finds two-word paints") {
+    cv::Mat tile = MakeItemTile(true, cv::Scalar(21, 36, 94), "BURNT SIENNA");
+    REQUIRE(detector.DetectPaint(tile) == "Burnt Sienna");
+}
+
+TEST_CASE("DetectPaint reports how solid the paint label is") {
+    cv::Mat tile = MakeItemTile(true, cv::Scalar(255, 71, 41), "COBALT");
+    float confidence;
+    REQUIRE(detector.DetectPaint(tile, confidence) == "Cobalt");
+    REQUIRE(confidence > 0.75f);
+    REQUIRE(confidence <= 1.0f);
+
+    REQUIRE(detector.DetectPaint(MakeItemTile(false, cv::Scalar(), ""), confidence).empty());
+    REQUIRE(confidence == 0);
+}
+
+TEST_CASE("DetectPaint returns an empty string for unpainted items") {
+    cv::Mat tile = MakeItemTile(false, cv::Scalar(), "");
+    REQUIRE(detector.DetectPaint(tile).empty());
+}
+
+TEST_CASE("DetectPaint ignores item art that spans the whole tile") {
+    cv::Mat tile = MakeItemTile(false, cv::Scalar(), "");
+    tile(cv::Rect(0, 95, 139, 30)).setTo(cv::Scalar(255, 71, 41));
+    REQUIRE(detector.DetectPaint(tile).empty());
+}
+
+TEST_CASE("DetectPaint returns an empty string for an empty image") {
+    REQUIRE(detector.DetectPaint(cv::Mat()).empty());
+}
@@ -0,0 +1,91 @@
+#include <cstdio>
+#include <string>
+#include <vector>
+#include <opencv2/opencv.hpp>
+
+#include "../catch.hpp"
+#include "../src/RecordingIngester.h"
+
+ItemClassifier recording_classifier(
+    "C:\\Users\\Unknown_User\\Documents\\openFrameworks\\apps\\fantastic-"
+    "finale-astudent82828211\\Rocket League Inventory "
+    "Extractor\\frozen_east_text_detection.pb",
+    "C:\\Users\\Unknown_User\\Documents\\openFrameworks\\apps\\fantastic-"
+    "finale-astudent82828211\\Rocket League Inventory Extractor\\Prices.json");
+
+// Draws a tile with item art in the given color, an optional certification and an item name
+cv::Mat MakeRecordedTile(const cv::Scalar& art_color, const std::string& name,
+                         const std::string& certification = "") {
+    cv::Mat tile(155, 137, CV_8UC3, cv::Scalar(71, 56, 39));
+    cv::circle(tile, cv::Point(68, 55), 35, art_color, cv::FILLED);
+    cv::putText(tile, certification, cv::Point(15, 122), cv::FONT_HERSHEY_SIMPLEX, 0.3,
+                cv::Scalar(240, 240, 240), 1, cv::LINE_AA);
+    cv::putText(tile, name, cv::Point(15, 140), cv::FONT_HERSHEY_SIMPLEX, 0.45,
+                cv::Scalar(230, 140, 90), 1, cv::LINE_AA);
+    return tile;
+}
+
+TEST_CASE("RecordingIngester reads each slot once and classifies each distinct tile once") {
+    // Five rows of two tiles; slots 5, 7 and 9 repeat slots 0, 2 and 4, while slots 1 and 8
+    // are slot 0 and 2 in another paint and slot 3 is slot 2 with a certification
+    std::vector<cv::Mat> tiles = {
+        MakeRecordedTile(cv::Scalar(255, 71, 41), "Wildcat Ears"),
+        MakeRecordedTile(cv::Scalar(28, 23, 168), "Wildcat Ears"),
+        MakeRecordedTile(cv::Scalar(20, 140, 240), "Toon Sketch"),
+        MakeRecordedTile(cv::Scalar(20, 140, 240), "Toon Sketch", "Paragon"),
+        MakeRecordedTile(cv::Scalar(90, 200, 60), "Hexed"),
+        MakeRecordedTile(cv::Scalar(255, 71, 41), "Wildcat Ears"),
+        MakeRecordedTile(cv::Scalar(200, 200, 200), "Salty"),
+        MakeRecordedTile(cv::Scalar(20, 140, 240), "Toon Sketch"),
+        MakeRecordedTile(cv::Scalar(240, 140, 20), "Toon Sketch"),
+        MakeRecordedTile(cv::Scalar(90, 200, 60), "Hexed")};
+    InventoryGrid grid = {cv::Rect(20, 30, 286, 501), 2, 137, 155, 12, 12};
+    const int row_pitch = grid.cell_height + grid.spacing_y;
+
+    // The whole inventory, of which three rows are visible at a time
+    cv::Mat inventory_grid(5 * row_pitch, grid.region.width, CV_8UC3, cv::Scalar(30, 20, 10));
+    for (size_t i = 0; i < tiles.size(); ++i) {
+        int row = static_cast<int>(i) / grid.columns, column = static_cast<int>(i) % grid.columns;
+        tiles[i].copyTo(inventory_grid(cv::Rect(column * (grid.cell_width + grid.spacing_x),
+                                                row * row_pitch, grid.cell_width,
+                                                grid.cell_height)));
+    }
+
+    // Each frame is scrolled down by one row
+    std::vector<std::string> frames;
+    for (int scroll = 0; scroll < 3; ++scroll) {
+        cv::Mat frame(grid.region.y + grid.region.height + 20, grid.region.x + grid.region.width + 20,
+                      CV_8UC3, cv::Scalar(60, 60, 60));
+        inventory_grid.rowRange(scroll * row_pitch, scroll * row_pitch + grid.region.height)
+            .copyTo(frame(grid.region));
+        frames.push_back("test-recording-0" + std::to_string(scroll) + ".png");
+        cv::imwrite(frames.back(), frame);
+    }
+
+    ItemDatabase database;
+    Inventory inventory;
+    RecordingIngester ingester(recording_classifier, database, grid);
+    REQUIRE(ingester.Ingest("test-recording-%02d.png", inventory) == 3);
+    REQUIRE(ingester.GetSlotCount() == 10);
+    REQUIRE(ingester.GetClassifiedTileCount() == 7);
+    for (const std::string& frame : frames) std::remove(frame.c_str());
+}
+
+TEST_CASE("RecordingIngester skips empty slots but not tiles that vary in any channel") {
+    InventoryGrid grid = {cv::Rect(0, 0, 286, 334), 2, 137, 155, 12, 12};
+    cv::Mat frame(334, 286, CV_8UC3, cv::Scalar(30, 20, 10));
+    MakeRecordedTile(cv::Scalar(255, 71, 41), "Wildcat Ears").copyTo(frame(cv::Rect(0, 0, 137, 155)));
+
+    // Art drawn only in green and red leaves the blue channel flat
+    cv::Mat green_tile = frame(cv::Rect(149, 0, 137, 155));
+    cv::circle(green_tile, cv::Point(68, 55), 35, cv::Scalar(30, 200, 120), cv::FILLED);
+    cv::imwrite("test-recording-00.png", frame);
+
+    // The second row is empty
+    ItemDatabase database;
+    Inventory inventory;
+    RecordingIngester ingester(recording_classifier, database, grid);
+    REQUIRE(ingester.Ingest("test-recording-%02d.png", inventory) == 1);
+    REQUIRE(ingester.GetSlotCount() == 2);
+    std::remove("test-recording-00.png");
+}
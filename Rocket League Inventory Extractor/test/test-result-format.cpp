@@ -0,0 +1,46 @@
+#include <string>
+
+#include "../catch.hpp"
+#include "../src/ResultFormat.h"
+
+TEST_CASE("ParseOutputFormat recognizes jsonl and csv") {
+    OutputFormat format;
+    REQUIRE(ParseOutputFormat("csv", format));
+    REQUIRE(format == OutputFormat::Csv);
+    REQUIRE(ParseOutputFormat("jsonl", format));
+    REQUIRE(format == OutputFormat::JsonLines);
+    REQUIRE_FALSE(ParseOutputFormat("xml", format));
+}
+
+TEST_CASE("FormatResult writes a JSON object per line") {
+    ClassifiedImage image;
+    image.path = "shots\\\"quoted\".png";
+    image.succeeded = true;
+    image.result.name = "Octane - MG-88";
+    image.result.paint = "Cobalt";
+    image.result.name_confidence = 0.5f;
+    image.price = "40-50";
+
+    REQUIRE(FormatResult(image, OutputFormat::JsonLines) ==
+            "{\"path\":\"shots\\\\\\\"quoted\\\".png\",\"name\":\"Octane - MG-88\","
+            "\"paint\":\"Cobalt\",\"certification\":\"\",\"price\":\"40-50\","
+            "\"name_confidence\":0.5000,\"paint_confidence\":0.0000,"
+            "\"certification_confidence\":0.0000,\"error\":\"\"}\n");
+}
+
+TEST_CASE("FormatResult writes CSV rows that match the header") {
+    ClassifiedImage image;
+    image.path = "shots/a,b.png";
+    REQUIRE(FormatResultHeader(OutputFormat::Csv) ==
+            "path,name,paint,certification,price,name_confidence,paint_confidence,"
+            "certification_confidence,error\n");
+    REQUIRE(FormatResultHeader(OutputFormat::JsonLines).empty());
+    REQUIRE(FormatResult(image, OutputFormat::Csv) ==
+            "\"shots/a,b.png\",,,,,0.0000,0.0000,0.0000,image could not be read\n");
+}
+
+TEST_CASE("QuoteCsvField only quotes fields that need it") {
+    REQUIRE(QuoteCsvField("Octane") == "Octane");
+    REQUIRE(QuoteCsvField("say \"hi\"") == "\"say \"\"hi\"\"\"");
+    REQUIRE(QuoteCsvField("two\nlines") == "\"two\nlines\"");
+}
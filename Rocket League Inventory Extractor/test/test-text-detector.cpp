@@ -0,0 +1,202 @@
+#include <cstdio>
+#include <fstream>
+#include <random>
+#include <string>
+#include <vector>
+#include <opencv2/opencv.hpp>
+
+#include "../catch.hpp"
+#include "../src/TextDetector.h"
+
+// Exposes the preprocessing and decoding of DbTextDetector so they can be tested without a model
+class DecodingDbTextDetector : public DbTextDetector {
+   public:
+    using DbTextDetector::DbTextDetector;
+    using DbTextDetector::DecodeBoxes;
+    using DbTextDetector::WriteToBlob;
+};
+
+// Exposes the decoding of EastTextDetector so it can be tested without a model
+class DecodingEastTextDetector : public EastTextDetector {
+   public:
+    using EastTextDetector::EastTextDetector;
+    using EastTextDetector::DecodeBoxes;
+};
+
+TEST_CASE("GuessDetectorModel recognizes DB and EAST model files") {
+    REQUIRE(GuessDetectorModel("frozen_east_text_detection.pb") == DetectorModel::East);
+    REQUIRE(GuessDetectorModel("C:\\models\\DB_TD500_resnet18.onnx") == DetectorModel::Db);
+    REQUIRE(GuessDetectorModel("models/db_resnet18_int8.ONNX") == DetectorModel::Db);
+    REQUIRE(GuessDetectorModel("models/east_int8.onnx") == DetectorModel::East);
+}
+
+TEST_CASE("Detector models and backends are parsed from their names") {
+    DetectorModel model;
+    REQUIRE(ParseDetectorModel("DB", model));
+    REQUIRE(model == DetectorModel::Db);
+    REQUIRE(GetDetectorModelName(model) == "db");
+    REQUIRE_FALSE(ParseDetectorModel("yolo", model));
+
+    DetectorBackend backend;
+    REQUIRE(ParseDetectorBackend("openvino", backend));
+    REQUIRE(backend == DetectorBackend::OpenVino);
+    REQUIRE(GetDetectorBackendName(backend) == "openvino");
+    REQUIRE_FALSE(ParseDetectorBackend("cuda", backend));
+
+    REQUIRE(IsBackendAvailable(DetectorBackend::OpenCv));
+}
+
+TEST_CASE("WriteToBlob writes the same blob as blobFromImage") {
+    std::mt19937 random(5);
+    cv::Mat image(90, 130, CV_8UC3);
+    for (size_t i = 0; i < image.total() * 3; i++) image.data[i] = static_cast<unsigned char>(random());
+
+    DecodingDbTextDetector detector("", DetectorBackend::OpenCv);
+    int shape[] = {2, 3, 64, 96};
+    cv::Mat blob(4, shape, CV_32F, cv::Scalar(0));
+    const cv::Scalar mean(122.7, 116.7, 104.0);
+    const int values = 3 * 64 * 96;  // The values of one image of the blob
+
+    // Resized, with the channels swapped to RGB, then at its own size with a scale
+    cv::Mat expected;
+    detector.WriteToBlob(image, 1, mean, true, blob, 0);
+    cv::dnn::blobFromImage(image, expected, 1, cv::Size(96, 64), mean, true, false);
+    REQUIRE(cv::norm(cv::Mat(1, values, CV_32F, blob.ptr<float>(0)),
+                     cv::Mat(1, values, CV_32F, expected.ptr<float>()), cv::NORM_INF) == 0);
+
+    cv::Mat tile = image(cv::Rect(0, 0, 96, 64));
+    detector.WriteToBlob(tile, 1.0 / 255, mean, false, blob, 1);
+    cv::dnn::blobFromImage(tile, expected, 1.0 / 255, cv::Size(96, 64), mean, false, false);
+    REQUIRE(cv::norm(cv::Mat(1, values, CV_32F, blob.ptr<float>(1)),
+                     cv::Mat(1, values, CV_32F, expected.ptr<float>()), cv::NORM_INF) < 1e-5);
+}
+
+TEST_CASE("DB decoding turns a region of text pixels into one grown box") {
+    int shape[] = {1, 1, 64, 96};
+    cv::Mat output(4, shape, CV_32F, cv::Scalar(0));
+    cv::Mat probability(64, 96, CV_32F, output.ptr<float>());
+    probability(cv::Rect(20, 28, 50, 8)).setTo(cv::Scalar(0.9));
+
+    DecodingDbTextDetector detector("", DetectorBackend::OpenCv);
+    TextDetections detections;
+    detector.DecodeBoxes({output}, 0, detections);
+
+    REQUIRE(detections.boxes.size() == 1);
+    REQUIRE(detections.confidences[0] == Approx(0.9f).margin(0.01));
+
+    // The region was shrunk in training, so the box is larger than the text pixels
+    cv::Rect bounds = detections.boxes[0].boundingRect();
+    REQUIRE(bounds.width > 50);
+    REQUIRE(bounds.height > 8);
+    REQUIRE(detections.boxes[0].center.x == Approx(44.5f).margin(1));
+    REQUIRE(detections.boxes[0].center.y == Approx(31.5f).margin(1));
+}
+
+TEST_CASE("DB decoding ignores faint and thin regions") {
+    int shape[] = {1, 1, 64, 96};
+    cv::Mat output(4, shape, CV_32F, cv::Scalar(0));
+    cv::Mat probability(64, 96, CV_32F, output.ptr<float>());
+    probability(cv::Rect(10, 10, 40, 10)).setTo(cv::Scalar(0.4));  // Below the confidence threshold
+    probability(cv::Rect(10, 40, 40, 1)).setTo(cv::Scalar(0.9));  // A line, not text
+
+    DecodingDbTextDetector detector("", DetectorBackend::OpenCv);
+    TextDetections detections;
+    detector.DecodeBoxes({output}, 0, detections);
+    REQUIRE(detections.boxes.empty());
+}
+
+TEST_CASE("DB detection runs a network and finds the text in its probability map") {
+    // A network without weights whose probability map is the blue channel of DB's input, doubled,
+    // so white pixels are certainly text and black pixels are certainly not
+    const char* path = "test-db-network.prototxt";
+    std::ofstream(path) << "input: \"data\"\n"
+                           "input_shape { dim: 1 dim: 3 dim: 64 dim: 96 }\n"
+                           "layer { name: \"slice\" type: \"Slice\" bottom: \"data\" "
+                           "top: \"blue\" top: \"rest\" slice_param { axis: 1 slice_point: 1 } }\n"
+                           "layer { name: \"map\" type: \"Power\" bottom: \"blue\" top: \"map\" "
+                           "power_param { scale: 2 } }\n";
+
+    cv::Mat image(64, 96, CV_8UC3, cv::Scalar(0, 0, 0));
+    image(cv::Rect(20, 28, 50, 8)).setTo(cv::Scalar(255, 255, 255));
+
+    cv::Mat blank(image.size(), CV_8UC3, cv::Scalar(0, 0, 0));
+
+    DbTextDetector detector(path, DetectorBackend::OpenCv);
+    std::vector<TextDetections> detections = detector.Detect({image, blank}, image.size());
+    std::remove(path);
+
+    REQUIRE(detections.size() == 2);
+    REQUIRE(detections[0].boxes.size() == 1);
+    REQUIRE(detections[0].confidences[0] > 0.9f);
+    REQUIRE(detections[0].boxes[0].center.x == Approx(44.5f).margin(1));
+    REQUIRE(detections[0].boxes[0].center.y == Approx(31.5f).margin(1));
+    REQUIRE(detections[1].boxes.empty());
+}
+
+TEST_CASE("EAST decoding only decodes the most confident cells of each region") {
+    int score_shape[] = {1, 1, 8, 16};
+    int geometry_shape[] = {1, 5, 8, 16};
+    cv::Mat scores(4, score_shape, CV_32F, cv::Scalar(0));
+    cv::Mat geometry(4, geometry_shape, CV_32F, cv::Scalar(0));
+
+    // A word from (8, 8) to (48, 24) covers cells in several regions, all predicting its box
+    int cells = 0;
+    for (int y = 2; y <= 6; y++) {
+        for (int x = 2; x <= 12; x++) {
+            scores.ptr<float>(0, 0, y)[x] = 0.6f + 0.01f * x;
+            geometry.ptr<float>(0, 0, y)[x] = y * 4.0f - 8;
+            geometry.ptr<float>(0, 1, y)[x] = 48 - x * 4.0f;
+            geometry.ptr<float>(0, 2, y)[x] = 24 - y * 4.0f;
+            geometry.ptr<float>(0, 3, y)[x] = x * 4.0f - 8;
+            cells++;
+        }
+    }
+
+    DecodingEastTextDetector detector("", DetectorBackend::OpenCv);
+    TextDetections detections;
+    detector.DecodeBoxes({scores, geometry}, 0, detections);
+
+    REQUIRE(detections.boxes.size() < static_cast<size_t>(cells));
+    REQUIRE(detections.boxes.size() == detections.confidences.size());
+    for (const cv::RotatedRect& box : detections.boxes) {
+        REQUIRE(box.center.x == Approx(28).margin(0.5));
+        REQUIRE(box.center.y == Approx(16).margin(0.5));
+        REQUIRE(box.size.width == Approx(40).margin(0.5));
+    }
+
+    std::vector<int> kept = SuppressOverlappingBoxes(detections.boxes, detections.confidences, 0.4f);
+    REQUIRE(kept.size() == 1);
+    REQUIRE(detections.confidences[kept[0]] == Approx(0.72f));
+}
+
+TEST_CASE("SuppressOverlappingBoxes keeps the most confident of overlapping boxes") {
+    std::vector<cv::RotatedRect> boxes = {
+        cv::RotatedRect(cv::Point2f(50, 20), cv::Size2f(60, 16), 0),
+        cv::RotatedRect(cv::Point2f(52, 21), cv::Size2f(60, 16), 3),  // Nearly the same box
+        cv::RotatedRect(cv::Point2f(150, 20), cv::Size2f(60, 16), 0),  // Far from the others
+        cv::RotatedRect(cv::Point2f(50, 20), cv::Size2f(20, 8), 0)};  // Inside the first box
+    std::vector<float> confidences = {0.7f, 0.9f, 0.6f, 0.8f};
+
+    // A box inside a kept box counts as a full overlap, however small it is, as in NMSBoxes
+    REQUIRE(SuppressOverlappingBoxes(boxes, confidences, 0.4f) == std::vector<int>{1, 2});
+    boxes[3].center.x = 22;  // Now only partly inside the kept box
+    REQUIRE(SuppressOverlappingBoxes(boxes, confidences, 0.4f) == std::vector<int>{1, 3, 2});
+    REQUIRE(SuppressOverlappingBoxes({}, {}, 0.4f).empty());
+}
+
+TEST_CASE("SuppressOverlappingBoxes keeps the same boxes as NMSBoxes") {
+    std::mt19937 random(11);
+    std::uniform_real_distribution<float> position(0, 200), width(10, 80), height(6, 30),
+        angle(-20, 20), confidence(0.5f, 1);
+    std::vector<cv::RotatedRect> boxes;
+    std::vector<float> confidences;
+    for (int i = 0; i < 300; i++) {
+        boxes.push_back(cv::RotatedRect(cv::Point2f(position(random), position(random) / 2),
+                                        cv::Size2f(width(random), height(random)), angle(random)));
+        confidences.push_back(confidence(random));
+    }
+
+    std::vector<int> expected;
+    cv::dnn::NMSBoxes(boxes, confidences, 0, 0.4f, expected);
+    REQUIRE(SuppressOverlappingBoxes(boxes, confidences, 0.4f) == expected);
+}
@@ -0,0 +1,36 @@
+#include <string>
+
+#include "../catch.hpp"
+#include "../src/TextNormalizer.h"
+
+TEST_CASE("NormalizeText in Word mode keeps spaces between words") {
+    REQUIRE(NormalizeText("Wildcat Ears", NormalizationMode::Word) == "wildcat ears");
+}
+
+TEST_CASE("NormalizeText in Word mode drops a hyphen and the space after it") {
+    REQUIRE(NormalizeText("Octane - MG-88", NormalizationMode::Word) == "octane mg88");
+    REQUIRE(NormalizeText("SHOW-OFF", NormalizationMode::Word) == "showoff");
+}
+
+TEST_CASE("NormalizeText in Key mode drops every space and hyphen") {
+    REQUIRE(NormalizeText("Octane - MG-88", NormalizationMode::Key) == "octanemg88");
+    REQUIRE(NormalizeText("Burnt Sienna", NormalizationMode::Key) == "burntsienna");
+}
+
+TEST_CASE("NormalizeText removes OCR noise in both modes") {
+    std::string noisy = "[Animus:] {GP}!/\\.;_\n";
+    REQUIRE(NormalizeText(noisy, NormalizationMode::Word) == "animus gp");
+    REQUIRE(NormalizeText(noisy, NormalizationMode::Key) == "animusgp");
+}
+
+TEST_CASE("NormalizeText keeps bytes outside ASCII") {
+    REQUIRE(NormalizeText("J\xC3\xA4GER", NormalizationMode::Key) == "j\xC3\xA4ger");
+}
+
+TEST_CASE("NormalizeText replaces the contents of a reused buffer") {
+    std::string buffer = "a much longer previous value";
+    NormalizeText("Toon", NormalizationMode::Word, buffer);
+    REQUIRE(buffer == "toon");
+    NormalizeText("", NormalizationMode::Word, buffer);
+    REQUIRE(buffer.empty());
+}
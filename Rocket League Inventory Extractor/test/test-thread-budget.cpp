@@ -0,0 +1,47 @@
+#include <string>
+#include <vector>
+
+#include "../catch.hpp"
+#include "../src/ThreadBudget.h"
+
+TEST_CASE("SplitThreadBudget gives every worker an equal share of the cores") {
+    ThreadBudget budget = SplitThreadBudget(4, 16);
+    REQUIRE(budget.workers == 4);
+    REQUIRE(budget.intra_op_threads == 4);
+
+    // More workers than cores still get one thread each
+    budget = SplitThreadBudget(32, 16);
+    REQUIRE(budget.workers == 32);
+    REQUIRE(budget.intra_op_threads == 1);
+
+    budget = SplitThreadBudget(0, 0);
+    REQUIRE(budget.workers == 1);
+    REQUIRE(budget.intra_op_threads == 1);
+}
+
+TEST_CASE("ListThreadBudgets lists each split once and never exceeds the cores") {
+    std::vector<ThreadBudget> budgets = ListThreadBudgets(8);
+    std::vector<std::string> listed;
+    for (const ThreadBudget& budget : budgets) {
+        REQUIRE(budget.workers * budget.intra_op_threads <= 8);
+        listed.push_back(FormatThreadBudget(budget));
+    }
+    REQUIRE(listed == std::vector<std::string>{"1x8", "2x4", "4x2", "8x1"});
+
+    REQUIRE(ListThreadBudgets(1).size() == 1);
+    REQUIRE(FormatThreadBudget(ListThreadBudgets(6)[2]) == "3x2");
+}
+
+TEST_CASE("ParseThreadBudget reads what FormatThreadBudget writes") {
+    ThreadBudget budget;
+    REQUIRE(ParseThreadBudget("8x2", budget));
+    REQUIRE(budget.workers == 8);
+    REQUIRE(budget.intra_op_threads == 2);
+    REQUIRE(FormatThreadBudget(budget) == "8x2");
+
+    REQUIRE_FALSE(ParseThreadBudget("0x2", budget));
+    REQUIRE_FALSE(ParseThreadBudget("8x", budget));
+    REQUIRE_FALSE(ParseThreadBudget("8", budget));
+    REQUIRE_FALSE(ParseThreadBudget("8x-2", budget));
+    REQUIRE(budget.workers == 8);
+}
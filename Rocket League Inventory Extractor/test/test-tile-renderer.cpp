@@ -0,0 +1,46 @@
+#include <string>
+#include <opencv2/opencv.hpp>
+
+#include "../catch.hpp"
+#include "../src/InventoryItem.h"
+#include "../src/PaintDetector.h"
+#include "../src/TileRenderer.h"
+
+InventoryItem painted_item("Wildcat Ears", "", "Cobalt", "Rare", true, "Topper", 1, "1-2");
+InventoryItem certified_item("Toon Sketch", "Show-Off", "Default", "Import", true, "Decal", 1, "1-2");
+
+TEST_CASE("RenderTile renders a tile of the in-game size") {
+    TileRenderer renderer(1);
+    cv::Mat tile = renderer.RenderTile(painted_item);
+    REQUIRE(tile.cols == 137);
+    REQUIRE(tile.rows == 155);
+    REQUIRE(tile.channels() == 3);
+}
+
+TEST_CASE("RenderTile scales the tile") {
+    TileRenderer renderer(1);
+    cv::Mat tile = renderer.RenderTile(painted_item, 2);
+    REQUIRE(tile.size() == renderer.GetTileSize(2));
+    REQUIRE(tile.cols == 274);
+}
+
+TEST_CASE("RenderTile draws a paint label the PaintDetector can read") {
+    TileRenderer renderer(1);
+    PaintDetector detector;
+    REQUIRE(detector.DetectPaint(renderer.RenderTile(painted_item)) == "Cobalt");
+    REQUIRE(detector.DetectPaint(renderer.RenderTile(painted_item, 3)) == "Cobalt");
+}
+
+TEST_CASE("RenderTile does not draw a paint label for unpainted items") {
+    TileRenderer renderer(1);
+    PaintDetector detector;
+    REQUIRE(detector.DetectPaint(renderer.RenderTile(certified_item)).empty());
+}
+
+TEST_CASE("RenderTile renders the same tile from the same seed") {
+    TileRenderer first(7);
+    TileRenderer second(7);
+    cv::Mat difference;
+    cv::absdiff(first.RenderTile(certified_item), second.RenderTile(certified_item), difference);
+    REQUIRE(cv::countNonZero(difference.reshape(1)) == 0);
+}
@@ -0,0 +1,79 @@
+#include <algorithm>
+#include <string>
+#include <vector>
+
+#include "../catch.hpp"
+#include "../src/TokenClassifier.h"
+
+TEST_CASE("NormalizeToken removes noise and converts to lowercase") {
+    REQUIRE(NormalizeToken("[Animus:]\n") == "animus");
+    REQUIRE(NormalizeToken("COBALT") == "cobalt");
+}
+
+TEST_CASE("NormalizeToken removes hyphens and the space after them") {
+    REQUIRE(NormalizeToken("Octane - MG-88") == "octane mg88");
+    REQUIRE(NormalizeToken("SHOW-OFF") == "showoff");
+}
+
+TEST_CASE("ClassifyToken recognizes every kind of token") {
+    std::string canonical;
+    REQUIRE(ClassifyToken("cobalt", canonical) == TokenKind::Paint);
+    REQUIRE(canonical == "Cobalt");
+    REQUIRE(ClassifyToken("sienna", canonical) == TokenKind::Paint);
+    REQUIRE(canonical == "Burnt Sienna");
+    REQUIRE(ClassifyToken("paragon", canonical) == TokenKind::Certification);
+    REQUIRE(canonical == "Paragon");
+
+    canonical.clear();
+    REQUIRE(ClassifyToken("burnt", canonical) == TokenKind::PaintModifier);
+    REQUIRE(ClassifyToken("capable", canonical) == TokenKind::CertificationModifier);
+    REQUIRE(ClassifyToken("wildcat", canonical) == TokenKind::NameWord);
+    REQUIRE(canonical.empty());
+}
+
+TEST_CASE("ClassifyToken does not match words that only share a slot") {
+    std::string canonical;
+    REQUIRE(ClassifyToken("", canonical) == TokenKind::NameWord);
+    REQUIRE(ClassifyToken("cobalts", canonical) == TokenKind::NameWord);
+    REQUIRE(ClassifyToken("Cobalt", canonical) == TokenKind::NameWord);
+}
+
+TEST_CASE("ClassifyTokens sorts paint, certification and name words at once") {
+    std::vector<std::string> extracted = {"CAPABLE", "SHOW-OFF", "BURNT", "SIENNA",
+                                          "Wildcat", "Ears"};
+    ClassifiedTokens tokens = ClassifyTokens(extracted);
+    REQUIRE(tokens.paint == "Burnt Sienna");
+    REQUIRE(tokens.certification == "Show-Off");
+    REQUIRE(tokens.name_words == std::vector<std::string>{"Wildcat", "Ears"});
+    REQUIRE(tokens.normalized_name_words == std::vector<std::string>{"wildcat", "ears"});
+}
+
+TEST_CASE("ClassifyTokens defaults to an unpainted, uncertified item") {
+    ClassifiedTokens tokens = ClassifyTokens({"Octane:", "MG-88"});
+    REQUIRE(tokens.paint == "Default");
+    REQUIRE(tokens.certification.empty());
+    REQUIRE(tokens.normalized_name_words == std::vector<std::string>{"octane", "mg88"});
+}
+
+TEST_CASE("ClassifyTokens gives every trait the confidence of its words") {
+    ClassifiedTokens tokens = ClassifyTokens({"COBALT", "Wildcat", "Ears"},
+                                             {0.9f, 0.8f, 0.6f});
+    REQUIRE(tokens.paint_confidence == Approx(0.9f));
+    REQUIRE(tokens.name_confidence == Approx(0.7f));
+
+    // No certification was read, so it is as certain as the text as a whole
+    REQUIRE(tokens.certification_confidence == Approx(0.7667f).epsilon(0.001));
+}
+
+TEST_CASE("ClassifyTokens leaves confidences at 0 without them") {
+    ClassifiedTokens tokens = ClassifyTokens({"Octane:", "MG-88"});
+    REQUIRE(tokens.name_confidence == 0);
+    REQUIRE(tokens.paint_confidence == 0);
+}
+
+TEST_CASE("GetTraitNames lists every paint, certification and modifier once") {
+    std::vector<std::string> names = GetTraitNames();
+    REQUIRE(std::count(names.begin(), names.end(), "Burnt Sienna") == 1);
+    REQUIRE(std::count(names.begin(), names.end(), "Show-Off") == 1);
+    REQUIRE(std::count(names.begin(), names.end(), "Capable") == 1);
+}
@@ -0,0 +1,91 @@
+#include <fstream>
+#include <iterator>
+#include <string>
+
+#include "../catch.hpp"
+#include "../src/TokenRecording.h"
+
+// Builds a record with a band pass and a text box pass
+static TokenRecord MakeRecord(const std::string& image_id) {
+    TokenRecord record;
+    record.image_id = image_id;
+    record.image_width = 220;
+    record.image_height = 260;
+    record.label_paint = "Cobalt";
+    record.label_confidence = 0.8f;
+
+    RecordedPass band;
+    band.step = RecordedStep::TextBand;
+    band.words.push_back({"COBALT", 0.9f, 0, 130, 220, 130});
+    band.words.push_back({"Wildcat", 0.85f, 0, 130, 220, 130});
+
+    RecordedPass boxes;
+    boxes.step = RecordedStep::TextBoxes;
+    boxes.words.push_back({"Ears", 0.6f, 40, 200, 60, 18});
+
+    record.passes = {band, boxes};
+    return record;
+}
+
+TEST_CASE("TokenRecordReader reads back what TokenRecordWriter wrote") {
+    {
+        TokenRecordWriter writer("test-tokens.rec");
+        REQUIRE(writer.IsOpen());
+        REQUIRE(writer.Write(MakeRecord("CobaltWildcatEars.png")));
+        REQUIRE(writer.Write(TokenRecord()));
+        REQUIRE(writer.GetCount() == 2);
+    }
+
+    TokenRecordReader reader("test-tokens.rec");
+    REQUIRE(reader.IsOpen());
+
+    TokenRecord record;
+    REQUIRE(reader.Next(record));
+    REQUIRE(record.image_id == "CobaltWildcatEars.png");
+    REQUIRE(record.image_width == 220);
+    REQUIRE(record.label_paint == "Cobalt");
+    REQUIRE(record.label_confidence == 0.8f);
+    REQUIRE(record.passes.size() == 2);
+    REQUIRE(record.passes[1].step == RecordedStep::TextBoxes);
+    REQUIRE(record.passes[0].words[1].text == "Wildcat");
+    REQUIRE(record.passes[0].words[1].confidence == 0.85f);
+    REQUIRE(record.passes[1].words[0].y == 200);
+    REQUIRE(record.passes[1].words[0].height == 18);
+
+    REQUIRE(reader.Next(record));
+    REQUIRE(record.image_id.empty());
+    REQUIRE(record.passes.empty());
+    REQUIRE_FALSE(reader.Next(record));
+}
+
+TEST_CASE("TokenRecordReader rejects files that are not recordings") {
+    std::ofstream("test-not-tokens.rec") << "image,name,paint,certification\n";
+    TokenRecord record;
+    TokenRecordReader reader("test-not-tokens.rec");
+    REQUIRE_FALSE(reader.IsOpen());
+    REQUIRE_FALSE(reader.Next(record));
+    REQUIRE_FALSE(TokenRecordReader("not an actual file").IsOpen());
+}
+
+TEST_CASE("TokenRecordReader stops at a record cut short") {
+    {
+        TokenRecordWriter writer("test-tokens.rec");
+        writer.Write(MakeRecord("first.png"));
+        writer.Write(MakeRecord("second.png"));
+    }
+
+    // Drop the last few bytes, as if the recording was stopped mid-write
+    std::string contents;
+    {
+        std::ifstream input("test-tokens.rec", std::ios::binary);
+        contents.assign(std::istreambuf_iterator<char>(input), std::istreambuf_iterator<char>());
+    }
+    std::ofstream("test-tokens.rec", std::ios::binary | std::ios::trunc)
+        << contents.substr(0, contents.size() - 5);
+
+    TokenRecordReader reader("test-tokens.rec");
+    TokenRecord record;
+    REQUIRE(reader.Next(record));
+    REQUIRE(record.image_id == "first.png");
+    REQUIRE_FALSE(reader.Next(record));
+}
@@ -0,0 +1,99 @@
+#include <cstdio>
+#include <filesystem>
+#include <string>
+#include <vector>
+#include <opencv2/opencv.hpp>
+
+#include "../catch.hpp"
+#include "../src/VisualIndex.h"
+
+std::string path_to_visual_index =
+    (std::filesystem::temp_directory_path() / "rl-visual-index-test.tsv").string();
+
+// Draws a tile with item art in the given color, an optional certification and an item name
+cv::Mat MakeIndexedTile(const cv::Scalar& art_color, const std::string& name,
+                        const std::string& certification = "") {
+    cv::Mat tile(155, 137, CV_8UC3, cv::Scalar(71, 56, 39));
+    cv::circle(tile, cv::Point(68, 55), 35, art_color, cv::FILLED);
+    cv::putText(tile, certification, cv::Point(15, 122), cv::FONT_HERSHEY_SIMPLEX, 0.3,
+                cv::Scalar(240, 240, 240), 1, cv::LINE_AA);
+    cv::putText(tile, name, cv::Point(15, 140), cv::FONT_HERSHEY_SIMPLEX, 0.45,
+                cv::Scalar(230, 140, 90), 1, cv::LINE_AA);
+    return tile;
+}
+
+// Re-encodes an image as a low quality JPEG to add compression noise
+cv::Mat Compress(const cv::Mat& image) {
+    std::vector<unsigned char> bytes;
+    cv::imencode(".jpg", image, bytes, {cv::IMWRITE_JPEG_QUALITY, 60});
+    return cv::imdecode(bytes, cv::IMREAD_COLOR);
+}
+
+TEST_CASE("VisualIndex finds a compressed copy of an indexed tile") {
+    VisualIndex index;
+    cv::Mat tile = MakeIndexedTile(cv::Scalar(255, 71, 41), "Wildcat Ears");
+    index.Add(VisualIndex::ComputeSignature(tile), {"Wildcat Ears", "Cobalt", ""});
+
+    ClassificationResult result;
+    REQUIRE(index.Lookup(VisualIndex::ComputeSignature(Compress(tile)), result));
+    REQUIRE(result.name == "Wildcat Ears");
+    REQUIRE(result.paint == "Cobalt");
+}
+
+TEST_CASE("VisualIndex does not match the same item in another paint") {
+    VisualIndex index;
+    cv::Mat cobalt = MakeIndexedTile(cv::Scalar(255, 71, 41), "Wildcat Ears");
+    cv::Mat crimson = MakeIndexedTile(cv::Scalar(28, 23, 168), "Wildcat Ears");
+    index.Add(VisualIndex::ComputeSignature(cobalt), {"Wildcat Ears", "Cobalt", ""});
+
+    ClassificationResult result;
+    REQUIRE_FALSE(index.Lookup(VisualIndex::ComputeSignature(crimson), result));
+}
+
+TEST_CASE("VisualIndex does not match the same item with another certification") {
+    VisualIndex index;
+    cv::Mat paragon = MakeIndexedTile(cv::Scalar(20, 140, 240), "Toon Sketch", "Paragon");
+    cv::Mat playmaker = MakeIndexedTile(cv::Scalar(20, 140, 240), "Toon Sketch", "Playmaker");
+    index.Add(VisualIndex::ComputeSignature(paragon), {"Toon Sketch", "Default", "Paragon"});
+
+    // Only the small certification differs, which the hashes and colors alone cannot see
+    ClassificationResult result;
+    REQUIRE_FALSE(index.Lookup(VisualIndex::ComputeSignature(playmaker), result));
+    REQUIRE(index.Lookup(VisualIndex::ComputeSignature(Compress(paragon)), result));
+    REQUIRE(result.certification == "Paragon");
+}
+
+TEST_CASE("VisualIndex does not add a tile twice") {
+    VisualIndex index;
+    cv::Mat tile = MakeIndexedTile(cv::Scalar(255, 71, 41), "Wildcat Ears");
+    index.Add(VisualIndex::ComputeSignature(tile), {"Wildcat Ears", "Cobalt", ""});
+    index.Add(VisualIndex::ComputeSignature(Compress(tile)), {"Wildcat Ears", "Cobalt", ""});
+    REQUIRE(index.GetSize() == 1);
+}
+
+TEST_CASE("VisualIndex ignores the empty signature of an unusable tile") {
+    VisualIndex index;
+    TileSignature empty = VisualIndex::ComputeSignature(cv::Mat());
+    index.Add(empty, {"Wildcat Ears", "Cobalt", ""});
+    REQUIRE(index.GetSize() == 0);
+
+    index.Add(VisualIndex::ComputeSignature(MakeIndexedTile(cv::Scalar(200, 90, 40), "Wildcat Ears")),
+              {"Wildcat Ears", "Cobalt", ""});
+    ClassificationResult result;
+    REQUIRE_FALSE(index.Lookup(empty, result));
+    REQUIRE_FALSE(index.Lookup(VisualIndex::ComputeSignature(cv::Mat(155, 137, CV_8UC1)), result));
+}
+
+TEST_CASE("VisualIndex is restored from a file") {
+    VisualIndex index;
+    cv::Mat tile = MakeIndexedTile(cv::Scalar(20, 140, 240), "Toon Sketch");
+    index.Add(VisualIndex::ComputeSignature(tile), {"Toon Sketch", "Default", "Show-Off"});
+    REQUIRE(index.WriteToFile(path_to_visual_index));
+
+    VisualIndex restored;
+    REQUIRE(restored.ReadFromFile(path_to_visual_index));
+    ClassificationResult result;
+    REQUIRE(restored.Lookup(VisualIndex::ComputeSignature(tile), result));
+    REQUIRE(result.certification == "Show-Off");
+    std::remove(path_to_visual_index.c_str());
+}
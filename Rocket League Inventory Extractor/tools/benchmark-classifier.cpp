@@ -0,0 +1,229 @@
+/* Rocket League Inventory Extractor - Classifier Benchmark
+  Runs the full classification pipeline over a labeled image corpus and reports
+  throughput, per-stage latency and name/paint/certification accuracy.
+
+  Usage:
+    benchmark-classifier <model> <database> <corpus folder> [--manifest <path>] [--repeat <n>] [--cache <capacity>]
+                         [--record <path>] [--color-ocr]
+
+  The manifest defaults to manifest.csv inside the corpus folder (see CorpusManifest.h).
+  --cache answers repeated images from a ClassificationCache, so with --repeat it measures cache hits.
+  --record saves the words every step read from each image (see TokenRecording.h) for replay-tokens;
+  every step is run and recorded, so the figures are those of the slowest path. It cannot be combined
+  with --cache, as an image answered by the cache has no words to record.
+  --color-ocr gives Tesseract color crops instead of crops of one gray image, so the two can be compared
+  on the same corpus.
+  Author: Ridas Jagelavicius */
+
+#include <algorithm>
+#include <cctype>
+#include <chrono>
+#include <exception>
+#include <filesystem>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "../src/ClassificationCache.h"
+#include "../src/CorpusManifest.h"
+#include "../src/ItemClassifier.h"
+#include "../src/LatencyProfiler.h"
+#include "../src/TokenRecording.h"
+
+// Prints how to run the benchmark
+void PrintUsage() {
+    std::cout << "Usage: benchmark-classifier <model> <database> <corpus folder> "
+                 "[--manifest <path>] [--repeat <n>] [--cache <capacity>] [--record <path>] "
+                 "[--color-ocr]"
+              << std::endl;
+}
+
+// Returns a percentage of a count, or 0 if there is nothing to count
+double Percent(int count, int total) {
+    return total == 0 ? 0 : 100.0 * count / total;
+}
+
+// Reads a count such as a number of rounds, which must be whole digits and at least 1
+bool ParseCount(const std::string& text, size_t& count) {
+    if (text.empty()) return false;
+    for (char digit : text)
+        if (!std::isdigit(static_cast<unsigned char>(digit))) return false;
+
+    size_t parsed;
+    try {
+        parsed = std::stoull(text);
+    } catch (const std::exception&) {
+        return false;  // Too large to be a count
+    }
+    if (parsed == 0) return false;
+    count = parsed;
+    return true;
+}
+
+int main(int argc, char** argv) {
+    if (argc < 4) {
+        PrintUsage();
+        return 1;
+    }
+
+    std::string path_to_model = argv[1];
+    std::string path_to_database = argv[2];
+    std::filesystem::path corpus = argv[3];
+    std::filesystem::path manifest = corpus / "manifest.csv";
+    size_t repeat = 1;
+    size_t cache_capacity = 0;
+    std::string path_to_recording;
+    bool color_ocr = false;
+
+    for (int i = 4; i < argc; i++) {
+        std::string option = argv[i];
+        if (option == "--manifest" && i + 1 < argc) {
+            manifest = argv[++i];
+        } else if (option == "--repeat" && i + 1 < argc) {
+            if (!ParseCount(argv[++i], repeat)) {
+                PrintUsage();
+                return 1;
+            }
+        } else if (option == "--cache" && i + 1 < argc) {
+            if (!ParseCount(argv[++i], cache_capacity)) {
+                PrintUsage();
+                return 1;
+            }
+        } else if (option == "--record" && i + 1 < argc) {
+            path_to_recording = argv[++i];
+        } else if (option == "--color-ocr") {
+            color_ocr = true;
+        } else {
+            PrintUsage();
+            return 1;
+        }
+    }
+
+    // A cached result has no steps, so recording it would save an empty record
+    if (!path_to_recording.empty() && cache_capacity > 0) {
+        std::cout << "--record cannot be combined with --cache" << std::endl;
+        return 1;
+    }
+
+    std::vector<LabeledImage> labeled_images = ReadManifest(manifest.string());
+    if (labeled_images.empty()) {
+        std::cout << "No labeled images found in " << manifest.string() << std::endl;
+        return 1;
+    }
+
+    // Decode every image up front so disk reads are not part of the measurement
+    std::vector<cv::Mat> images;
+    for (const LabeledImage& labeled : labeled_images) {
+        cv::Mat image = cv::imread((corpus / labeled.image).string());
+        if (image.empty())
+            std::cout << "Could not read " << labeled.image << std::endl;
+        images.push_back(image);
+    }
+    std::vector<cv::Mat>::const_iterator first_image = std::find_if(
+        images.begin(), images.end(), [](const cv::Mat& image) { return !image.empty(); });
+    if (first_image == images.end()) {
+        std::cout << "None of the labeled images could be read" << std::endl;
+        return 1;
+    }
+
+    ItemClassifier classifier(path_to_model, path_to_database);
+    classifier.SetGrayscaleOcr(!color_ocr);
+    ClassificationCache cache(std::max<size_t>(cache_capacity, 1));
+
+    // Warm up so loading the network is not counted as classification time
+    classifier.Classify(*first_image);
+    LatencyProfiler::Global().Reset();
+
+    // Caching starts after the warm up, so the first round still runs the full pipeline
+    if (cache_capacity > 0) classifier.SetCache(&cache);
+
+    // Recording runs every step, so later replays can try any minimum confidence
+    std::unique_ptr<TokenRecordWriter> recording;
+    if (!path_to_recording.empty()) {
+        recording.reset(new TokenRecordWriter(path_to_recording));
+        if (!recording->IsOpen()) {
+            std::cout << "Could not create " << path_to_recording << std::endl;
+            return 1;
+        }
+        classifier.SetMinimumConfidence(1);
+    }
+
+    int classified = 0;
+    int names_correct = 0;
+    int paints_correct = 0;
+    int certifications_correct = 0;
+    std::vector<double> latencies;
+
+    std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+    for (size_t round = 0; round < repeat; round++) {
+        for (size_t i = 0; i < labeled_images.size(); i++) {
+            if (images[i].empty()) continue;
+
+            std::chrono::steady_clock::time_point image_start =
+                std::chrono::steady_clock::now();
+            ClassificationResult result;
+            if (recording && round == 0) {
+                TokenRecord record;
+                result = classifier.Classify(images[i], record);
+                record.image_id = labeled_images[i].image;
+                recording->Write(record);
+            } else {
+                result = classifier.Classify(images[i]);
+            }
+            std::chrono::duration<double, std::milli> elapsed =
+                std::chrono::steady_clock::now() - image_start;
+            latencies.push_back(elapsed.count());
+
+            const LabeledImage& expected = labeled_images[i];
+            classified++;
+            names_correct += result.name == expected.name;
+            paints_correct += result.paint == expected.paint;
+            certifications_correct += result.certification == expected.certification;
+
+            // Only report mismatches once, not on every repetition
+            if (round == 0 &&
+                (result.name != expected.name || result.paint != expected.paint ||
+                 result.certification != expected.certification)) {
+                std::cout << "MISMATCH " << expected.image << ": expected ["
+                          << expected.paint << "] [" << expected.certification
+                          << "] " << expected.name << ", got [" << result.paint
+                          << "] [" << result.certification << "] " << result.name
+                          << std::endl;
+            }
+        }
+    }
+    std::chrono::duration<double> total = std::chrono::steady_clock::now() - start;
+
+    std::sort(latencies.begin(), latencies.end());
+    auto percentile = [&latencies](double p) {
+        if (latencies.empty()) return 0.0;
+        size_t index = static_cast<size_t>(p / 100.0 * (latencies.size() - 1));
+        return latencies[index];
+    };
+
+    std::cout << std::fixed << std::setprecision(2) << std::endl
+              << "Images classified:  " << classified << std::endl
+              << "Total time (s):     " << total.count() << std::endl
+              << "Images per second:  " << classified / total.count() << std::endl
+              << "Per image p50 (ms): " << percentile(50) << std::endl
+              << "Per image p95 (ms): " << percentile(95) << std::endl
+              << "Per image p99 (ms): " << percentile(99) << std::endl
+              << std::endl
+              << "Name accuracy:          " << Percent(names_correct, classified) << "%" << std::endl
+              << "Paint accuracy:         " << Percent(paints_correct, classified) << "%" << std::endl
+              << "Certification accuracy: " << Percent(certifications_correct, classified) << "%" << std::endl
+              << std::endl;
+    if (cache_capacity > 0) {
+        std::cout << "Cache hits:   " << cache.GetHitCount() << std::endl
+                  << "Cache misses: " << cache.GetMissCount() << std::endl
+                  << std::endl;
+    }
+    std::cout << LatencyProfiler::Global().Report();
+    if (recording)
+        std::cout << std::endl << "Recorded " << recording->GetCount() << " images to "
+                  << path_to_recording << std::endl;
+
+    return 0;
+}
@@ -0,0 +1,172 @@
+/* Rocket League Inventory Extractor - Text Detector Benchmark
+  Compares text detection models (EAST, DB and their quantized INT8 versions) and cv::dnn
+  backends on the CPU: how long each takes to detect the text boxes of a tile, and how often the
+  boxes it finds are read as the right item name.
+
+  Usage:
+    benchmark-detectors <database> <corpus folder> <model>... [--manifest <path>] [--repeat <n>]
+                        [--backends opencv,openvino]
+
+  Each model is run on each backend; a backend missing from this build of OpenCV is skipped.
+  The architecture of each model is recognized from its file name (see GuessDetectorModel()).
+  Only DetectText() is timed. Accuracy reads the detected boxes with Tesseract and matches their
+  words without the text band step, so it measures the boxes alone.
+  The manifest defaults to manifest.csv inside the corpus folder (see CorpusManifest.h).
+  Author: Ridas Jagelavicius */
+
+#include <algorithm>
+#include <chrono>
+#include <filesystem>
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "../src/CorpusManifest.h"
+#include "../src/ItemClassifier.h"
+#include "../src/LatencyProfiler.h"
+#include "../src/TextDetector.h"
+
+// Prints how to run the benchmark
+void PrintUsage() {
+    std::cout << "Usage: benchmark-detectors <database> <corpus folder> <model>... "
+                 "[--manifest <path>] [--repeat <n>] [--backends opencv,openvino]"
+              << std::endl;
+}
+
+// Returns a percentile of sorted latencies
+double Percentile(const std::vector<double>& sorted, double percentile) {
+    if (sorted.empty()) return 0;
+    size_t index = static_cast<size_t>(percentile / 100 * (sorted.size() - 1) + 0.5);
+    return sorted[std::min(index, sorted.size() - 1)];
+}
+
+int main(int argc, char** argv) {
+    if (argc < 4) {
+        PrintUsage();
+        return 1;
+    }
+
+    std::string path_to_database = argv[1];
+    std::filesystem::path corpus = argv[2];
+    std::filesystem::path manifest = corpus / "manifest.csv";
+    std::vector<std::string> models;
+    std::vector<DetectorBackend> backends = {DetectorBackend::OpenCv};
+    int repeat = 1;
+
+    for (int i = 3; i < argc; i++) {
+        std::string option = argv[i];
+        if (option == "--manifest" && i + 1 < argc) {
+            manifest = argv[++i];
+        } else if (option == "--repeat" && i + 1 < argc) {
+            repeat = std::max(1, std::stoi(argv[++i]));
+        } else if (option == "--backends" && i + 1 < argc) {
+            backends.clear();
+            std::stringstream split(argv[++i]);
+            std::string name;
+            while (std::getline(split, name, ',')) {
+                DetectorBackend backend;
+                if (!ParseDetectorBackend(name, backend)) {
+                    PrintUsage();
+                    return 1;
+                }
+                backends.push_back(backend);
+            }
+        } else if (option.compare(0, 2, "--") == 0) {
+            PrintUsage();
+            return 1;
+        } else {
+            models.push_back(option);
+        }
+    }
+
+    if (models.empty()) {
+        PrintUsage();
+        return 1;
+    }
+
+    std::vector<LabeledImage> labeled_images = ReadManifest(manifest.string());
+    if (labeled_images.empty()) {
+        std::cout << "No labeled images found in " << manifest.string() << std::endl;
+        return 1;
+    }
+
+    // Decode every image up front so disk reads are not part of the measurement
+    std::vector<cv::Mat> images;
+    std::vector<LabeledImage> labels;
+    for (const LabeledImage& labeled : labeled_images) {
+        cv::Mat image = cv::imread((corpus / labeled.image).string());
+        if (image.empty()) {
+            std::cout << "Could not read " << labeled.image << std::endl;
+            continue;
+        }
+        images.push_back(image);
+        labels.push_back(labeled);
+    }
+    if (images.empty()) return 1;
+
+    std::cout << std::left << std::setw(36) << "Model" << std::setw(6) << "Arch" << std::setw(10)
+              << "Backend" << std::setw(10) << "p50 ms" << std::setw(10) << "p95 ms"
+              << std::setw(12) << "Forward ms" << std::setw(10) << "Words" << "Names" << std::endl;
+
+    for (const std::string& path_to_model : models) {
+        for (DetectorBackend backend : backends) {
+            if (!IsBackendAvailable(backend)) {
+                std::cout << GetDetectorBackendName(backend)
+                          << " is not available in this build of OpenCV, skipping" << std::endl;
+                continue;
+            }
+
+            DetectorOptions options;
+            options.model = GuessDetectorModel(path_to_model);
+            options.backend = backend;
+            ItemClassifier classifier(path_to_model, path_to_database);
+            classifier.SetDetectorOptions(options);
+
+            // Warm up so loading the network is not counted as detection time
+            classifier.DetectText(images.front());
+            LatencyProfiler::Global().Reset();
+
+            std::vector<double> latencies;
+            int names_correct = 0;
+            size_t words = 0;
+            for (int round = 0; round < repeat; round++) {
+                for (size_t i = 0; i < images.size(); i++) {
+                    std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+                    classifier.DetectText(images[i]);
+                    latencies.push_back(std::chrono::duration<double, std::milli>(
+                                            std::chrono::steady_clock::now() - start)
+                                            .count());
+
+                    // Reading the boxes is slow and the same every round, so it is done once
+                    if (round > 0) continue;
+                    std::vector<std::string> extracted = classifier.ExtractText();
+                    words += extracted.size();
+                    classifier.DetectColor(extracted);
+                    classifier.ExtractCertification(extracted);
+                    std::string name = classifier.MatchTextToItemName(extracted);
+                    if (name.empty()) {
+                        float similarity;
+                        name = classifier.MatchClosestItemName(extracted, similarity);
+                    }
+                    names_correct += name == labels[i].name;
+                }
+            }
+            classifier.ReleaseLastImage();
+            std::sort(latencies.begin(), latencies.end());
+
+            std::string model_name = std::filesystem::path(path_to_model).filename().string();
+            std::cout << std::left << std::setw(36) << model_name << std::setw(6)
+                      << GetDetectorModelName(options.model) << std::setw(10)
+                      << GetDetectorBackendName(backend) << std::fixed << std::setprecision(2)
+                      << std::setw(10) << Percentile(latencies, 50) << std::setw(10)
+                      << Percentile(latencies, 95) << std::setw(12)
+                      << LatencyProfiler::Global().GetPercentile(PipelineStage::Forward, 50) / 1000
+                      << std::setw(10) << static_cast<double>(words) / images.size()
+                      << std::setprecision(1) << 100.0 * names_correct / images.size() << "%"
+                      << std::endl;
+        }
+    }
+    return 0;
+}
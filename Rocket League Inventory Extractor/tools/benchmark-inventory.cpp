@@ -0,0 +1,135 @@
+/* Rocket League Inventory Extractor - Inventory Benchmark
+  Builds synthetic inventories sampled from the price database and times every
+  Inventory operation as the inventory grows.
+
+  Usage:
+    benchmark-inventory <database> [--sizes 1000,10000,100000] [--seed <n>] [--budget <seconds>]
+
+  Each operation stops early once it has run for the time budget (default 30s),
+  and the time per operation is reported from the operations that did run.
+  Author: Ridas Jagelavicius */
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <functional>
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "../src/Inventory.h"
+#include "../src/InventoryGenerator.h"
+#include "../src/ItemDatabase.h"
+
+constexpr char PATH_TO_SAVED_INVENTORY[] = "benchmark-inventory.txt";  // Scratch file for save/load timings
+constexpr size_t SAMPLED_OPERATIONS = 1000;  // How many items are updated and removed at each size
+
+// Prints how to run the benchmark
+void PrintUsage() {
+    std::cout << "Usage: benchmark-inventory <database> [--sizes 1000,10000,100000] "
+                 "[--seed <n>] [--budget <seconds>]"
+              << std::endl;
+}
+
+/** Runs an operation up to count times or until the budget is spent, then prints its cost
+    @param label - The name of the operation
+    @param count - How many times to run the operation
+    @param budget - The most time to spend on the operation in seconds
+    @param operation - Runs the operation on the i-th input
+*/
+void TimeOperation(const std::string& label, size_t count, double budget,
+                   const std::function<void(size_t)>& operation) {
+    std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+    std::chrono::duration<double> elapsed(0);
+
+    size_t completed = 0;
+    while (completed < count) {
+        operation(completed++);
+        elapsed = std::chrono::steady_clock::now() - start;
+        if (elapsed.count() > budget) break;
+    }
+
+    std::cout << "  " << std::left << std::setw(20) << label << std::right
+              << std::setw(10) << completed << " ops" << std::setw(14)
+              << std::fixed << std::setprecision(1)
+              << elapsed.count() * 1e9 / completed << " ns/op";
+    if (completed < count) std::cout << "  (stopped early, budget spent)";
+    std::cout << std::endl;
+}
+
+int main(int argc, char** argv) {
+    if (argc < 2) {
+        PrintUsage();
+        return 1;
+    }
+
+    std::string path_to_database = argv[1];
+    std::vector<size_t> sizes = {1000, 10000, 100000};
+    unsigned seed = 2020;
+    double budget = 30;
+
+    for (int i = 2; i < argc; i++) {
+        std::string option = argv[i];
+        if (option == "--sizes" && i + 1 < argc) {
+            sizes.clear();
+            std::stringstream list(argv[++i]);
+            std::string size;
+            while (std::getline(list, size, ',')) sizes.push_back(std::stoull(size));
+        } else if (option == "--seed" && i + 1 < argc) {
+            seed = static_cast<unsigned>(std::stoul(argv[++i]));
+        } else if (option == "--budget" && i + 1 < argc) {
+            budget = std::stod(argv[++i]);
+        } else {
+            PrintUsage();
+            return 1;
+        }
+    }
+
+    ItemDatabase database(path_to_database);
+    if (!database.IsValidDatabase()) {
+        std::cout << "Database not found at provided path" << std::endl;
+        return 1;
+    }
+
+    InventoryGenerator generator(database, seed);
+    std::cout << "Catalog contains " << generator.GetCatalogSize()
+              << " priced item variants" << std::endl;
+
+    for (size_t size : sizes) {
+        std::vector<InventoryItem> items = generator.GenerateItems(size);
+        Inventory inventory(path_to_database);
+        size_t sampled = std::min(SAMPLED_OPERATIONS, size);
+
+        std::cout << std::endl << "Inventory of " << size << " generated items" << std::endl;
+
+        TimeOperation("AddItem", items.size(), budget,
+                      [&](size_t i) { inventory.AddItem(items[i]); });
+        std::cout << "  (" << inventory.GetItems().size() << " unique items)" << std::endl;
+
+        TimeOperation("GetInventoryWorth", 10, budget,
+                      [&](size_t) { inventory.GetInventoryWorth(); });
+        TimeOperation("UpdateItemPrice", sampled, budget, [&](size_t i) {
+            inventory.UpdateItemPrice(items[i], items[i].GetPriceRange());
+        });
+        TimeOperation("PrettyPrint", 10, budget,
+                      [&](size_t) { inventory.PrettyPrint(); });
+        TimeOperation("PrintBuyingList", 10, budget,
+                      [&](size_t) { inventory.PrintBuyingList(); });
+        TimeOperation("PrintSellingList", 10, budget,
+                      [&](size_t) { inventory.PrintSellingList(); });
+        TimeOperation("WriteInvToFile", 1, budget, [&](size_t) {
+            inventory.WriteInvToFile(PATH_TO_SAVED_INVENTORY);
+        });
+        TimeOperation("ReadInvFromFile", 1, budget, [&](size_t) {
+            Inventory loaded(path_to_database);
+            loaded.ReadInvFromFile(PATH_TO_SAVED_INVENTORY);
+        });
+        TimeOperation("RemoveItem", sampled, budget,
+                      [&](size_t i) { inventory.RemoveItem(items[i]); });
+    }
+
+    std::remove(PATH_TO_SAVED_INVENTORY);
+    return 0;
+}
@@ -0,0 +1,203 @@
+/* Rocket League Inventory Extractor - Box Decoding and Suppression Benchmark
+  Measures how long it takes to turn EAST's output into text boxes on dense tiles (a screenshot
+  full of text) and sparse tiles (a single item), comparing the fused stage of EastTextDetector
+  (the most confident cells of each region, then SuppressOverlappingBoxes()) with decoding every
+  cell and passing them all to cv::dnn::NMSBoxes(), as ItemClassifier used to.
+
+  Usage:
+    benchmark-nms [--tiles <n>] [--seed <n>]
+
+  EAST's output is synthesized from random lines of words, so no model or image is needed. For
+  each kind of tile the candidates, kept boxes, microseconds per tile and the share of the boxes
+  NMSBoxes() keeps that the fused stage also finds are reported.
+  Author: Ridas Jagelavicius */
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "../src/TextDetector.h"
+
+constexpr float SCORE_THRESHOLD = .50;  // The score a cell needs to be decoded, as in TextDetector.cpp
+constexpr float OVERLAP_THRESHOLD = .4;  // The overlap above which a box is suppressed, as in TextDetector.cpp
+constexpr float MATCH_OVERLAP = .5;  // Boxes overlapping at least this much are the same box
+
+// Exposes the decoding of EastTextDetector so it can be run on synthesized output
+class DecodingEastTextDetector : public EastTextDetector {
+   public:
+    using EastTextDetector::EastTextDetector;
+    using EastTextDetector::DecodeBoxes;
+};
+
+// A kind of tile to synthesize
+struct TileKind {
+    std::string name; // The name printed in the report
+    int width, height; // The network input size
+    int lines, words; // The lines of text and the most words on each
+};
+
+// Prints how to run the benchmark
+void PrintUsage() {
+    std::cout << "Usage: benchmark-nms [--tiles <n>] [--seed <n>]" << std::endl;
+}
+
+// Synthesizes EAST's score and geometry maps for random lines of words
+void SynthesizeOutput(const TileKind& kind, std::mt19937& random, cv::Mat& scores,
+                      cv::Mat& geometry) {
+    const int height = kind.height / 4, width = kind.width / 4;
+    int score_shape[] = {1, 1, height, width};
+    int geometry_shape[] = {1, 5, height, width};
+    scores = cv::Mat(4, score_shape, CV_32F, cv::Scalar(0));
+    geometry = cv::Mat(4, geometry_shape, CV_32F, cv::Scalar(0));
+
+    std::uniform_real_distribution<float> confidence(.55f, .99f);
+    std::normal_distribution<float> jitter(0, 1.5f), tilt(0, .02f);
+    const float line_height = static_cast<float>(kind.height) / (kind.lines + 1);
+    for (int line = 0; line < kind.lines; line++) {
+        float x = 8;
+        float top = line_height * (line + .5f);
+        float box_height = std::min(line_height * .6f, 24.0f);
+        std::uniform_real_distribution<float> word_width(30, static_cast<float>(kind.width) / kind.words - 10);
+        for (int word = 0; word < kind.words; word++) {
+            float box_width = word_width(random);
+            if (x + box_width > kind.width - 4) break;
+
+            // Every cell inside the word predicts the distances to the word's edges
+            for (int cy = static_cast<int>(top / 4); cy <= (top + box_height) / 4 && cy < height; cy++) {
+                for (int cx = static_cast<int>(x / 4); cx <= (x + box_width) / 4 && cx < width; cx++) {
+                    float px = cx * 4.0f, py = cy * 4.0f;
+                    if (px < x || px > x + box_width || py < top || py > top + box_height) continue;
+                    scores.ptr<float>(0, 0, cy)[cx] = confidence(random);
+                    geometry.ptr<float>(0, 0, cy)[cx] = py - top + jitter(random);
+                    geometry.ptr<float>(0, 1, cy)[cx] = x + box_width - px + jitter(random);
+                    geometry.ptr<float>(0, 2, cy)[cx] = top + box_height - py + jitter(random);
+                    geometry.ptr<float>(0, 3, cy)[cx] = px - x + jitter(random);
+                    geometry.ptr<float>(0, 4, cy)[cx] = tilt(random);
+                }
+            }
+            x += box_width + 10;
+        }
+    }
+}
+
+// Decodes every cell above the threshold, as ItemClassifier did before the fused stage
+void DecodeEveryCell(const cv::Mat& scores, const cv::Mat& geometry,
+                     std::vector<cv::RotatedRect>& boxes, std::vector<float>& confidences) {
+    boxes.clear();
+    confidences.clear();
+    for (int y = 0; y < scores.size[2]; ++y) {
+        const float* scores_data = scores.ptr<float>(0, 0, y);
+        const float* x0_data = geometry.ptr<float>(0, 0, y);
+        const float* x1_data = geometry.ptr<float>(0, 1, y);
+        const float* x2_data = geometry.ptr<float>(0, 2, y);
+        const float* x3_data = geometry.ptr<float>(0, 3, y);
+        const float* angles_data = geometry.ptr<float>(0, 4, y);
+        for (int x = 0; x < scores.size[3]; ++x) {
+            if (scores_data[x] < SCORE_THRESHOLD) continue;
+            float angle = angles_data[x];
+            float cosA = std::cos(angle), sinA = std::sin(angle);
+            float h = x0_data[x] + x2_data[x];
+            float w = x1_data[x] + x3_data[x];
+            cv::Point2f offset(x * 4.0f + cosA * x1_data[x] + sinA * x2_data[x],
+                               y * 4.0f - sinA * x1_data[x] + cosA * x2_data[x]);
+            cv::Point2f p1 = cv::Point2f(-sinA * h, -cosA * h) + offset;
+            cv::Point2f p3 = cv::Point2f(-cosA * w, sinA * w) + offset;
+            boxes.push_back(cv::RotatedRect(0.5f * (p1 + p3), cv::Size2f(w, h),
+                                            -angle * 180.0f / (float)CV_PI));
+            confidences.push_back(scores_data[x]);
+        }
+    }
+}
+
+// Returns the intersection over union of two rotated boxes
+float Overlap(const cv::RotatedRect& a, const cv::RotatedRect& b) {
+    std::vector<cv::Point2f> intersection;
+    if (cv::rotatedRectangleIntersection(a, b, intersection) == cv::INTERSECT_NONE ||
+        intersection.empty())
+        return 0;
+    float shared = static_cast<float>(cv::contourArea(intersection));
+    return shared / (a.size.area() + b.size.area() - shared);
+}
+
+int main(int argc, char** argv) {
+    int tiles = 20;
+    unsigned seed = 7;
+    for (int i = 1; i < argc; i++) {
+        std::string option = argv[i];
+        if (option == "--tiles" && i + 1 < argc) {
+            tiles = std::max(1, std::stoi(argv[++i]));
+        } else if (option == "--seed" && i + 1 < argc) {
+            seed = static_cast<unsigned>(std::stoul(argv[++i]));
+        } else {
+            PrintUsage();
+            return 1;
+        }
+    }
+
+    std::vector<TileKind> kinds = {{"dense", 1280, 736, 24, 8}, {"sparse", 160, 128, 2, 2}};
+    DecodingEastTextDetector detector("", DetectorBackend::OpenCv);
+
+    std::cout << std::left << std::setw(8) << "Tiles" << std::setw(10) << "Stage" << std::setw(12)
+              << "Candidates" << std::setw(8) << "Kept" << std::setw(12) << "us/tile" << "Found"
+              << std::endl;
+    for (const TileKind& kind : kinds) {
+        std::mt19937 random(seed);
+        double reference_seconds = 0, fused_seconds = 0;
+        size_t reference_candidates = 0, fused_candidates = 0;
+        size_t reference_kept = 0, fused_kept = 0, found = 0;
+
+        for (int tile = 0; tile < tiles; tile++) {
+            cv::Mat scores, geometry;
+            SynthesizeOutput(kind, random, scores, geometry);
+
+            // Every cell decoded, then pairwise rotated overlap over all of them
+            std::vector<cv::RotatedRect> boxes;
+            std::vector<float> confidences;
+            std::vector<int> indices;
+            std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+            DecodeEveryCell(scores, geometry, boxes, confidences);
+            cv::dnn::NMSBoxes(boxes, confidences, SCORE_THRESHOLD, OVERLAP_THRESHOLD, indices);
+            reference_seconds +=
+                std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+            reference_candidates += boxes.size();
+            reference_kept += indices.size();
+
+            // The most confident cells of each region, then suppression with bounds rejection
+            TextDetections detections;
+            start = std::chrono::steady_clock::now();
+            detector.DecodeBoxes({scores, geometry}, 0, detections);
+            std::vector<int> kept = SuppressOverlappingBoxes(detections.boxes,
+                                                             detections.confidences,
+                                                             OVERLAP_THRESHOLD);
+            fused_seconds +=
+                std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+            fused_candidates += detections.boxes.size();
+            fused_kept += kept.size();
+
+            for (int reference : indices) {
+                for (int index : kept) {
+                    if (Overlap(boxes[reference], detections.boxes[index]) >= MATCH_OVERLAP) {
+                        found++;
+                        break;
+                    }
+                }
+            }
+        }
+
+        std::cout << std::fixed << std::setprecision(1);
+        std::cout << std::left << std::setw(8) << kind.name << std::setw(10) << "NMSBoxes"
+                  << std::setw(12) << reference_candidates / tiles << std::setw(8)
+                  << reference_kept / tiles << 1e6 * reference_seconds / tiles << std::endl;
+        std::cout << std::left << std::setw(8) << kind.name << std::setw(10) << "fused"
+                  << std::setw(12) << fused_candidates / tiles << std::setw(8)
+                  << fused_kept / tiles << std::setw(12) << 1e6 * fused_seconds / tiles
+                  << (reference_kept == 0 ? 100.0 : 100.0 * found / reference_kept) << "%"
+                  << std::endl;
+    }
+    return 0;
+}
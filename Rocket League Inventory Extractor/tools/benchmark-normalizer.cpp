@@ -0,0 +1,202 @@
+/* Rocket League Inventory Extractor - Text Normalization Benchmark
+  Measures NormalizeText() throughput in Word and Key modes on millions of tokens and
+  compares it with the erase-in-a-loop sanitizers it replaced, checking that both
+  produce the same text.
+
+  Usage:
+    benchmark-normalizer [--tokens <n>] [--database <path>] [--seed <n>]
+
+  Tokens are item names from the database (when given) or built-in words, with OCR
+  noise (brackets, colons, newlines, hyphens, capitals) added at random.
+  Author: Ridas Jagelavicius */
+
+#include <algorithm>
+#include <chrono>
+#include <functional>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "../src/ItemDatabase.h"
+#include "../src/TextNormalizer.h"
+
+// Words used when no database is given
+const std::vector<std::string> WORDS = {
+    "Octane - MG-88", "Wildcat Ears", "COBALT", "Burnt Sienna", "SHOW-OFF",
+    "Animus GP", "Dominus - Suji", "Toon Sketch", "Centio V17", "Paragon",
+    "Salty (Banner)", "Spiralis", "Circuit Board", "Capable", "Labyrinth"};
+
+// Characters OCR commonly adds around words
+const std::string NOISE = "[]{}!/\\.:;_\n-";
+
+// The ItemClassifier sanitizer before NormalizeText(), kept to compare against
+std::string LegacyWordSanitize(std::string word_or_item) {
+    std::vector<char> toRemove = {'\n', '[', ']', '{', '}', '!', '/',
+                                  '\\', '.', ':', ';', '_'};
+    bool wasHyphen = false;
+    bool wasErased;
+    std::string::iterator it = word_or_item.begin();
+    while (it != word_or_item.end()) {
+        wasErased = false;
+        if (wasHyphen) {
+            if (*it == ' ') it = word_or_item.erase(it);
+            wasHyphen = false;
+            continue;
+        }
+        if (*it == '-') {
+            wasHyphen = true;
+            it = word_or_item.erase(it);
+            continue;
+        }
+        for (std::vector<char>::iterator it2 = toRemove.begin();
+             it2 != toRemove.end(); ++it2) {
+            if (*it == *it2) {
+                it = word_or_item.erase(it);
+                wasErased = true;
+                break;
+            }
+        }
+        if (it != word_or_item.end() && !wasErased) ++it;
+    }
+    std::transform(word_or_item.begin(), word_or_item.end(),
+                   word_or_item.begin(), ::tolower);
+    return word_or_item;
+}
+
+// The ItemDatabase sanitizer before NormalizeText(), kept to compare against
+std::string LegacyKeySanitize(std::string word_or_item) {
+    std::vector<char> toRemove = {'\n', '-', ' ', '[', ']', '{', '}', '!',
+                                  '/',  '\\', '.', ':', ';', '_'};
+    bool wasErased;
+    std::string::iterator it = word_or_item.begin();
+    while (it != word_or_item.end()) {
+        wasErased = false;
+        for (std::vector<char>::iterator it2 = toRemove.begin();
+             it2 != toRemove.end(); ++it2) {
+            if (*it == *it2) {
+                it = word_or_item.erase(it);
+                wasErased = true;
+                break;
+            }
+        }
+        if (it != word_or_item.end() && !wasErased) ++it;
+    }
+    std::transform(word_or_item.begin(), word_or_item.end(),
+                   word_or_item.begin(), ::tolower);
+    return word_or_item;
+}
+
+// Prints how to run the benchmark
+void PrintUsage() {
+    std::cout << "Usage: benchmark-normalizer [--tokens <n>] [--database <path>] [--seed <n>]"
+              << std::endl;
+}
+
+/** Times a normalizer over every token and prints its throughput
+    @param label - The name of the normalizer
+    @param tokens - The tokens to normalize
+    @param normalize - Normalizes the i-th token and returns the length of the result
+*/
+void TimeNormalizer(const std::string& label, const std::vector<std::string>& tokens,
+                    const std::function<size_t(size_t)>& normalize) {
+    size_t bytes = 0;
+    size_t checksum = 0;  // Keeps the work from being optimized away
+
+    std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+    for (size_t i = 0; i < tokens.size(); i++) {
+        checksum += normalize(i);
+        bytes += tokens[i].size();
+    }
+    std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+
+    std::cout << std::left << std::setw(28) << label << std::right << std::fixed
+              << std::setprecision(1) << std::setw(10)
+              << tokens.size() / elapsed.count() / 1e6 << " M tokens/s"
+              << std::setw(10) << bytes / elapsed.count() / 1e6 << " MB/s"
+              << std::setw(10) << elapsed.count() * 1e9 / tokens.size() << " ns/token"
+              << "  (" << checksum << ")" << std::endl;
+}
+
+int main(int argc, char** argv) {
+    size_t token_count = 5000000;
+    std::string path_to_database;
+    unsigned seed = 2020;
+
+    for (int i = 1; i < argc; i++) {
+        std::string option = argv[i];
+        if (option == "--tokens" && i + 1 < argc) {
+            token_count = std::stoull(argv[++i]);
+        } else if (option == "--database" && i + 1 < argc) {
+            path_to_database = argv[++i];
+        } else if (option == "--seed" && i + 1 < argc) {
+            seed = static_cast<unsigned>(std::stoul(argv[++i]));
+        } else {
+            PrintUsage();
+            return 1;
+        }
+    }
+
+    std::vector<std::string> words = WORDS;
+    if (!path_to_database.empty()) {
+        ItemDatabase database(path_to_database);
+        if (!database.IsValidDatabase()) {
+            std::cout << "Database not found at provided path" << std::endl;
+            return 1;
+        }
+        words = database.GetAllNames();
+    }
+
+    // Build the tokens up front so generating them is not measured
+    std::mt19937 random(seed);
+    std::uniform_int_distribution<size_t> pick_word(0, words.size() - 1);
+    std::uniform_int_distribution<size_t> pick_noise(0, NOISE.size() - 1);
+    std::bernoulli_distribution add_noise(0.3);
+    std::bernoulli_distribution capitalize(0.3);
+
+    std::vector<std::string> tokens;
+    tokens.reserve(token_count);
+    for (size_t i = 0; i < token_count; i++) {
+        std::string token = words[pick_word(random)];
+        if (capitalize(random))
+            std::transform(token.begin(), token.end(), token.begin(), ::toupper);
+        if (add_noise(random)) token.insert(token.begin(), NOISE[pick_noise(random)]);
+        if (add_noise(random)) token.push_back(NOISE[pick_noise(random)]);
+        tokens.push_back(token);
+    }
+
+    // Both implementations must agree before their speed means anything
+    size_t mismatches = 0;
+    for (size_t i = 0; i < std::min<size_t>(tokens.size(), 100000); i++) {
+        mismatches += NormalizeText(tokens[i], NormalizationMode::Word) != LegacyWordSanitize(tokens[i]);
+        mismatches += NormalizeText(tokens[i], NormalizationMode::Key) != LegacyKeySanitize(tokens[i]);
+    }
+    std::cout << "Normalized " << tokens.size() << " tokens, " << mismatches
+              << " mismatches against the legacy sanitizers" << std::endl
+              << std::endl;
+
+    std::string buffer;
+    TimeNormalizer("Legacy word sanitize", tokens, [&](size_t i) {
+        return LegacyWordSanitize(tokens[i]).size();
+    });
+    TimeNormalizer("NormalizeText Word", tokens, [&](size_t i) {
+        return NormalizeText(tokens[i], NormalizationMode::Word).size();
+    });
+    TimeNormalizer("NormalizeText Word (reused)", tokens, [&](size_t i) {
+        NormalizeText(tokens[i], NormalizationMode::Word, buffer);
+        return buffer.size();
+    });
+    TimeNormalizer("Legacy key sanitize", tokens, [&](size_t i) {
+        return LegacyKeySanitize(tokens[i]).size();
+    });
+    TimeNormalizer("NormalizeText Key", tokens, [&](size_t i) {
+        return NormalizeText(tokens[i], NormalizationMode::Key).size();
+    });
+    TimeNormalizer("NormalizeText Key (reused)", tokens, [&](size_t i) {
+        NormalizeText(tokens[i], NormalizationMode::Key, buffer);
+        return buffer.size();
+    });
+
+    return mismatches == 0 ? 0 : 1;
+}
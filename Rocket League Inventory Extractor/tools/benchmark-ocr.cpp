@@ -0,0 +1,174 @@
+/* Rocket League Inventory Extractor - Synthetic OCR Benchmark
+  Renders labeled item tiles for items sampled from the price database and measures
+  text detection and recognition (DetectText + ExtractText) throughput as the number
+  of images and their resolution grow. No real screenshots are needed.
+
+  Usage:
+    benchmark-ocr <model> <database> [--counts 10,100,1000] [--scales 1,2,4] [--seed <n>] [--write <folder>] [--unconstrained]
+
+  --write also saves every rendered tile with a manifest.csv (see CorpusManifest.h) into
+  <folder>/<scale>x so the tiles can be reused as a corpus by benchmark-classifier.
+  --unconstrained runs Tesseract without the database's words and whitelist (see OcrVocabulary.h),
+  to compare against the default.
+  Author: Ridas Jagelavicius */
+
+#include <algorithm>
+#include <chrono>
+#include <filesystem>
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "../src/CorpusManifest.h"
+#include "../src/InventoryGenerator.h"
+#include "../src/ItemClassifier.h"
+#include "../src/LatencyProfiler.h"
+#include "../src/TileRenderer.h"
+
+// Prints how to run the benchmark
+void PrintUsage() {
+    std::cout << "Usage: benchmark-ocr <model> <database> [--counts 10,100,1000] "
+                 "[--scales 1,2,4] [--seed <n>] [--write <folder>] [--unconstrained]"
+              << std::endl;
+}
+
+// Splits a comma separated list of numbers
+std::vector<double> ParseList(const std::string& list) {
+    std::vector<double> values;
+    std::stringstream stream(list);
+    std::string value;
+    while (std::getline(stream, value, ',')) values.push_back(std::stod(value));
+    return values;
+}
+
+// Writes rendered tiles and their manifest into a folder
+void WriteCorpus(const std::filesystem::path& folder,
+                 const std::vector<InventoryItem>& items,
+                 const std::vector<cv::Mat>& tiles) {
+    std::filesystem::create_directories(folder);
+
+    std::vector<LabeledImage> labeled_images;
+    for (size_t i = 0; i < tiles.size(); i++) {
+        std::string image = "tile" + std::to_string(i) + ".png";
+        cv::imwrite((folder / image).string(), tiles[i]);
+        labeled_images.push_back({image, items[i].GetName(), items[i].GetColor(),
+                                  items[i].GetCertification()});
+    }
+    WriteManifest((folder / "manifest.csv").string(), labeled_images);
+}
+
+int main(int argc, char** argv) {
+    if (argc < 3) {
+        PrintUsage();
+        return 1;
+    }
+
+    std::string path_to_model = argv[1];
+    std::string path_to_database = argv[2];
+    std::vector<double> counts = {10, 100, 1000};
+    std::vector<double> scales = {1, 2, 4};
+    unsigned seed = 2020;
+    std::filesystem::path output;
+    bool constrained = true;
+
+    for (int i = 3; i < argc; i++) {
+        std::string option = argv[i];
+        if (option == "--counts" && i + 1 < argc) {
+            counts = ParseList(argv[++i]);
+        } else if (option == "--scales" && i + 1 < argc) {
+            scales = ParseList(argv[++i]);
+        } else if (option == "--seed" && i + 1 < argc) {
+            seed = static_cast<unsigned>(std::stoul(argv[++i]));
+        } else if (option == "--write" && i + 1 < argc) {
+            output = argv[++i];
+        } else if (option == "--unconstrained") {
+            constrained = false;
+        } else {
+            PrintUsage();
+            return 1;
+        }
+    }
+    if (counts.empty() || scales.empty()) {
+        PrintUsage();
+        return 1;
+    }
+
+    ItemDatabase database(path_to_database);
+    if (!database.IsValidDatabase()) {
+        std::cout << "Database not found at provided path" << std::endl;
+        return 1;
+    }
+
+    // Every scale renders the same items so only the resolution changes between them
+    InventoryGenerator generator(database, seed);
+    size_t max_count = static_cast<size_t>(*std::max_element(counts.begin(), counts.end()));
+    if (generator.GetCatalogSize() == 0 || max_count == 0) {
+        std::cout << "No items to render; the database is empty or every count is 0" << std::endl;
+        return 1;
+    }
+    std::vector<InventoryItem> items = generator.GenerateItems(max_count);
+
+    ItemClassifier classifier(path_to_model, path_to_database);
+    classifier.SetConstrainedOcr(constrained);
+
+    std::cout << std::left << std::setw(8) << "Scale" << std::setw(12) << "Tile"
+              << std::setw(10) << "Images" << std::setw(12) << "Images/s"
+              << std::setw(14) << "Mean (ms)" << "Names read" << std::endl;
+
+    for (double scale : scales) {
+        // Render up front so drawing is not part of the measurement
+        TileRenderer renderer(seed);
+        std::vector<cv::Mat> tiles;
+        for (const InventoryItem& item : items)
+            tiles.push_back(renderer.RenderTile(item, scale));
+
+        if (!output.empty()) {
+            std::ostringstream folder;
+            folder << scale << "x";
+            WriteCorpus(output / folder.str(), items, tiles);
+        }
+
+        // Warm up so loading the network is not counted
+        classifier.DetectText(tiles.front());
+        classifier.ExtractText();
+        LatencyProfiler::Global().Reset();
+
+        for (double count : counts) {
+            size_t images = static_cast<size_t>(count);
+            if (images == 0) continue;
+            int names_read = 0;
+            std::chrono::duration<double> elapsed(0);
+
+            for (size_t i = 0; i < images; i++) {
+                std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+                classifier.DetectText(tiles[i]);
+                std::vector<std::string> words = classifier.ExtractText();
+                elapsed += std::chrono::steady_clock::now() - start;
+
+                // Matching is not timed, it only checks that the text was read; the paint and
+                // certification words are removed first, as Classify() does
+                classifier.DetectColor(words);
+                classifier.ExtractCertification(words);
+                std::string name = classifier.MatchTextToItemName(words);
+                if (name.empty()) {
+                    float similarity;
+                    name = classifier.MatchClosestItemName(words, similarity);
+                }
+                names_read += name == items[i].GetName();
+            }
+
+            cv::Size size = renderer.GetTileSize(scale);
+            std::cout << std::fixed << std::setprecision(2) << std::left
+                      << std::setw(8) << scale << std::setw(12)
+                      << std::to_string(size.width) + "x" + std::to_string(size.height)
+                      << std::setw(10) << images << std::setw(12)
+                      << images / elapsed.count() << std::setw(14)
+                      << elapsed.count() * 1000 / images
+                      << 100.0 * names_read / images << "%" << std::endl;
+        }
+        std::cout << std::endl << LatencyProfiler::Global().Report() << std::endl;
+    }
+    return 0;
+}
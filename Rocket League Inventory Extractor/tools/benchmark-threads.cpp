@@ -0,0 +1,204 @@
+/* Rocket League Inventory Extractor - Thread Budget Benchmark
+  Finds the best way to split a machine's cores between classifier threads and the threads
+  OpenCV and Tesseract start inside each call, by classifying the same images with every split.
+
+  Usage:
+    benchmark-threads <model> <database> <corpus folder> [--cores <n>] [--repeat <n>]
+                      [--budgets 1x8,2x4,...]
+
+  Every split (see ThreadBudget.h) runs in a fresh copy of this program, since Tesseract's
+  OpenMP only reads OMP_THREAD_LIMIT when a process starts and OpenCV keeps its pool between
+  runs. The images are decoded before timing starts and each classifier is warmed up first, so
+  only classification is measured. Pass the best split to classify-images --budget.
+  Author: Ridas Jagelavicius */
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "../src/ImageListing.h"
+#include "../src/ItemClassifier.h"
+#include "../src/ThreadBudget.h"
+
+#ifdef _WIN32
+#define popen _popen
+#define pclose _pclose
+#endif
+
+constexpr const char* RESULT_PREFIX = "images/s: ";  // Starts the line a run reports its throughput on
+
+// Prints how to run the benchmark
+void PrintUsage() {
+    std::cout << "Usage: benchmark-threads <model> <database> <corpus folder> [--cores <n>] "
+                 "[--repeat <n>] [--budgets 1x8,2x4,...]"
+              << std::endl;
+}
+
+// Quotes an argument so the shell passes it to the program unchanged
+std::string QuoteArgument(const std::string& argument) {
+#ifdef _WIN32
+    return "\"" + argument + "\"";
+#else
+    std::string quoted = "'";
+    for (char c : argument) {
+        if (c == '\'')
+            quoted += "'\\''";
+        else
+            quoted += c;
+    }
+    return quoted + "'";
+#endif
+}
+
+// Classifies every image with one budget and returns the images classified per second
+double RunBudget(const std::string& path_to_model, const std::string& path_to_database,
+                 const std::vector<cv::Mat>& images, const ThreadBudget& budget, int repeat) {
+    ApplyThreadBudget(budget);
+
+    // Warm up every classifier so loading the network and Tesseract is not timed
+    std::vector<std::unique_ptr<ItemClassifier>> classifiers;
+    for (size_t i = 0; i < budget.workers; i++) {
+        classifiers.emplace_back(new ItemClassifier(path_to_model, path_to_database));
+        classifiers.back()->Classify(images[i % images.size()]);
+    }
+
+    size_t jobs = images.size() * repeat;
+    std::atomic<size_t> next_job(0);
+    auto work = [&](ItemClassifier& classifier) {
+        for (size_t job = next_job++; job < jobs; job = next_job++)
+            classifier.Classify(images[job % images.size()]);
+    };
+
+    std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+    std::vector<std::thread> workers;
+    for (size_t i = 1; i < budget.workers; i++) workers.emplace_back(work, std::ref(*classifiers[i]));
+    work(*classifiers[0]);
+    for (std::thread& worker : workers) worker.join();
+    double seconds =
+        std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    return seconds > 0 ? jobs / seconds : 0;
+}
+
+// Runs one budget in a fresh copy of this program and returns the images it classified per second
+double MeasureBudget(const std::string& program, const std::vector<std::string>& arguments,
+                     const ThreadBudget& budget) {
+    // The copy inherits the limit, so Tesseract's OpenMP reads it when the copy starts
+    ApplyThreadBudget(budget);
+
+    std::string command = QuoteArgument(program);
+    for (const std::string& argument : arguments) command += " " + QuoteArgument(argument);
+    command += " --only " + FormatThreadBudget(budget);
+#ifdef _WIN32
+    command = "\"" + command + "\"";  // cmd.exe removes the outer quotes of a quoted command
+#endif
+
+    FILE* output = popen(command.c_str(), "r");
+    if (output == nullptr) return 0;
+
+    double images_per_second = 0;
+    std::string line;
+    char buffer[512];
+    while (std::fgets(buffer, sizeof(buffer), output) != nullptr) {
+        line += buffer;
+        if (line.empty() || line.back() != '\n') continue;
+        if (line.compare(0, std::string(RESULT_PREFIX).size(), RESULT_PREFIX) == 0)
+            images_per_second = std::atof(line.c_str() + std::string(RESULT_PREFIX).size());
+        line.clear();
+    }
+    return pclose(output) == 0 ? images_per_second : 0;
+}
+
+int main(int argc, char** argv) {
+    if (argc < 4) {
+        PrintUsage();
+        return 1;
+    }
+
+    std::string path_to_model = argv[1];
+    std::string path_to_database = argv[2];
+    std::string corpus = argv[3];
+    size_t cores = CountCores();
+    int repeat = 1;
+    std::vector<ThreadBudget> budgets;
+    bool only = false;
+
+    for (int i = 4; i < argc; i++) {
+        std::string option = argv[i];
+        if (option == "--cores" && i + 1 < argc) {
+            cores = std::max<size_t>(1, std::stoul(argv[++i]));
+        } else if (option == "--repeat" && i + 1 < argc) {
+            repeat = std::max(1, std::stoi(argv[++i]));
+        } else if ((option == "--budgets" || option == "--only") && i + 1 < argc) {
+            std::stringstream split(argv[++i]);
+            std::string text;
+            while (std::getline(split, text, ',')) {
+                ThreadBudget budget;
+                if (!ParseThreadBudget(text, budget)) {
+                    PrintUsage();
+                    return 1;
+                }
+                budgets.push_back(budget);
+            }
+            only = option == "--only";
+        } else {
+            PrintUsage();
+            return 1;
+        }
+    }
+
+    // A copy started by MeasureBudget() runs its budget and reports the throughput
+    if (only) {
+        std::vector<cv::Mat> images;
+        for (const std::string& path : ListImages(corpus)) {
+            cv::Mat image = cv::imread(path);
+            if (!image.empty()) images.push_back(image);
+        }
+        if (images.empty() || budgets.size() != 1) return 1;
+        std::cout << RESULT_PREFIX
+                  << RunBudget(path_to_model, path_to_database, images, budgets[0], repeat)
+                  << std::endl;
+        return 0;
+    }
+
+    if (budgets.empty()) budgets = ListThreadBudgets(cores);
+    std::vector<std::string> arguments = {path_to_model, path_to_database, corpus,
+                                          "--repeat", std::to_string(repeat)};
+
+    std::cout << "Splitting " << cores << " cores over " << ListImages(corpus).size()
+              << " images" << std::endl;
+    std::cout << std::left << std::setw(12) << "Budget" << std::setw(12) << "Threads"
+              << "Images/s" << std::endl;
+
+    ThreadBudget best;
+    double best_images_per_second = 0;
+    for (const ThreadBudget& budget : budgets) {
+        double images_per_second = MeasureBudget(argv[0], arguments, budget);
+        std::cout << std::left << std::setw(12) << FormatThreadBudget(budget) << std::setw(12)
+                  << budget.workers * budget.intra_op_threads;
+        if (images_per_second > 0)
+            std::cout << std::fixed << std::setprecision(2) << images_per_second << std::endl;
+        else
+            std::cout << "failed" << std::endl;
+
+        if (images_per_second > best_images_per_second) {
+            best = budget;
+            best_images_per_second = images_per_second;
+        }
+    }
+
+    if (best_images_per_second == 0) {
+        std::cout << "No budget could classify the corpus" << std::endl;
+        return 1;
+    }
+    std::cout << "Best: classify-images --budget " << FormatThreadBudget(best) << std::endl;
+    return 0;
+}
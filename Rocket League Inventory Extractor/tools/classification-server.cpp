@@ -0,0 +1,94 @@
+/* Rocket League Inventory Extractor - Classification Server
+  Serves the classifier to other programs on the same machine over HTTP. Tiles uploaded at about
+  the same time are classified together, so their text is detected in one pass through the network.
+
+  Usage:
+    classification-server <model> <database> [--port <n>] [--max-batch <n>]
+                          [--max-delay-ms <n>] [--connections <n>] [--detector east|db]
+                          [--backend opencv|openvino]
+
+  POST /classify with an image body responds with the item's traits, price and confidences as JSON.
+  POST /inventory also adds the item to the server's inventory, which GET /inventory returns.
+  GET /statistics returns how many requests and batches have been classified.
+  The server stops when a line is entered on standard input (or it is closed).
+  --detector sets the model's architecture when its file name does not tell (see GuessDetectorModel())
+  and --backend where the network runs; benchmark-detectors compares them.
+  Author: Ridas Jagelavicius */
+
+#include <chrono>
+#include <iostream>
+#include <string>
+
+#include "../src/BatchingClassifier.h"
+#include "../src/ClassificationServer.h"
+#include "../src/ItemClassifier.h"
+
+// Prints how to run the server
+void PrintUsage() {
+    std::cerr << "Usage: classification-server <model> <database> [--port <n>] "
+                 "[--max-batch <n>] [--max-delay-ms <n>] [--connections <n>] "
+                 "[--detector east|db] [--backend opencv|openvino]"
+              << std::endl;
+}
+
+int main(int argc, char** argv) {
+    if (argc < 3) {
+        PrintUsage();
+        return 1;
+    }
+
+    std::string path_to_model = argv[1];
+    std::string path_to_database = argv[2];
+    int port = 8080;
+    size_t max_batch = 8;
+    int max_delay_ms = 10;
+    size_t connections = 8;
+    DetectorOptions detector_options;
+    detector_options.model = GuessDetectorModel(path_to_model);
+
+    for (int i = 3; i < argc; i++) {
+        std::string option = argv[i];
+        if (option == "--port" && i + 1 < argc) {
+            port = std::stoi(argv[++i]);
+        } else if (option == "--max-batch" && i + 1 < argc) {
+            max_batch = std::stoul(argv[++i]);
+        } else if (option == "--max-delay-ms" && i + 1 < argc) {
+            max_delay_ms = std::stoi(argv[++i]);
+        } else if (option == "--connections" && i + 1 < argc) {
+            connections = std::stoul(argv[++i]);
+        } else if (option == "--detector" && i + 1 < argc) {
+            if (!ParseDetectorModel(argv[++i], detector_options.model)) {
+                PrintUsage();
+                return 1;
+            }
+        } else if (option == "--backend" && i + 1 < argc) {
+            if (!ParseDetectorBackend(argv[++i], detector_options.backend)) {
+                PrintUsage();
+                return 1;
+            }
+        } else {
+            PrintUsage();
+            return 1;
+        }
+    }
+
+    ItemClassifier classifier(path_to_model, path_to_database);
+    classifier.SetDetectorOptions(detector_options);
+    BatchingClassifier batching(classifier, max_batch, std::chrono::milliseconds(max_delay_ms));
+    ClassificationServer server(batching, path_to_database, connections);
+    if (!server.Start(port)) return 1;
+
+    std::cerr << "Listening on http://127.0.0.1:" << server.GetPort()
+              << " (batches of up to " << max_batch << ", waiting at most " << max_delay_ms
+              << " ms)" << std::endl;
+
+    std::string line;
+    std::getline(std::cin, line);
+    server.Stop();
+
+    BatchingStatistics statistics = batching.GetStatistics();
+    std::cerr << "Classified " << statistics.requests << " images in " << statistics.batches
+              << " batches (largest " << statistics.largest_batch << ", failed "
+              << statistics.failed_requests << ")" << std::endl;
+    return 0;
+}
@@ -0,0 +1,128 @@
+/* Rocket League Inventory Extractor - Classifier Daemon
+  Keeps a classifier loaded and classifies image paths read from standard input, one per
+  line, until standard input is closed. Each result is written to standard output as a tab
+  separated line: path, name, paint, certification and name confidence (or "error" when the
+  image could not be read). Memory stays bounded however long it runs: no image is kept
+  between jobs and the engines are recycled when a limit is crossed.
+
+  Usage:
+    classifier-daemon <model> <database> [--max-rss-mb <n>] [--recycle-after <jobs>]
+                      [--queue <jobs>] [--report-every <jobs>] [--detector east|db]
+                      [--backend opencv|openvino]
+
+  --report-every writes the job counts, engine recycles, resident memory and the latency and
+  memory of every pipeline stage to standard error after that many jobs (default 1000).
+  --detector sets the model's architecture when its file name does not tell (see GuessDetectorModel())
+  and --backend where the network runs; benchmark-detectors compares them.
+  Author: Ridas Jagelavicius */
+
+#include <iostream>
+#include <mutex>
+#include <string>
+
+#include "../src/ClassifierDaemon.h"
+#include "../src/ItemClassifier.h"
+#include "../src/LatencyProfiler.h"
+
+constexpr double BYTES_PER_MEGABYTE = 1024.0 * 1024.0;
+
+// Prints how to run the daemon
+void PrintUsage() {
+    std::cerr << "Usage: classifier-daemon <model> <database> [--max-rss-mb <n>] "
+                 "[--recycle-after <jobs>] [--queue <jobs>] [--report-every <jobs>] "
+                 "[--detector east|db] [--backend opencv|openvino]"
+              << std::endl;
+}
+
+// Writes the daemon's statistics and the profiler's report to standard error
+void Report(const ClassifierDaemon& daemon) {
+    DaemonStatistics statistics = daemon.GetStatistics();
+    std::cerr << "Completed " << statistics.completed_jobs << ", failed "
+              << statistics.failed_jobs << ", pending " << statistics.pending_jobs
+              << ", recycles " << statistics.engine_recycles << ", resident "
+              << statistics.resident_bytes / BYTES_PER_MEGABYTE << " MB (peak "
+              << statistics.peak_resident_bytes / BYTES_PER_MEGABYTE << " MB)"
+              << std::endl
+              << LatencyProfiler::Global().Report() << std::endl;
+}
+
+int main(int argc, char** argv) {
+    if (argc < 3) {
+        PrintUsage();
+        return 1;
+    }
+
+    std::string path_to_model = argv[1];
+    std::string path_to_database = argv[2];
+    DaemonLimits limits;
+    uint64_t report_every = 1000;
+    DetectorOptions detector_options;
+    detector_options.model = GuessDetectorModel(path_to_model);
+
+    for (int i = 3; i < argc; i++) {
+        std::string option = argv[i];
+        if (option == "--max-rss-mb" && i + 1 < argc) {
+            limits.max_resident_bytes =
+                static_cast<size_t>(std::stod(argv[++i]) * BYTES_PER_MEGABYTE);
+        } else if (option == "--recycle-after" && i + 1 < argc) {
+            limits.max_jobs_per_engine = std::stoull(argv[++i]);
+        } else if (option == "--queue" && i + 1 < argc) {
+            limits.max_pending_jobs = std::stoul(argv[++i]);
+        } else if (option == "--report-every" && i + 1 < argc) {
+            report_every = std::stoull(argv[++i]);
+        } else if (option == "--detector" && i + 1 < argc) {
+            if (!ParseDetectorModel(argv[++i], detector_options.model)) {
+                PrintUsage();
+                return 1;
+            }
+        } else if (option == "--backend" && i + 1 < argc) {
+            if (!ParseDetectorBackend(argv[++i], detector_options.backend)) {
+                PrintUsage();
+                return 1;
+            }
+        } else {
+            PrintUsage();
+            return 1;
+        }
+    }
+
+    ItemClassifier classifier(path_to_model, path_to_database);
+    classifier.SetDetectorOptions(detector_options);
+    LatencyProfiler::Global().SetMemoryTracking(true);
+
+    // Results are written from the daemon's thread while this thread reads more paths
+    std::mutex output_mutex;
+    uint64_t handled = 0;
+    ClassifierDaemon* reporter = nullptr;
+    ClassifierDaemon daemon(
+        classifier, limits,
+        [&](const DaemonJob& job, const ClassificationResult& result, bool succeeded) {
+            std::lock_guard<std::mutex> lock(output_mutex);
+            if (succeeded)
+                std::cout << job.id << '\t' << result.name << '\t' << result.paint << '\t'
+                          << result.certification << '\t' << result.name_confidence
+                          << '\n';
+            else
+                std::cout << job.id << "\terror\n";
+            std::cout.flush();
+
+            if (report_every != 0 && ++handled % report_every == 0 && reporter != nullptr)
+                Report(*reporter);
+        });
+    reporter = &daemon;
+
+    std::string path_to_image;
+    while (std::getline(std::cin, path_to_image)) {
+        if (!path_to_image.empty() && path_to_image.back() == '\r') path_to_image.pop_back();
+        if (path_to_image.empty()) continue;
+
+        DaemonJob job;
+        job.id = path_to_image;
+        job.path_to_image = path_to_image;
+        daemon.Submit(std::move(job));
+    }
+
+    daemon.Flush();
+    Report(daemon);
+    return 0;
+}
@@ -0,0 +1,293 @@
+/* Rocket League Inventory Extractor - Batch Classifier
+  Classifies every image named on the command line and writes one result per image to
+  standard output, as JSON Lines or CSV, for other programs to read.
+
+  Usage:
+    classify-images <model> <database> <folder | pattern | image>... [--threads <n>]
+                    [--batch <n>] [--format jsonl|csv] [--checkpoint <log>]
+                    [--shard <index>/<count>] [--inventory <path>]
+                    [--budget <workers>x<threads>] [--detector east|db] [--backend opencv|openvino]
+
+  A folder classifies every image directly inside it; a pattern such as shots/Octane*.png may use
+  * and ? in its file name. Results are written in the order the images were listed, whatever
+  the number of threads. Each thread loads its own classifier, and --batch passes that many
+  images through the network together. Progress and messages go to standard error only.
+  The cores are split so each thread's OpenCV and Tesseract calls use cores / threads threads of
+  their own; --budget 8x2 sets both numbers at once (benchmark-threads finds the best split).
+  --checkpoint appends each result to a log as soon as it is ready. Running the same command
+  again after a crash writes the logged results without classifying those images again.
+  --shard 2/8 only classifies the third of 8 equal shares of the images, so a job can be split
+  across processes or machines that each run the same command with a different index.
+  --inventory saves the items found as an inventory; merge-inventories combines the shards' ones.
+  --detector sets the model's architecture when its file name does not tell (see GuessDetectorModel())
+  and --backend where the network runs; benchmark-detectors compares them.
+  Exits with 0 if every image was classified, 2 if some could not be read and 1 on bad usage.
+  Author: Ridas Jagelavicius */
+
+#include <algorithm>
+#include <atomic>
+#include <cctype>
+#include <chrono>
+#include <exception>
+#include <iostream>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "../src/CheckpointLog.h"
+#include "../src/ImageListing.h"
+#include "../src/Inventory.h"
+#include "../src/ItemClassifier.h"
+#include "../src/ItemDatabase.h"
+#include "../src/ResultFormat.h"
+#include "../src/ThreadBudget.h"
+
+// Prints how to run the tool
+void PrintUsage() {
+    std::cerr << "Usage: classify-images <model> <database> <folder | pattern | image>... "
+                 "[--threads <n>] [--batch <n>] [--format jsonl|csv] [--checkpoint <log>] "
+                 "[--shard <index>/<count>] [--inventory <path>] [--budget <workers>x<threads>] "
+                 "[--detector east|db] [--backend opencv|openvino]"
+              << std::endl;
+}
+
+// Reads a count such as a number of threads, which must be whole digits and at least 1
+bool ParseCount(const std::string& text, size_t& count) {
+    if (text.empty()) return false;
+    for (char digit : text)
+        if (!std::isdigit(static_cast<unsigned char>(digit))) return false;
+
+    size_t parsed;
+    try {
+        parsed = std::stoul(text);
+    } catch (const std::exception&) {
+        return false;  // Too large to be a count
+    }
+    if (parsed == 0) return false;
+    count = parsed;
+    return true;
+}
+
+int main(int argc, char** argv) {
+    if (argc < 4) {
+        PrintUsage();
+        return 1;
+    }
+
+    std::string path_to_model = argv[1];
+    std::string path_to_database = argv[2];
+    std::vector<std::string> paths;
+    size_t threads = CountCores();
+    size_t intra_op_threads = 0;  // Split the cores between the threads unless a budget is given
+    size_t batch = 1;
+    OutputFormat format = OutputFormat::JsonLines;
+    std::string path_to_checkpoint;
+    size_t shard = 0, shard_count = 1;
+    std::string path_to_inventory;
+    DetectorOptions detector_options;
+    detector_options.model = GuessDetectorModel(path_to_model);
+
+    for (int i = 3; i < argc; i++) {
+        std::string option = argv[i];
+        if (option == "--threads" && i + 1 < argc) {
+            if (!ParseCount(argv[++i], threads)) {
+                PrintUsage();
+                return 1;
+            }
+        } else if (option == "--budget" && i + 1 < argc) {
+            ThreadBudget budget;
+            if (!ParseThreadBudget(argv[++i], budget)) {
+                PrintUsage();
+                return 1;
+            }
+            threads = budget.workers;
+            intra_op_threads = budget.intra_op_threads;
+        } else if (option == "--batch" && i + 1 < argc) {
+            if (!ParseCount(argv[++i], batch)) {
+                PrintUsage();
+                return 1;
+            }
+        } else if (option == "--format" && i + 1 < argc) {
+            if (!ParseOutputFormat(argv[++i], format)) {
+                PrintUsage();
+                return 1;
+            }
+        } else if (option == "--checkpoint" && i + 1 < argc) {
+            path_to_checkpoint = argv[++i];
+        } else if (option == "--shard" && i + 1 < argc) {
+            if (!ParseShard(argv[++i], shard, shard_count)) {
+                PrintUsage();
+                return 1;
+            }
+        } else if (option == "--inventory" && i + 1 < argc) {
+            path_to_inventory = argv[++i];
+        } else if (option == "--detector" && i + 1 < argc) {
+            if (!ParseDetectorModel(argv[++i], detector_options.model)) {
+                PrintUsage();
+                return 1;
+            }
+        } else if (option == "--backend" && i + 1 < argc) {
+            if (!ParseDetectorBackend(argv[++i], detector_options.backend)) {
+                PrintUsage();
+                return 1;
+            }
+        } else if (option.compare(0, 2, "--") == 0) {
+            PrintUsage();
+            return 1;
+        } else {
+            std::vector<std::string> listed = ListImages(option);
+            paths.insert(paths.end(), listed.begin(), listed.end());
+        }
+    }
+
+    // Every shard lists the same images in the same order, then keeps its own share of them
+    if (shard_count > 1) paths = SelectShard(paths, shard, shard_count);
+
+    if (paths.empty()) {
+        std::cerr << "No images found" << std::endl;
+        return 1;
+    }
+
+    // Results keep standard output to themselves; the classifier's own messages go to standard error
+    std::ostream output(std::cout.rdbuf());
+    std::streambuf* standard_output = std::cout.rdbuf(std::cerr.rdbuf());
+
+    // Images finished by an earlier run are answered from the checkpoint log
+    std::unique_ptr<CheckpointLog> checkpoint;
+    if (!path_to_checkpoint.empty()) {
+        checkpoint.reset(new CheckpointLog(path_to_checkpoint));
+        if (!checkpoint->IsOpen()) {
+            std::cout.rdbuf(standard_output);
+            return 1;
+        }
+    }
+    std::vector<ClassifiedImage> resumed(paths.size());
+    std::vector<size_t> todo;
+    for (size_t i = 0; i < paths.size(); i++)
+        if (!checkpoint || !checkpoint->Lookup(paths[i], resumed[i]))
+            todo.push_back(i);
+    threads = std::max<size_t>(1, std::min(threads, (todo.size() + batch - 1) / batch));
+
+    // Threads inside OpenCV and Tesseract come out of the same cores as the classifier threads
+    ThreadBudget budget = SplitThreadBudget(threads, CountCores());
+    if (intra_op_threads > 0) budget.intra_op_threads = intra_op_threads;
+    if (!ApplyThreadBudget(budget) && threads > 1)
+        std::cerr << "Set OMP_THREAD_LIMIT=" << budget.intra_op_threads
+                  << " before starting to also limit Tesseract's OpenMP threads" << std::endl;
+
+    // ItemClassifier is not thread safe, so every thread gets its own
+    ItemDatabase database(path_to_database);
+    std::vector<std::unique_ptr<ItemClassifier>> classifiers;
+    for (size_t i = 0; i < threads; i++) {
+        classifiers.emplace_back(new ItemClassifier(path_to_model, path_to_database));
+        classifiers.back()->SetDetectorOptions(detector_options);
+    }
+
+    // Results are written as soon as every image listed before them is done, and added to the
+    // inventory in the same order so every run of a shard saves the same inventory
+    std::mutex output_mutex;
+    std::vector<std::string> lines(paths.size());
+    std::vector<std::unique_ptr<InventoryItem>> found(paths.size());
+    Inventory inventory(path_to_database);
+    std::vector<char> ready(paths.size(), false);
+    size_t next_to_write = 0;
+    size_t failed = 0;
+    output << FormatResultHeader(format);
+
+    auto publish = [&](const ClassifiedImage& image, size_t index) {
+        std::string line = FormatResult(image, format);
+        if (checkpoint && !resumed[index].succeeded) checkpoint->Append(image);
+
+        std::lock_guard<std::mutex> lock(output_mutex);
+        if (!image.succeeded) failed++;
+        lines[index] = std::move(line);
+        if (!path_to_inventory.empty() && image.succeeded && !image.result.name.empty())
+            found[index].reset(new InventoryItem(image.result.name, image.result.certification,
+                                                 image.result.paint, image.price));
+        ready[index] = true;
+        while (next_to_write < paths.size() && ready[next_to_write]) {
+            output << lines[next_to_write];
+            std::string().swap(lines[next_to_write]);
+            if (found[next_to_write]) {
+                inventory.AddItem(*found[next_to_write]);
+                found[next_to_write].reset();
+            }
+            next_to_write++;
+        }
+        output.flush();
+    };
+
+    std::atomic<size_t> next_job(0);
+    auto work = [&](ItemClassifier& classifier) {
+        while (true) {
+            size_t first = next_job.fetch_add(batch);
+            if (first >= todo.size()) break;
+            size_t last = std::min(first + batch, todo.size());
+
+            std::vector<cv::Mat> images;
+            std::vector<size_t> indices;
+            for (size_t job = first; job < last; job++) {
+                size_t i = todo[job];
+                cv::Mat image = cv::imread(paths[i]);
+                if (image.empty()) {
+                    ClassifiedImage unreadable;
+                    unreadable.path = paths[i];
+                    publish(unreadable, i);
+                    continue;
+                }
+                images.push_back(image);
+                indices.push_back(i);
+            }
+            if (images.empty()) continue;
+
+            std::vector<ClassificationResult> results;
+            try {
+                results = classifier.ClassifyBatch(images);
+            } catch (const std::exception&) {
+                results.clear();  // ex. the model could not be loaded; the images are reported as failed
+            }
+
+            for (size_t j = 0; j < indices.size(); j++) {
+                ClassifiedImage classified;
+                classified.path = paths[indices[j]];
+                if (j < results.size()) {
+                    classified.succeeded = true;
+                    classified.result = results[j];
+                    if (!classified.result.name.empty()) {
+                        classified.price = database.GetPriceOf(classified.result.name,
+                                                               classified.result.paint);
+                        if (classified.price == "-1" || classified.price == "-2")
+                            classified.price.clear();
+                    }
+                }
+                publish(classified, indices[j]);
+            }
+            classifier.ReleaseLastImage();
+        }
+    };
+
+    std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+    for (size_t i = 0; i < paths.size(); i++)
+        if (resumed[i].succeeded) publish(resumed[i], i);
+    std::vector<std::thread> workers;
+    for (size_t i = 1; i < threads; i++) workers.emplace_back(work, std::ref(*classifiers[i]));
+    work(*classifiers[0]);
+    for (std::thread& worker : workers) worker.join();
+    double seconds =
+        std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    std::cout.rdbuf(standard_output);
+    if (!path_to_inventory.empty() && !inventory.WriteInvToFile(path_to_inventory)) {
+        std::cerr << "Could not save the inventory to " << path_to_inventory << std::endl;
+        return 1;
+    }
+    std::cerr << "Classified " << todo.size() - failed << " of " << todo.size()
+              << " images in " << seconds << " s with " << FormatThreadBudget(budget) << " threads";
+    if (shard_count > 1) std::cerr << " (shard " << shard << " of " << shard_count << ")";
+    if (checkpoint)
+        std::cerr << " (" << paths.size() - todo.size() << " more from the checkpoint)";
+    std::cerr << std::endl;
+    return failed == 0 ? 0 : 2;
+}
@@ -0,0 +1,63 @@
+/* Rocket League Inventory Extractor - Inventory Merger
+  Combines the partial inventories saved by each shard of a classify-images job into one.
+
+  Usage:
+    merge-inventories <database> <output> <partial inventory>...
+
+  A job is split by running the same classify-images command once per shard, in as many
+  processes or on as many machines as there are shards, each with its own index:
+    classify-images <model> <database> shots --shard 0/4 --inventory part0.txt
+    ...
+    classify-images <model> <database> shots --shard 3/4 --inventory part3.txt
+    merge-inventories <database> inventory.txt part0.txt part1.txt part2.txt part3.txt
+  Quantities of the same item are summed, so the result is the inventory a single process
+  classifying every image would have saved. Merging takes time linear in the number of items.
+  Author: Ridas Jagelavicius */
+
+#include <chrono>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include "../src/Inventory.h"
+
+// Prints how to run the merger
+void PrintUsage() {
+    std::cout << "Usage: merge-inventories <database> <output> <partial inventory>..."
+              << std::endl;
+}
+
+int main(int argc, char** argv) {
+    if (argc < 4) {
+        PrintUsage();
+        return 1;
+    }
+
+    std::string path_to_database = argv[1];
+    std::string path_to_output = argv[2];
+
+    std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+    Inventory merged(path_to_database);
+    for (int i = 3; i < argc; i++) {
+        Inventory partial(path_to_database);
+        if (!partial.ReadInvFromFile(argv[i])) {
+            std::cout << "Could not read the inventory at " << argv[i] << std::endl;
+            return 1;
+        }
+        merged.Merge(partial);
+        std::cout << "Merged " << argv[i] << " (" << partial.GetItems().size() << " items)"
+                  << std::endl;
+    }
+
+    if (!merged.WriteInvToFile(path_to_output)) {
+        std::cout << "Could not save the inventory to " << path_to_output << std::endl;
+        return 1;
+    }
+    double seconds =
+        std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    std::cout << "Saved " << merged.GetItems().size() << " items worth at least "
+              << merged.GetInventoryWorth() << "k to " << path_to_output << " in " << seconds
+              << " s" << std::endl;
+    return 0;
+}
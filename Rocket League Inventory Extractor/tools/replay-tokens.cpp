@@ -0,0 +1,129 @@
+/* Rocket League Inventory Extractor - Token Replay
+  Runs name, paint and certification matching over the words recorded by
+  benchmark-classifier --record, without any image, EAST or Tesseract, so changes to matching
+  can be measured over many thousands of tiles in seconds.
+
+  Usage:
+    replay-tokens <database> <recording> [--manifest <path>] [--min-confidence <c>] [--repeat <n>]
+
+  With a manifest (see CorpusManifest.h), each record is checked against the labels of the image
+  it was recorded from and the accuracy is reported alongside the throughput.
+  Author: Ridas Jagelavicius */
+
+#include <algorithm>
+#include <chrono>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "../src/CorpusManifest.h"
+#include "../src/ItemClassifier.h"
+#include "../src/LatencyProfiler.h"
+#include "../src/TokenRecording.h"
+
+// Prints how to run the replay
+void PrintUsage() {
+    std::cout << "Usage: replay-tokens <database> <recording> [--manifest <path>] "
+                 "[--min-confidence <c>] [--repeat <n>]"
+              << std::endl;
+}
+
+// Returns a percentage of a count, or 0 if there is nothing to count
+double Percent(int count, int total) {
+    return total == 0 ? 0 : 100.0 * count / total;
+}
+
+int main(int argc, char** argv) {
+    if (argc < 3) {
+        PrintUsage();
+        return 1;
+    }
+
+    std::string path_to_database = argv[1];
+    std::string path_to_recording = argv[2];
+    std::string path_to_manifest;
+    float minimum_confidence = -1;
+    int repeat = 1;
+
+    for (int i = 3; i < argc; i++) {
+        std::string option = argv[i];
+        if (option == "--manifest" && i + 1 < argc) {
+            path_to_manifest = argv[++i];
+        } else if (option == "--min-confidence" && i + 1 < argc) {
+            minimum_confidence = std::stof(argv[++i]);
+        } else if (option == "--repeat" && i + 1 < argc) {
+            repeat = std::max(1, std::stoi(argv[++i]));
+        } else {
+            PrintUsage();
+            return 1;
+        }
+    }
+
+    // Every record is read up front so only matching is timed
+    std::vector<TokenRecord> records;
+    {
+        TokenRecordReader reader(path_to_recording);
+        if (!reader.IsOpen()) {
+            std::cout << path_to_recording << " is not a token recording" << std::endl;
+            return 1;
+        }
+        TokenRecord record;
+        while (reader.Next(record)) records.push_back(record);
+    }
+    std::cout << "Read " << records.size() << " records" << std::endl;
+
+    std::unordered_map<std::string, LabeledImage> labels;
+    for (const LabeledImage& labeled : ReadManifest(path_to_manifest))
+        labels[labeled.image] = labeled;
+
+    // No model is needed, since nothing is detected
+    ItemClassifier classifier("", path_to_database);
+    if (minimum_confidence >= 0) classifier.SetMinimumConfidence(minimum_confidence);
+    LatencyProfiler::Global().Reset();
+
+    int labeled_count = 0;
+    int names_correct = 0;
+    int paints_correct = 0;
+    int certifications_correct = 0;
+
+    std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+    for (int round = 0; round < repeat; round++) {
+        for (const TokenRecord& record : records) {
+            ClassificationResult result = classifier.ClassifyRecording(record);
+
+            std::unordered_map<std::string, LabeledImage>::const_iterator expected =
+                labels.find(record.image_id);
+            if (round != 0 || expected == labels.end()) continue;
+
+            labeled_count++;
+            names_correct += result.name == expected->second.name;
+            paints_correct += result.paint == expected->second.paint;
+            certifications_correct += result.certification == expected->second.certification;
+            if (result.name != expected->second.name || result.paint != expected->second.paint ||
+                result.certification != expected->second.certification) {
+                std::cout << "MISMATCH " << record.image_id << ": expected ["
+                          << expected->second.paint << "] [" << expected->second.certification
+                          << "] " << expected->second.name << ", got [" << result.paint << "] ["
+                          << result.certification << "] " << result.name << std::endl;
+            }
+        }
+    }
+    std::chrono::duration<double> total = std::chrono::steady_clock::now() - start;
+    size_t replayed = records.size() * repeat;
+
+    std::cout << std::fixed << std::setprecision(2) << std::endl
+              << "Records replayed:    " << replayed << std::endl
+              << "Total time (s):      " << total.count() << std::endl
+              << "Records per second:  " << (total.count() > 0 ? replayed / total.count() : 0)
+              << std::endl;
+    if (labeled_count > 0) {
+        std::cout << std::endl
+                  << "Name accuracy:          " << Percent(names_correct, labeled_count) << "%" << std::endl
+                  << "Paint accuracy:         " << Percent(paints_correct, labeled_count) << "%" << std::endl
+                  << "Certification accuracy: " << Percent(certifications_correct, labeled_count) << "%" << std::endl;
+    }
+    std::cout << std::endl << LatencyProfiler::Global().Report();
+    return 0;
+}